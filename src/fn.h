@@ -77,6 +77,7 @@
 #define FN_DEFAULT_PIXELSIZE           2
 #define FN_DEFAULT_FULLSCREEN          0
 #define FN_DEFAULT_DRAWCOLLISIONBOUNDS 0
+#define FN_DEFAULT_INDEXED             0
 
 /* --------------------------------------------------------------- */
 
@@ -100,6 +101,9 @@
 
 #define FNK_LEFT_ENABLED         (0x01 << 0)
 #define FNK_RIGHT_ENABLED        (0x01 << 1)
+#define FNK_FIRE_ENABLED         (0x01 << 2)
+#define FNK_JUMP_ENABLED         (0x01 << 3)
+#define FNK_INTERACT_ENABLED     (0x01 << 4)
 
 /* --------------------------------------------------------------- */
 
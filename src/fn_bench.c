@@ -0,0 +1,619 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Non-interactive benchmarks
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include "config.h"
+
+#include <SDL.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn.h"
+#include "fn_environment.h"
+#include "fn_tile.h"
+#include "fn_picture.h"
+#include "fn_level.h"
+#include "fn_hero.h"
+#include "fngeometry.h"
+#include "fnscreen.h"
+#include "fntexture.h"
+#include "fn_drawlist.h"
+
+/* --------------------------------------------------------------- */
+
+#define FN_BENCH_FORMAT_JSON 0
+#define FN_BENCH_FORMAT_CSV  1
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The state shared by all benchmarks.
+ */
+typedef struct fn_bench_context_t {
+  fn_environment_t * env;
+  fn_hero_t * hero;
+  fn_level_t * lv;
+  Uint8 levelnumber;
+  Uint8 scale;
+  Uint8 threads;
+  FnTexture * level;
+  FnGeometry * srcrect;
+  FnGeometry * dstrect;
+  Uint32 step;
+  Uint32 sink;
+} fn_bench_context_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A single benchmark.
+ */
+typedef struct fn_bench_t {
+  /**
+   * The name printed in the results.
+   */
+  char * name;
+
+  /**
+   * The number of calls to run which are timed together as one
+   * sample, so that fast operations are not below the resolution
+   * of the clock.
+   */
+  Uint32 batch;
+
+  /**
+   * Prepare the benchmark, may be NULL.
+   *
+   * @return 1 on success, 0 if the benchmark can not run.
+   */
+  Uint8 (* setup)(fn_bench_context_t * ctx);
+
+  /**
+   * Run the measured operation once.
+   */
+  void (* run)(fn_bench_context_t * ctx);
+} fn_bench_t;
+
+/* --------------------------------------------------------------- */
+
+static double fn_bench_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_bench_open(fn_bench_context_t * ctx, char * filename)
+{
+  char path[1024];
+  snprintf(path, 1024, "%s/%s",
+      fn_environment_get_datapath(ctx->env), filename);
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    fprintf(stderr, "Could not open file %s\n", path);
+  }
+  return fd;
+}
+
+/* --------------------------------------------------------------- */
+
+static fn_level_t * fn_bench_load_level(fn_bench_context_t * ctx)
+{
+  char filename[20];
+  fn_level_t * lv = NULL;
+  snprintf(filename, 20, "WORLDAL%X.DN%d", ctx->levelnumber,
+      fn_environment_get_episode(ctx->env));
+  int fd = fn_bench_open(ctx, filename);
+  if (fd == -1) {
+    return NULL;
+  }
+  fn_hero_reset(ctx->hero);
+  lv = fn_level_load_with_hero(fd, ctx->env, ctx->hero);
+  close(fd);
+  if (lv != NULL) {
+    fn_level_set_seed(lv, 1);
+  }
+  return lv;
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_bench_setup_level(fn_bench_context_t * ctx)
+{
+  if (ctx->lv != NULL) {
+    fn_level_free(ctx->lv);
+  }
+  ctx->lv = fn_bench_load_level(ctx);
+  ctx->step = 0;
+  return (ctx->lv != NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Move the camera along a fixed path that sweeps through the
+ * whole level.
+ */
+static void fn_bench_move_camera(fn_bench_context_t * ctx)
+{
+  Uint32 maxx = FN_TILE_WIDTH * (FN_LEVEL_WIDTH - FN_LEVELWINDOW_WIDTH);
+  Uint32 maxy = FN_TILE_HEIGHT * (FN_LEVEL_HEIGHT - FN_LEVELWINDOW_HEIGHT);
+
+  fn_geometry_set_x(ctx->srcrect,
+      (ctx->step * FN_HALFTILE_WIDTH * 3) % maxx);
+  fn_geometry_set_y(ctx->srcrect,
+      (ctx->step * FN_HALFTILE_HEIGHT) % maxy);
+  ctx->step++;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_tile_decode(fn_bench_context_t * ctx)
+{
+  fn_tileheader_t header;
+  Uint8 i = 0;
+  char filename[20];
+  snprintf(filename, 20, "SOLID0.DN%d",
+      fn_environment_get_episode(ctx->env));
+  int fd = fn_bench_open(ctx, filename);
+  if (fd == -1) {
+    return;
+  }
+  fn_tile_loadheader(fd, &header);
+  for (i = 0; i < 48; i++) {
+    FnTexture * tile = fn_tile_load(fd,
+        fn_environment_get_graphic_options(ctx->env),
+        &header,
+        FALSE);
+    if (tile != NULL) {
+      g_object_unref(tile);
+    }
+  }
+  close(fd);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_picture_decode(fn_bench_context_t * ctx)
+{
+  char filename[20];
+  snprintf(filename, 20, "DN.DN%d",
+      fn_environment_get_episode(ctx->env));
+  int fd = fn_bench_open(ctx, filename);
+  if (fd == -1) {
+    return;
+  }
+  FnTexture * picture = fn_picture_load(fd, ctx->env);
+  g_object_unref(picture);
+  close(fd);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_level_parse(fn_bench_context_t * ctx)
+{
+  fn_level_t * lv = fn_bench_load_level(ctx);
+  if (lv != NULL) {
+    fn_level_free(lv);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_level_fixed(fn_bench_context_t * ctx)
+{
+  fn_level_blit_fixed(ctx->lv);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_level_blit(fn_bench_context_t * ctx)
+{
+  fn_bench_move_camera(ctx);
+  fn_level_blit_to_texture(ctx->lv,
+      ctx->level,
+      ctx->srcrect,
+      ctx->srcrect,
+      NULL,
+      NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_bench_setup_level_blit(fn_bench_context_t * ctx)
+{
+  fn_drawlist_set_threads(1);
+  return fn_bench_setup_level(ctx);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_bench_setup_level_blit_banded(fn_bench_context_t * ctx)
+{
+  fn_drawlist_set_threads(ctx->threads);
+  if (fn_drawlist_get_threads() < 2) {
+    return 0;
+  }
+  return fn_bench_setup_level(ctx);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_level_act(fn_bench_context_t * ctx)
+{
+  SDL_Rect view;
+
+  if (!fn_level_keep_on_playing(ctx->lv)) {
+    fn_bench_setup_level(ctx);
+  }
+  view.w = FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH;
+  view.h = FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT;
+  fn_level_center_view(ctx->lv, &view);
+  fn_level_update_visibility(ctx->lv, &view);
+  fn_level_act(ctx->lv);
+  fn_hero_take_events(ctx->hero);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_solid_collides(fn_bench_context_t * ctx)
+{
+  SDL_Rect r;
+
+  /* a hero sized rectangle walking through the level */
+  r.w = FN_TILE_WIDTH;
+  r.h = FN_TILE_HEIGHT * 2;
+  r.x = (ctx->step * 7) % (FN_TILE_WIDTH * (FN_LEVEL_WIDTH - 1));
+  r.y = (ctx->step * 5) % (FN_TILE_HEIGHT * (FN_LEVEL_HEIGHT - 2));
+  ctx->sink += fn_level_solid_collides(ctx->lv, &r);
+  ctx->step++;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_screen_blit(fn_bench_context_t * ctx)
+{
+  FnScreen * screen = fn_environment_get_screen(ctx->env);
+  fn_bench_move_camera(ctx);
+  fn_screen_clone_texture(screen, ctx->dstrect, ctx->level, ctx->srcrect);
+  fn_screen_update(screen);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_bench_setup_tile_blit_keyed(fn_bench_context_t * ctx)
+{
+  fn_texture_set_fast_blits(FALSE);
+  return fn_bench_setup_level(ctx);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_bench_setup_tile_blit(fn_bench_context_t * ctx)
+{
+  fn_texture_set_fast_blits(TRUE);
+  return fn_bench_setup_level(ctx);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit every tile inside the level window, like drawing the
+ * background of a frame does. Run with and without the blits of
+ * classified tiles to see what the colour key costs.
+ */
+static void fn_bench_tile_blit(fn_bench_context_t * ctx)
+{
+  FnRect r;
+  size_t x = 0;
+  size_t y = 0;
+
+  fn_bench_move_camera(ctx);
+  size_t left = fn_geometry_get_x(ctx->srcrect) / FN_TILE_WIDTH;
+  size_t top = fn_geometry_get_y(ctx->srcrect) / FN_TILE_HEIGHT;
+
+  r.width = FN_TILE_WIDTH;
+  r.height = FN_TILE_HEIGHT;
+  for (y = top; y < top + FN_LEVELWINDOW_HEIGHT; y++) {
+    for (x = left; x < left + FN_LEVELWINDOW_WIDTH; x++) {
+      Uint16 tilenr = fn_level_get_tile(ctx->lv, x, y);
+      if (tilenr > 1 && tilenr < (48 * 8)) {
+        r.x = x * FN_TILE_WIDTH;
+        r.y = y * FN_TILE_HEIGHT;
+        fn_texture_clone_rect(
+            fn_environment_get_tile(ctx->env, tilenr), NULL,
+            ctx->level, &r);
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static fn_bench_t fn_bench_all[] = {
+  { "tile_decode",     1,    NULL,                 fn_bench_tile_decode },
+  { "picture_decode",  1,    NULL,                 fn_bench_picture_decode },
+  { "level_parse",     1,    NULL,                 fn_bench_level_parse },
+  { "level_fixed",     1,    fn_bench_setup_level, fn_bench_level_fixed },
+  { "level_blit",      1,    fn_bench_setup_level_blit,
+    fn_bench_level_blit },
+  { "level_blit_banded", 1,  fn_bench_setup_level_blit_banded,
+    fn_bench_level_blit },
+  { "level_act",       10,   fn_bench_setup_level, fn_bench_level_act },
+  { "solid_collides",  1000, fn_bench_setup_level, fn_bench_solid_collides },
+  { "screen_blit",     1,    NULL,                 fn_bench_screen_blit },
+  { "tile_blit_keyed", 1,    fn_bench_setup_tile_blit_keyed,
+    fn_bench_tile_blit },
+  { "tile_blit",       1,    fn_bench_setup_tile_blit,
+    fn_bench_tile_blit },
+  { NULL,              0,    NULL,                 NULL }
+};
+
+/* --------------------------------------------------------------- */
+
+static int fn_bench_compare(const void * a, const void * b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* --------------------------------------------------------------- */
+
+static double fn_bench_percentile(double * sorted,
+    Uint32 count,
+    Uint32 percent)
+{
+  /* nearest rank */
+  Uint32 rank = (percent * count + 99) / 100;
+  if (rank == 0) {
+    rank = 1;
+  }
+  return sorted[rank - 1];
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_run(fn_bench_context_t * ctx,
+    fn_bench_t * bench,
+    Uint32 warmup,
+    Uint32 reps,
+    Uint8 format,
+    Uint8 first)
+{
+  double * samples = malloc(sizeof(double) * reps);
+  double sum = 0;
+  Uint32 i = 0;
+  Uint32 j = 0;
+
+  for (i = 0; i < warmup; i++) {
+    for (j = 0; j < bench->batch; j++) {
+      bench->run(ctx);
+    }
+  }
+
+  for (i = 0; i < reps; i++) {
+    double start = fn_bench_usec();
+    for (j = 0; j < bench->batch; j++) {
+      bench->run(ctx);
+    }
+    samples[i] = (fn_bench_usec() - start) / bench->batch;
+    sum += samples[i];
+  }
+
+  qsort(samples, reps, sizeof(double), fn_bench_compare);
+
+  if (format == FN_BENCH_FORMAT_CSV) {
+    printf("%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+        bench->name, reps, bench->batch,
+        samples[0],
+        sum / reps,
+        fn_bench_percentile(samples, reps, 50),
+        fn_bench_percentile(samples, reps, 90),
+        fn_bench_percentile(samples, reps, 99),
+        samples[reps - 1]);
+  } else {
+    printf("%s\n    { \"name\": \"%s\", \"repetitions\": %u, "
+        "\"batch\": %u,\n"
+        "      \"min\": %.3f, \"mean\": %.3f, \"p50\": %.3f, "
+        "\"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f }",
+        first ? "" : ",",
+        bench->name, reps, bench->batch,
+        samples[0],
+        sum / reps,
+        fn_bench_percentile(samples, reps, 50),
+        fn_bench_percentile(samples, reps, 90),
+        fn_bench_percentile(samples, reps, 99),
+        samples[reps - 1]);
+  }
+
+  free(samples);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_bench_usage(char * program)
+{
+  fprintf(stderr, "Usage: %s [OPTIONS] [BENCHMARK...]\n"
+      "  --format json|csv  Output format (default json)\n"
+      "  --warmup N         Untimed runs before measuring (default 5)\n"
+      "  --reps N           Timed samples per benchmark (default 50)\n"
+      "  --level N          Level used by the level benchmarks "
+      "(default 1)\n"
+      "  --scale N          Size of a pixel (default from the settings)\n"
+      "  --threads N        Threads of level_blit_banded "
+      "(default all processors)\n"
+      "Compare level_blit_banded to level_blit at --scale 2, 4 and 6\n"
+      "for the speedup of rendering the level in bands.\n"
+      "Timings are in microseconds per call.\n"
+      "Available benchmarks:",
+      program);
+  fn_bench_t * bench = NULL;
+  for (bench = fn_bench_all; bench->name != NULL; bench++) {
+    fprintf(stderr, " %s", bench->name);
+  }
+  fprintf(stderr, "\n");
+}
+
+/* --------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+  g_type_init();
+
+  fn_bench_context_t ctx;
+  fn_bench_t * bench = NULL;
+  Uint8 format = FN_BENCH_FORMAT_JSON;
+  Uint32 warmup = 5;
+  Uint32 reps = 50;
+  Uint8 first = 1;
+  int selected = argc;
+  int i = 0;
+
+  memset(&ctx, 0, sizeof(fn_bench_context_t));
+  ctx.levelnumber = 1;
+  ctx.threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      i++;
+      if (strcmp(argv[i], "csv") == 0) {
+        format = FN_BENCH_FORMAT_CSV;
+      } else if (strcmp(argv[i], "json") == 0) {
+        format = FN_BENCH_FORMAT_JSON;
+      } else {
+        fn_bench_usage(argv[0]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+      warmup = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+      reps = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+      ctx.levelnumber = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+      ctx.scale = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      ctx.threads = atoi(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      fn_bench_usage(argv[0]);
+      return 1;
+    } else {
+      selected = i;
+      break;
+    }
+  }
+  if (reps == 0) {
+    reps = 1;
+  }
+
+  /* the screen benchmark must not need a display */
+  setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+  ctx.env = fn_environment_create();
+  if (ctx.scale != 0) {
+    /* before the tiles are loaded with the scale */
+    fn_environment_set_pixelsize(ctx.env, ctx.scale);
+    g_object_set(fn_environment_get_graphic_options(ctx.env),
+        "scale", (guint)ctx.scale, NULL);
+  }
+  if (!fn_environment_check_for_episodes(ctx.env) ||
+      !fn_environment_load_tilecache(ctx.env))
+  {
+    fprintf(stderr, "Could not load the game data.\n");
+    return 1;
+  }
+  ctx.hero = fn_hero_create(ctx.env);
+  ctx.level = fn_texture_new_with_options(
+      FN_TILE_WIDTH * FN_LEVEL_WIDTH,
+      FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
+      fn_environment_get_graphic_options(ctx.env));
+  fn_texture_set_category(ctx.level, FN_TEXTURE_CATEGORY_LEVEL);
+  ctx.srcrect = fn_geometry_new(0, 0,
+      FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH,
+      FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT);
+  ctx.dstrect = fn_geometry_new(FN_TILE_WIDTH, FN_TILE_HEIGHT,
+      FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH,
+      FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT);
+
+  if (format == FN_BENCH_FORMAT_CSV) {
+    printf("name,repetitions,batch,min,mean,p50,p90,p99,max\n");
+  } else {
+    printf("{\n  \"version\": \"%s\",\n  \"episode\": %d,\n"
+        "  \"level\": %d,\n  \"scale\": %d,\n  \"threads\": %d,\n"
+        "  \"warmup\": %u,\n  \"unit\": \"us\",\n"
+        "  \"results\": [",
+        VERSION, fn_environment_get_episode(ctx.env),
+        ctx.levelnumber, fn_environment_get_pixelsize(ctx.env),
+        ctx.threads, warmup);
+  }
+
+  for (bench = fn_bench_all; bench->name != NULL; bench++) {
+    if (selected < argc) {
+      Uint8 wanted = 0;
+      for (i = selected; i < argc; i++) {
+        if (strcmp(argv[i], bench->name) == 0) {
+          wanted = 1;
+        }
+      }
+      if (!wanted) {
+        continue;
+      }
+    }
+    if (bench->setup != NULL && !bench->setup(&ctx)) {
+      fprintf(stderr, "Skipping %s.\n", bench->name);
+      continue;
+    }
+    ctx.step = 0;
+    fn_bench_run(&ctx, bench, warmup, reps, format, first);
+    first = 0;
+  }
+
+  if (format == FN_BENCH_FORMAT_JSON) {
+    printf("\n  ]\n}\n");
+  }
+
+  if (ctx.lv != NULL) {
+    fn_level_free(ctx.lv);
+  }
+  g_object_unref(ctx.srcrect);
+  g_object_unref(ctx.dstrect);
+  g_object_unref(ctx.level);
+  fn_hero_delete(ctx.hero);
+  fn_environment_delete(ctx.env);
+  return 0;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,458 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Colour keyed blits of 32 bit surfaces
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define FN_BLIT_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FN_BLIT_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* --------------------------------------------------------------- */
+
+#include "fn_blit.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Copy the pixels of a row which are not the key. The copied
+ * pixels are masked with rgbmask, because SDL does not keep the
+ * unused byte of a pixel either.
+ */
+typedef void (* fn_blit_row_t)(const Uint32 * src,
+    Uint32 * dst,
+    int width,
+    Uint32 key,
+    Uint32 rgbmask);
+
+/* --------------------------------------------------------------- */
+
+static char * fn_blit_impl_names[FN_BLIT_NUM_IMPLS] = {
+  "scalar",
+  "sse2",
+  "avx2",
+  "neon"
+};
+
+/* --------------------------------------------------------------- */
+
+static void fn_blit_row_scalar(const Uint32 * src,
+    Uint32 * dst,
+    int width,
+    Uint32 key,
+    Uint32 rgbmask)
+{
+  int x = 0;
+  for (x = 0; x < width; x++) {
+    if (src[x] != key) {
+      dst[x] = src[x] & rgbmask;
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+#ifdef FN_BLIT_X86
+
+__attribute__((target("sse2")))
+static void fn_blit_row_sse2(const Uint32 * src,
+    Uint32 * dst,
+    int width,
+    Uint32 key,
+    Uint32 rgbmask)
+{
+  __m128i k = _mm_set1_epi32(key);
+  __m128i m = _mm_set1_epi32(rgbmask);
+  int x = 0;
+
+  for (; x + 4 <= width; x += 4) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+    __m128i keyed = _mm_cmpeq_epi32(s, k);
+    _mm_storeu_si128((__m128i *)(dst + x),
+        _mm_or_si128(_mm_and_si128(keyed, d),
+          _mm_andnot_si128(keyed, _mm_and_si128(s, m))));
+  }
+  fn_blit_row_scalar(src + x, dst + x, width - x, key, rgbmask);
+}
+
+/* --------------------------------------------------------------- */
+
+__attribute__((target("avx2")))
+static void fn_blit_row_avx2(const Uint32 * src,
+    Uint32 * dst,
+    int width,
+    Uint32 key,
+    Uint32 rgbmask)
+{
+  __m256i k = _mm256_set1_epi32(key);
+  __m256i m = _mm256_set1_epi32(rgbmask);
+  int x = 0;
+
+  for (; x + 8 <= width; x += 8) {
+    __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+    __m256i keyed = _mm256_cmpeq_epi32(s, k);
+    _mm256_storeu_si256((__m256i *)(dst + x),
+        _mm256_blendv_epi8(_mm256_and_si256(s, m), d, keyed));
+  }
+  fn_blit_row_scalar(src + x, dst + x, width - x, key, rgbmask);
+}
+
+#endif /* FN_BLIT_X86 */
+
+/* --------------------------------------------------------------- */
+
+#ifdef FN_BLIT_NEON
+
+static void fn_blit_row_neon(const Uint32 * src,
+    Uint32 * dst,
+    int width,
+    Uint32 key,
+    Uint32 rgbmask)
+{
+  uint32x4_t k = vdupq_n_u32(key);
+  uint32x4_t m = vdupq_n_u32(rgbmask);
+  int x = 0;
+
+  for (; x + 4 <= width; x += 4) {
+    uint32x4_t s = vld1q_u32(src + x);
+    uint32x4_t d = vld1q_u32(dst + x);
+    uint32x4_t keyed = vceqq_u32(s, k);
+    vst1q_u32(dst + x, vbslq_u32(keyed, d, vandq_u32(s, m)));
+  }
+  fn_blit_row_scalar(src + x, dst + x, width - x, key, rgbmask);
+}
+
+#endif /* FN_BLIT_NEON */
+
+/* --------------------------------------------------------------- */
+
+static fn_blit_row_t fn_blit_rows[FN_BLIT_NUM_IMPLS] = {
+  fn_blit_row_scalar,
+#ifdef FN_BLIT_X86
+  fn_blit_row_sse2,
+  fn_blit_row_avx2,
+#else
+  NULL,
+  NULL,
+#endif
+#ifdef FN_BLIT_NEON
+  fn_blit_row_neon
+#else
+  NULL
+#endif
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The implementation in use, chosen on the first blit unless it
+ * was set before. Threads choosing it at the same time all pick
+ * the same one.
+ */
+static fn_blit_row_t fn_blit_row = NULL;
+static fn_blit_impl_e fn_blit_impl = FN_BLIT_IMPL_SCALAR;
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_blit_impl_available(fn_blit_impl_e impl)
+{
+  if (impl >= FN_BLIT_NUM_IMPLS || fn_blit_rows[impl] == NULL) {
+    return 0;
+  }
+#ifdef FN_BLIT_X86
+  if (impl == FN_BLIT_IMPL_SSE2) {
+    return (__builtin_cpu_supports("sse2") != 0);
+  }
+  if (impl == FN_BLIT_IMPL_AVX2) {
+    return (__builtin_cpu_supports("avx2") != 0);
+  }
+#endif
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_blit_set_impl(fn_blit_impl_e impl)
+{
+  if (!fn_blit_impl_available(impl)) {
+    return 0;
+  }
+  fn_blit_impl = impl;
+  fn_blit_row = fn_blit_rows[impl];
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_blit_choose_impl(void)
+{
+  int impl = 0;
+  for (impl = FN_BLIT_NUM_IMPLS - 1; impl > FN_BLIT_IMPL_SCALAR; impl--) {
+    if (fn_blit_set_impl(impl)) {
+      return;
+    }
+  }
+  fn_blit_set_impl(FN_BLIT_IMPL_SCALAR);
+}
+
+/* --------------------------------------------------------------- */
+
+fn_blit_impl_e fn_blit_get_impl(void)
+{
+  if (fn_blit_row == NULL) {
+    fn_blit_choose_impl();
+  }
+  return fn_blit_impl;
+}
+
+/* --------------------------------------------------------------- */
+
+char * fn_blit_impl_name(fn_blit_impl_e impl)
+{
+  if (impl >= FN_BLIT_NUM_IMPLS) {
+    return "unknown";
+  }
+  return fn_blit_impl_names[impl];
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if the surfaces have the format handled here, which is
+ * also the one SDL uses its generic keyed blitter for. Surfaces
+ * which must be locked are left to SDL.
+ */
+static Uint8 fn_blit_supported(SDL_Surface * src, SDL_Surface * dst)
+{
+  SDL_PixelFormat * sf = src->format;
+  SDL_PixelFormat * df = dst->format;
+
+  return (src != dst &&
+      !SDL_MUSTLOCK(src) && !SDL_MUSTLOCK(dst) &&
+      (src->flags & SDL_SRCCOLORKEY) &&
+      !(src->flags & (SDL_SRCALPHA | SDL_RLEACCEL)) &&
+      sf->BytesPerPixel == 4 && df->BytesPerPixel == 4 &&
+      sf->Amask == 0 && df->Amask == 0 &&
+      sf->Rmask == df->Rmask &&
+      sf->Gmask == df->Gmask &&
+      sf->Bmask == df->Bmask);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_blit_clip(SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * clip,
+    SDL_Rect * dstrect,
+    SDL_Rect * area)
+{
+  int srcx = 0;
+  int srcy = 0;
+  int w = 0;
+  int h = 0;
+  int dx = 0;
+
+  /* the same clipping as in SDL_UpperBlit */
+  if (srcrect != NULL) {
+    srcx = srcrect->x;
+    w = srcrect->w;
+    if (srcx < 0) {
+      w += srcx;
+      dstrect->x -= srcx;
+      srcx = 0;
+    }
+    if (src->w - srcx < w) {
+      w = src->w - srcx;
+    }
+
+    srcy = srcrect->y;
+    h = srcrect->h;
+    if (srcy < 0) {
+      h += srcy;
+      dstrect->y -= srcy;
+      srcy = 0;
+    }
+    if (src->h - srcy < h) {
+      h = src->h - srcy;
+    }
+  } else {
+    w = src->w;
+    h = src->h;
+  }
+
+  dx = clip->x - dstrect->x;
+  if (dx > 0) {
+    w -= dx;
+    dstrect->x += dx;
+    srcx += dx;
+  }
+  dx = dstrect->x + w - clip->x - clip->w;
+  if (dx > 0) {
+    w -= dx;
+  }
+
+  dx = clip->y - dstrect->y;
+  if (dx > 0) {
+    h -= dx;
+    dstrect->y += dx;
+    srcy += dx;
+  }
+  dx = dstrect->y + h - clip->y - clip->h;
+  if (dx > 0) {
+    h -= dx;
+  }
+
+  if (w <= 0 || h <= 0) {
+    dstrect->w = 0;
+    dstrect->h = 0;
+    return 0;
+  }
+  dstrect->w = w;
+  dstrect->h = h;
+  area->x = srcx;
+  area->y = srcy;
+  area->w = w;
+  area->h = h;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_blit_can_copy(SDL_Surface * src, SDL_Surface * dst)
+{
+  SDL_PixelFormat * sf = src->format;
+  SDL_PixelFormat * df = dst->format;
+
+  if (src == dst ||
+      SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst) ||
+      (src->flags & SDL_SRCALPHA) ||
+      sf->BytesPerPixel != df->BytesPerPixel)
+  {
+    return 0;
+  }
+
+  switch (sf->BytesPerPixel) {
+    case 1:
+      /* the palettes must be the same, or SDL maps the colours */
+      return (sf->palette != NULL && df->palette != NULL &&
+          sf->palette->ncolors == df->palette->ncolors &&
+          memcmp(sf->palette->colors, df->palette->colors,
+            sf->palette->ncolors * sizeof(SDL_Color)) == 0);
+    case 2:
+    case 4:
+      if ((src->flags & SDL_SRCCOLORKEY) && sf->Amask != 0) {
+        return 0;
+      }
+      return (sf->Rmask == df->Rmask &&
+          sf->Gmask == df->Gmask &&
+          sf->Bmask == df->Bmask &&
+          sf->Amask == df->Amask);
+    default:
+      return 0;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_blit_copy(SDL_Surface * src,
+    const SDL_Rect * area,
+    SDL_Surface * dst,
+    int x,
+    int y)
+{
+  Uint8 bpp = src->format->BytesPerPixel;
+  Uint32 key = src->format->colorkey;
+  int row = 0;
+  int i = 0;
+
+  if (fn_blit_row == NULL) {
+    fn_blit_choose_impl();
+  }
+
+  for (row = 0; row < area->h; row++) {
+    Uint8 * s = (Uint8 *)src->pixels +
+      (area->y + row) * src->pitch + area->x * bpp;
+    Uint8 * d = (Uint8 *)dst->pixels +
+      (y + row) * dst->pitch + x * bpp;
+
+    if (!(src->flags & SDL_SRCCOLORKEY)) {
+      memcpy(d, s, area->w * bpp);
+    } else if (bpp == 4) {
+      fn_blit_row((const Uint32 *)s, (Uint32 *)d, area->w, key,
+          src->format->Rmask | src->format->Gmask | src->format->Bmask);
+    } else if (bpp == 2) {
+      for (i = 0; i < area->w; i++) {
+        if (((Uint16 *)s)[i] != key) {
+          ((Uint16 *)d)[i] = ((Uint16 *)s)[i];
+        }
+      }
+    } else {
+      for (i = 0; i < area->w; i++) {
+        if (s[i] != key) {
+          d[i] = s[i];
+        }
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_blit_keyed(SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Surface * dst,
+    SDL_Rect * dstrect)
+{
+  SDL_Rect fulldst;
+  SDL_Rect area;
+
+  if (!fn_blit_supported(src, dst)) {
+    return 0;
+  }
+
+  if (dstrect == NULL) {
+    fulldst.x = 0;
+    fulldst.y = 0;
+    dstrect = &fulldst;
+  }
+
+  if (fn_blit_clip(src, srcrect, &(dst->clip_rect), dstrect, &area)) {
+    fn_blit_copy(src, &area, dst, dstrect->x, dstrect->y);
+  }
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,173 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Colour keyed blits of 32 bit surfaces
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_BLIT_H
+#define FN_BLIT_H
+
+/* --------------------------------------------------------------- */
+
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The implementations of the colour keyed blit.
+ */
+typedef enum fn_blit_impl_e {
+  FN_BLIT_IMPL_SCALAR,
+  FN_BLIT_IMPL_SSE2,
+  FN_BLIT_IMPL_AVX2,
+  FN_BLIT_IMPL_NEON,
+  FN_BLIT_NUM_IMPLS
+} fn_blit_impl_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit a colour keyed surface onto another one with the same 32
+ * bit format. Clipping and the rectangles behave exactly like they
+ * do with SDL_BlitSurface, and so do the pixels written.
+ *
+ * Surfaces which are not 32 bits, differ in their format, have
+ * an alpha channel or no colour key, or must be locked, are not
+ * handled.
+ *
+ * @param  src      The source surface.
+ * @param  srcrect  The part of the source to blit, or NULL for all.
+ * @param  dst      The target surface.
+ * @param  dstrect  The position on the target, or NULL for the top
+ *                  left corner. Set to the blitted area.
+ *
+ * @return 1 if the blit was done, 0 if SDL_BlitSurface has to do
+ *         it.
+ */
+Uint8 fn_blit_keyed(SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Surface * dst,
+    SDL_Rect * dstrect);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Clip a blit exactly like SDL_BlitSurface does, without drawing.
+ *
+ * @param  src      The source surface.
+ * @param  srcrect  The part of the source to blit, or NULL for all.
+ * @param  clip     The rectangle of the target to draw into.
+ * @param  dstrect  The position on the target. Set to the area
+ *                  which is drawn.
+ * @param  area     Set to the part of the source which is drawn.
+ *
+ * @return 1 if anything is left to draw, otherwise 0.
+ */
+Uint8 fn_blit_clip(SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * clip,
+    SDL_Rect * dstrect,
+    SDL_Rect * area);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if fn_blit_copy draws a surface onto another one exactly
+ * like SDL_BlitSurface does. This is the case for surfaces with
+ * 8, 16 or 32 bits in the same format, with or without a colour
+ * key, which need not be locked.
+ *
+ * @param  src  The source surface.
+ * @param  dst  The target surface.
+ *
+ * @return 1 if fn_blit_copy can be used, otherwise 0.
+ */
+Uint8 fn_blit_can_copy(SDL_Surface * src, SDL_Surface * dst);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw an already clipped part of a surface. It neither clips nor
+ * changes any of the surfaces, so several threads can draw
+ * different rows of the same target at once.
+ *
+ * @param  src   The source surface.
+ * @param  area  The part of the source to draw.
+ * @param  dst   The target surface.
+ * @param  x     The x position on the target.
+ * @param  y     The y position on the target.
+ */
+void fn_blit_copy(SDL_Surface * src,
+    const SDL_Rect * area,
+    SDL_Surface * dst,
+    int x,
+    int y);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if an implementation can run on this machine.
+ *
+ * @param  impl  The implementation.
+ *
+ * @return 1 if it is available, otherwise 0.
+ */
+Uint8 fn_blit_impl_available(fn_blit_impl_e impl);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Choose the implementation used by fn_blit_keyed. By default the
+ * fastest available one is used.
+ *
+ * @param  impl  The implementation.
+ *
+ * @return 1 on success, 0 if it is not available.
+ */
+Uint8 fn_blit_set_impl(fn_blit_impl_e impl);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the implementation used by fn_blit_keyed.
+ *
+ * @return The implementation.
+ */
+fn_blit_impl_e fn_blit_get_impl(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the name of an implementation.
+ *
+ * @param  impl  The implementation.
+ *
+ * @return The name.
+ */
+char * fn_blit_impl_name(fn_blit_impl_e impl);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_BLIT_H */
@@ -37,6 +37,64 @@
 
 /* --------------------------------------------------------------- */
 
+/**
+ * What the status display shows at the moment, so that a change
+ * only redraws the digits and icons that differ.
+ */
+static struct {
+  Uint64 score;
+  Uint8 health;
+  Uint8 firepower;
+  Uint8 inventory;
+} fn_borders_shown;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The inventory items with their places in the status display,
+ * in half tiles.
+ */
+static struct {
+  Uint8 item;
+  int tile;
+  int x;
+  int y;
+} fn_borders_items[FN_SIZE_INVENTORY] = {
+  { FN_INVENTORY_KEY_RED,     OBJ_KEY_RED,     0, 0 },
+  { FN_INVENTORY_KEY_GREEN,   OBJ_KEY_GREEN,   2, 0 },
+  { FN_INVENTORY_KEY_BLUE,    OBJ_KEY_BLUE,    4, 0 },
+  { FN_INVENTORY_KEY_PINK,    OBJ_KEY_PINK,    6, 0 },
+  { FN_INVENTORY_BOOT,        OBJ_BOOT,        0, 2 },
+  { FN_INVENTORY_GLOVE,       OBJ_ROBOHAND,    2, 2 },
+  { FN_INVENTORY_CLAMP,       OBJ_CLAMP,       4, 2 },
+  { FN_INVENTORY_ACCESS_CARD, OBJ_ACCESS_CARD, 6, 2 },
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw a single tile of the status display to the screen and
+ * mark it as changed.
+ */
+static void fn_borders_update_tile(
+    fn_environment_t * env,
+    int tile,
+    int x,
+    int y,
+    Uint16 width,
+    Uint16 height)
+{
+  FnScreen * screen = fn_environment_get_screen(env);
+  FnRect dstrect = { x, y, width, height };
+  FnRect srcrect = { 0, 0, width, height };
+
+  fn_screen_clone_texture_rect(screen, &dstrect,
+      fn_environment_get_tile(env, tile), &srcrect);
+  fn_screen_mark_dirty(screen, &dstrect);
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_borders_blit_tile(
     fn_environment_t * env,
     FnTexture * target,
@@ -44,17 +102,17 @@ void fn_borders_blit_tile(
     int x,
     int y)
 {
-  FnGeometry * dstrect;
-  dstrect = fn_geometry_new(
-      FN_HALFTILE_WIDTH * x,
-      FN_HALFTILE_HEIGHT * y,
-      0,
-      0);
-  fn_texture_clone_to_texture(
+  FnRect dstrect = {
+    FN_HALFTILE_WIDTH * x,
+    FN_HALFTILE_HEIGHT * y,
+    0,
+    0
+  };
+  fn_texture_clone_rect(
       tile,
       NULL,
       target,
-      dstrect);
+      &dstrect);
 }
 
 /* --------------------------------------------------------------- */
@@ -178,6 +236,7 @@ void fn_borders_blit(
         FN_WINDOW_WIDTH,
         FN_WINDOW_HEIGHT,
         graphic_options);
+  fn_texture_set_category(texture, FN_TEXTURE_CATEGORY_UI);
 
   fn_borders_blit_array(
       env,
@@ -203,7 +262,12 @@ void fn_borders_blit_life(
 {
   FnGraphicOptions * graphic_options;
   FnTexture * lifetexture;
-  FnGeometry * dstrect;
+  FnRect dstrect = {
+    30 * FN_FONT_WIDTH,
+    7.5 * FN_FONT_HEIGHT,
+    FN_NUM_MAXLIFE * FN_FONT_WIDTH,
+    FN_TILE_HEIGHT
+  };
   FnScreen * screen;
 
   graphic_options =
@@ -214,12 +278,7 @@ void fn_borders_blit_life(
         FN_TILE_HEIGHT,
         graphic_options
         );
-  dstrect =
-    fn_geometry_new(
-        30 * FN_FONT_WIDTH,
-        7.5 * FN_FONT_HEIGHT,
-        FN_NUM_MAXLIFE * FN_FONT_WIDTH,
-        FN_TILE_HEIGHT);
+  fn_texture_set_category(lifetexture, FN_TEXTURE_CATEGORY_UI);
   screen =
     fn_environment_get_screen(env);
 
@@ -243,10 +302,10 @@ void fn_borders_blit_life(
       env, lifetexture, lifetiles, FN_NUM_MAXLIFE, 1, 0
       );
 
-  fn_screen_clone_texture(screen, dstrect, lifetexture, NULL);
+  fn_screen_clone_texture_rect(screen, &dstrect, lifetexture, NULL);
+  fn_borders_shown.health = fn_environment_get_health(env);
 
   g_object_unref(lifetexture);
-  g_object_unref(dstrect);
 }
 
 /* --------------------------------------------------------------- */
@@ -254,39 +313,16 @@ void fn_borders_blit_life(
 void fn_borders_blit_score(
     fn_environment_t * env)
 {
-  FnGraphicOptions * graphic_options;
-  FnTexture * scoresurface;
-  SDL_Rect dstrect;
-
-  char scoretext[FN_SCORE_DIGITS+1];
+  FnRect dstrect = { 30 * FN_FONT_WIDTH, 3 * FN_FONT_HEIGHT, 0, 0 };
 
-  graphic_options =
-    fn_environment_get_graphic_options(env);
-  scoresurface = fn_texture_new_with_options(
-      FN_FONT_WIDTH * FN_SCORE_DIGITS,
-      FN_FONT_HEIGHT,
-      graphic_options
-      );
-
-  sprintf(scoretext, "%08llu",
-      (long long unsigned int)fn_environment_get_score(env));
-
-  fn_text_print(
-      scoresurface,
-      NULL,
+  /* the digits go straight to the screen, the score changes too
+   * often to be worth caching as a text */
+  fn_text_print_number(fn_environment_get_screen(env),
+      &dstrect,
       env,
-      scoretext
-      );
-
-  Uint8 pixelsize = fn_environment_get_pixelsize(env);
-  dstrect.x = 30 * pixelsize * FN_FONT_WIDTH;
-  dstrect.y = 3 * pixelsize * FN_FONT_HEIGHT;
-  dstrect.w = FN_NUM_MAXLIFE * FN_FONT_WIDTH * pixelsize;
-  dstrect.h = FN_TILE_HEIGHT * pixelsize;
-
-  SDL_Surface * screen = fn_environment_get_screen_sdl(env);
-  fn_texture_blit_to_sdl_surface(scoresurface, NULL, screen, &dstrect);
-  g_object_unref(scoresurface);
+      fn_environment_get_score(env),
+      FN_SCORE_DIGITS);
+  fn_borders_shown.score = fn_environment_get_score(env);
 }
 
 /* --------------------------------------------------------------- */
@@ -296,7 +332,12 @@ void fn_borders_blit_firepower(
 {
   FnGraphicOptions * graphic_options;
   FnTexture * firepowertexture;
-  FnGeometry * destrect;
+  FnRect destrect = {
+    30 * FN_FONT_WIDTH,
+    12 * FN_FONT_HEIGHT,
+    FN_NUM_MAXFIREPOWER * FN_TILE_WIDTH,
+    FN_TILE_HEIGHT * 2
+  };
   FnScreen * screen;
 
   int i;
@@ -321,6 +362,7 @@ void fn_borders_blit_firepower(
       FN_TILE_HEIGHT * 2,
       graphic_options
       );
+  fn_texture_set_category(firepowertexture, FN_TEXTURE_CATEGORY_UI);
 
   fn_borders_blit_array(
       env,
@@ -328,15 +370,10 @@ void fn_borders_blit_firepower(
       FN_NUM_MAXFIREPOWER * 2, 4, 0
       );
 
-  destrect = fn_geometry_new(
-      30 * FN_FONT_WIDTH,
-      12 * FN_FONT_HEIGHT,
-      FN_NUM_MAXFIREPOWER * FN_TILE_WIDTH,
-      FN_TILE_HEIGHT * 2);
-
   screen = fn_environment_get_screen(env);
 
-  fn_screen_clone_texture(screen, destrect, firepowertexture, NULL);
+  fn_screen_clone_texture_rect(screen, &destrect, firepowertexture, NULL);
+  fn_borders_shown.firepower = fn_environment_get_firepower(env);
   g_object_unref(firepowertexture);
 }
 
@@ -347,7 +384,12 @@ void fn_borders_blit_inventory(
 {
   FnGraphicOptions * graphic_options;
   FnTexture * inventorytexture;
-  FnGeometry * destrect;
+  FnRect destrect = {
+    30 * FN_FONT_WIDTH,
+    18 * FN_FONT_HEIGHT,
+    FN_NUM_MAXFIREPOWER * FN_TILE_WIDTH,
+    FN_TILE_HEIGHT * 2
+  };
   FnScreen * screen;
 
   int i;
@@ -385,6 +427,7 @@ void fn_borders_blit_inventory(
       FN_TILE_WIDTH * FN_SIZE_INVENTORY / 2,
       FN_TILE_HEIGHT * 2,
       graphic_options);
+  fn_texture_set_category(inventorytexture, FN_TEXTURE_CATEGORY_UI);
 
   fn_borders_blit_array(
       env,
@@ -392,14 +435,102 @@ void fn_borders_blit_inventory(
       FN_NUM_MAXFIREPOWER * 2, 4, 0
       );
 
-  destrect = fn_geometry_new(
-      30 * FN_FONT_WIDTH,
-      18 * FN_FONT_HEIGHT,
-      FN_NUM_MAXFIREPOWER * FN_TILE_WIDTH,
-      FN_TILE_HEIGHT * 2);
+  screen = fn_environment_get_screen(env);
 
-  fn_screen_clone_texture(screen, destrect, inventorytexture, NULL);
+  fn_screen_clone_texture_rect(screen, &destrect, inventorytexture, NULL);
+  fn_borders_shown.inventory = inventory;
   g_object_unref(inventorytexture);
 }
 
 /* --------------------------------------------------------------- */
+
+void fn_borders_update_life(
+    fn_environment_t * env)
+{
+  Uint8 health = fn_environment_get_health(env);
+  int i;
+
+  for (i = 0; i < FN_NUM_MAXLIFE; i++) {
+    if ((i < health) != (i < fn_borders_shown.health)) {
+      fn_borders_update_tile(env,
+          i < health ? OBJ_HEALTH : OBJ_NONHEALTH,
+          30 * FN_FONT_WIDTH + i * FN_FONT_WIDTH,
+          7.5 * FN_FONT_HEIGHT,
+          FN_FONT_WIDTH,
+          FN_TILE_HEIGHT);
+    }
+  }
+  fn_borders_shown.health = health;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_score(
+    fn_environment_t * env)
+{
+  FnScreen * screen = fn_environment_get_screen(env);
+  Uint64 score = fn_environment_get_score(env);
+  Uint64 now = score;
+  Uint64 before = fn_borders_shown.score;
+  FnRect dstrect = {
+    0, 3 * FN_FONT_HEIGHT, FN_FONT_WIDTH, FN_FONT_HEIGHT
+  };
+  int i;
+
+  /* usually only the lowest few digits change */
+  for (i = FN_SCORE_DIGITS - 1; i >= 0 && now != before; i--) {
+    if (now % 10 != before % 10) {
+      dstrect.x = 30 * FN_FONT_WIDTH + i * FN_FONT_WIDTH;
+      fn_text_print_number(screen, &dstrect, env, now % 10, 1);
+      fn_screen_mark_dirty(screen, &dstrect);
+    }
+    now /= 10;
+    before /= 10;
+  }
+  fn_borders_shown.score = score;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_firepower(
+    fn_environment_t * env)
+{
+  Uint8 firepower = fn_environment_get_firepower(env);
+  int i;
+
+  /* like the whole display, a lost shot is not cleared */
+  for (i = fn_borders_shown.firepower; i < firepower; i++) {
+    fn_borders_update_tile(env,
+        OBJ_SHOT,
+        30 * FN_FONT_WIDTH + i * FN_TILE_WIDTH,
+        12 * FN_FONT_HEIGHT + FN_TILE_HEIGHT,
+        FN_TILE_WIDTH,
+        FN_TILE_HEIGHT);
+  }
+  fn_borders_shown.firepower = firepower;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_inventory(
+    fn_environment_t * env)
+{
+  Uint8 inventory = fn_environment_get_inventory(env);
+  Uint8 added = inventory & ~fn_borders_shown.inventory;
+  int i;
+
+  /* like the whole display, a used item is not cleared */
+  for (i = 0; i < FN_SIZE_INVENTORY; i++) {
+    if (added & fn_borders_items[i].item) {
+      fn_borders_update_tile(env,
+          fn_borders_items[i].tile,
+          30 * FN_FONT_WIDTH + fn_borders_items[i].x * FN_HALFTILE_WIDTH,
+          18 * FN_FONT_HEIGHT + fn_borders_items[i].y * FN_HALFTILE_HEIGHT,
+          FN_TILE_WIDTH,
+          FN_TILE_HEIGHT);
+    }
+  }
+  fn_borders_shown.inventory = inventory;
+}
+
+/* --------------------------------------------------------------- */
@@ -33,6 +33,26 @@
 #include "fn.h"
 #include "fn_environment.h"
 #include "fn_tilecache.h"
+#include "fntexture.h"
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_blit_tile(
+    fn_environment_t * env,
+    FnTexture * target,
+    FnTexture * tile,
+    int x,
+    int y);
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_blit_array(
+    fn_environment_t * env,
+    FnTexture * target,
+    int * borders,
+    Uint8 width,
+    Uint8 height,
+    int tile_base);
 
 /* --------------------------------------------------------------- */
 
@@ -60,3 +80,29 @@ void fn_borders_blit_inventory(
     fn_environment_t * env);
 
 /* --------------------------------------------------------------- */
+
+/*
+ * The update functions only redraw the parts of the status display
+ * that differ from what the blit functions above or an earlier
+ * update have drawn, and mark them as changed on the screen.
+ */
+
+void fn_borders_update_life(
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_score(
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_firepower(
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+void fn_borders_update_inventory(
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
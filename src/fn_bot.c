@@ -34,6 +34,7 @@
 #include "fn_bot.h"
 #include "fn_object.h"
 #include "fn_environment.h"
+#include "fn_level.h"
 
 /* --------------------------------------------------------------- */
 
@@ -107,16 +108,10 @@ void fn_bot_free(fn_bot_t * bot)
 
 /* --------------------------------------------------------------- */
 
-void fn_bot_blit(fn_bot_t * bot, SDL_Surface * target)
+void fn_bot_blit(fn_bot_t * bot, fn_level_t * level)
 {
-  SDL_Rect dstrect;
-  FnTexture * tile = NULL;
-  fn_environment_t * env = bot->environment;
-  Uint8 pixelsize = fn_environment_get_pixelsize(env);
-  dstrect.x = bot->x * pixelsize * FN_HALFTILE_WIDTH;
-  dstrect.y = bot->y * pixelsize * FN_HALFTILE_HEIGHT;
-  dstrect.w = FN_TILE_WIDTH * pixelsize;
-  dstrect.h = FN_TILE_HEIGHT * pixelsize;
+  int x = bot->x * FN_HALFTILE_WIDTH;
+  int y = bot->y * FN_HALFTILE_HEIGHT;
   switch(bot->type) {
     case FN_BOT_TYPE_FIREWHEEL:
       /* TODO */
@@ -128,30 +123,14 @@ void fn_bot_blit(fn_bot_t * bot, SDL_Surface * target)
       /* TODO */
       break;
     case FN_BOT_TYPE_FOOTBOT:
-      {
-        tile = fn_environment_get_tile(env,
-            ANIM_FOOTBOT + 2);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-        dstrect.x += FN_TILE_WIDTH * pixelsize;
-
-        tile = fn_environment_get_tile(env,
-            ANIM_FOOTBOT + 3);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-        dstrect.x -= FN_TILE_WIDTH * pixelsize;
-        dstrect.y -= FN_TILE_HEIGHT * pixelsize;
-
-        tile = fn_environment_get_tile(env,
-            ANIM_FOOTBOT + 0);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-        dstrect.x += FN_TILE_WIDTH * pixelsize;
-
-        tile = fn_environment_get_tile(env,
-            ANIM_FOOTBOT + 1);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-      }
+      fn_level_draw_tile(level, ANIM_FOOTBOT + 2,
+          x, y, FN_LEVEL_LAYER_FOREGROUND);
+      fn_level_draw_tile(level, ANIM_FOOTBOT + 3,
+          x + FN_TILE_WIDTH, y, FN_LEVEL_LAYER_FOREGROUND);
+      fn_level_draw_tile(level, ANIM_FOOTBOT + 0,
+          x, y - FN_TILE_HEIGHT, FN_LEVEL_LAYER_FOREGROUND);
+      fn_level_draw_tile(level, ANIM_FOOTBOT + 1,
+          x + FN_TILE_WIDTH, y - FN_TILE_HEIGHT, FN_LEVEL_LAYER_FOREGROUND);
       /* TODO */
       break;
     case FN_BOT_TYPE_HELICOPTER:
@@ -171,26 +150,19 @@ void fn_bot_blit(fn_bot_t * bot, SDL_Surface * target)
       break;
     case FN_BOT_TYPE_TANKBOT:
       /* TODO */
-      {
-        tile = fn_environment_get_tile(env,
-            ANIM_CARBOT);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-        dstrect.x += FN_TILE_WIDTH * pixelsize;
-        tile = fn_environment_get_tile(env,
-            ANIM_CARBOT + 1);
-        fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-      }
+      fn_level_draw_tile(level, ANIM_CARBOT,
+          x, y, FN_LEVEL_LAYER_FOREGROUND);
+      fn_level_draw_tile(level, ANIM_CARBOT + 1,
+          x + FN_TILE_WIDTH, y, FN_LEVEL_LAYER_FOREGROUND);
       break;
     case FN_BOT_TYPE_WALLCRAWLER_LEFT:
-      tile = fn_environment_get_tile(env,
-          ANIM_WALLCRAWLERBOT_LEFT);
-      fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
+      fn_level_draw_tile(level, ANIM_WALLCRAWLERBOT_LEFT,
+          x, y, FN_LEVEL_LAYER_FOREGROUND);
       /* TODO */
       break;
     case FN_BOT_TYPE_WALLCRAWLER_RIGHT:
-      tile = fn_environment_get_tile(env,
-          ANIM_WALLCRAWLERBOT_RIGHT);
-      fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
+      fn_level_draw_tile(level, ANIM_WALLCRAWLERBOT_RIGHT,
+          x, y, FN_LEVEL_LAYER_FOREGROUND);
       /* TODO */
       break;
     case FN_BOT_TYPE_DRPROTON:
@@ -255,9 +255,9 @@ void fn_bot_free(fn_bot_t * bot);
  * Blit the bot into the level.
  *
  * @param  bot     The bot to blit.
- * @param  target  The target surface.
+ * @param  level   The level to draw the bot on.
  */
-void fn_bot_blit(fn_bot_t * bot, SDL_Surface * target);
+void fn_bot_blit(fn_bot_t * bot, fn_level_t * level);
 
 /* --------------------------------------------------------------- */
 
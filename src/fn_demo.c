@@ -0,0 +1,410 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Demo recording and playback
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_demo.h"
+
+/* --------------------------------------------------------------- */
+
+static char const fn_demo_magic[4] = { 'F', 'N', 'D', 'M' };
+
+/* --------------------------------------------------------------- */
+
+struct fn_demo_t {
+  /**
+   * The demo file.
+   */
+  FILE * file;
+
+  /**
+   * The mode (one of the FN_DEMO_MODE_* values).
+   */
+  Uint8 mode;
+
+  /**
+   * The input value of the current run.
+   */
+  Uint8 run_input;
+
+  /**
+   * The number of ticks in the current run. When recording, this
+   * is the number of ticks not yet written, when replaying the
+   * number of ticks not yet used.
+   */
+  Uint8 run_length;
+
+  /**
+   * Set when the replayed level has no more input.
+   */
+  Uint8 exhausted;
+
+  /**
+   * Set when a replayed level did not end in the recorded state.
+   */
+  Uint8 differs;
+
+  /**
+   * The number of ticks in the current level.
+   */
+  Uint32 ticks;
+
+  /**
+   * The time at which the current level was started.
+   */
+  Uint32 starttime;
+
+  /**
+   * The number of the level read by fn_demo_read_level.
+   */
+  Uint8 levelnumber;
+
+  /**
+   * The random seed of the current level.
+   */
+  Uint32 seed;
+
+  /**
+   * The hero state at the start of the current level.
+   */
+  Uint8 health;
+  Uint8 firepower;
+  Uint8 inventory;
+  Uint64 score;
+};
+
+/* --------------------------------------------------------------- */
+
+static void fn_demo_write_uint32(FILE * file, Uint32 value)
+{
+  Uint8 buf[4];
+  buf[0] = value & 0xFF;
+  buf[1] = (value >> 8) & 0xFF;
+  buf[2] = (value >> 16) & 0xFF;
+  buf[3] = (value >> 24) & 0xFF;
+  fwrite(buf, 1, 4, file);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_demo_read_uint32(FILE * file)
+{
+  Uint8 buf[4] = { 0, 0, 0, 0 };
+  if (fread(buf, 1, 4, file) != 4) {
+    return 0;
+  }
+  return
+    ((Uint32)buf[0]) |
+    ((Uint32)buf[1] << 8) |
+    ((Uint32)buf[2] << 16) |
+    ((Uint32)buf[3] << 24);
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_demo_checksum(fn_level_t * lv)
+{
+  fn_hero_t * hero = fn_level_get_hero(lv);
+  SDL_Rect * position = fn_hero_get_position(hero);
+  Uint32 sum = 0;
+  fn_list_t * iter = NULL;
+
+  sum = sum * 31 + position->x;
+  sum = sum * 31 + position->y;
+  sum = sum * 31 + fn_hero_get_health(hero);
+  sum = sum * 31 + fn_hero_get_firepower(hero);
+  sum = sum * 31 + fn_hero_get_inventory(hero);
+  sum = sum * 31 + (Uint32)fn_hero_get_score(hero);
+
+  for (iter = fn_list_first(lv->actors);
+      iter != fn_list_last(lv->actors);
+      iter = fn_list_next(iter))
+  {
+    fn_level_actor_t * actor = (fn_level_actor_t *)iter->data;
+    sum = sum * 31 + actor->type;
+    sum = sum * 31 + actor->position.x;
+    sum = sum * 31 + actor->position.y;
+  }
+
+  return sum;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_demo_flush_run(fn_demo_t * demo)
+{
+  if (demo->run_length > 0) {
+    fputc(demo->run_length, demo->file);
+    fputc(demo->run_input, demo->file);
+    demo->run_length = 0;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+fn_demo_t * fn_demo_open_record(char * path)
+{
+  FILE * file = fopen(path, "wb");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  fn_demo_t * demo = malloc(sizeof(fn_demo_t));
+  memset(demo, 0, sizeof(fn_demo_t));
+  demo->file = file;
+  demo->mode = FN_DEMO_MODE_RECORD;
+
+  fwrite(fn_demo_magic, 1, sizeof(fn_demo_magic), file);
+  fputc(FN_DEMO_VERSION, file);
+
+  return demo;
+}
+
+/* --------------------------------------------------------------- */
+
+fn_demo_t * fn_demo_open_replay(char * path, Uint8 mode)
+{
+  char magic[4];
+  FILE * file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+      memcmp(magic, fn_demo_magic, sizeof(magic)) != 0 ||
+      fgetc(file) != FN_DEMO_VERSION)
+  {
+    fprintf(stderr, "%s is not a valid demo file.\n", path);
+    fclose(file);
+    return NULL;
+  }
+
+  fn_demo_t * demo = malloc(sizeof(fn_demo_t));
+  memset(demo, 0, sizeof(fn_demo_t));
+  demo->file = file;
+  demo->mode = mode;
+
+  return demo;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_demo_free(fn_demo_t * demo)
+{
+  if (demo->file != NULL) {
+    fclose(demo->file); demo->file = NULL;
+  }
+  free(demo);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_get_mode(fn_demo_t * demo)
+{
+  return demo->mode;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_is_replaying(fn_demo_t * demo)
+{
+  return (demo->mode != FN_DEMO_MODE_RECORD);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_matches(fn_demo_t * demo)
+{
+  return !demo->differs;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_read_level(fn_demo_t * demo)
+{
+  int levelnumber = fgetc(demo->file);
+  if (levelnumber == EOF || levelnumber == 0) {
+    return 0;
+  }
+
+  demo->levelnumber = levelnumber;
+  demo->seed = fn_demo_read_uint32(demo->file);
+  demo->health = fgetc(demo->file);
+  demo->firepower = fgetc(demo->file);
+  demo->inventory = fgetc(demo->file);
+  demo->score = fn_demo_read_uint32(demo->file);
+  demo->score |= ((Uint64)fn_demo_read_uint32(demo->file)) << 32;
+
+  if (feof(demo->file)) {
+    return 0;
+  }
+
+  return demo->levelnumber;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_demo_start_level(fn_demo_t * demo,
+    Uint8 levelnumber,
+    fn_hero_t * hero,
+    Uint32 * seed)
+{
+  demo->run_input = 0;
+  demo->run_length = 0;
+  demo->exhausted = 0;
+  demo->ticks = 0;
+  demo->starttime = SDL_GetTicks();
+
+  if (fn_demo_is_replaying(demo)) {
+    *seed = demo->seed;
+    fn_hero_set_health(hero, demo->health);
+    fn_hero_set_firepower(hero, demo->firepower);
+    fn_hero_set_inventory(hero, demo->inventory);
+    hero->score = 0;
+    fn_hero_add_score(hero, demo->score);
+    return;
+  }
+
+  demo->levelnumber = levelnumber;
+  demo->seed = *seed;
+
+  fputc(levelnumber, demo->file);
+  fn_demo_write_uint32(demo->file, *seed);
+  fputc(fn_hero_get_health(hero), demo->file);
+  fputc(fn_hero_get_firepower(hero), demo->file);
+  fputc(fn_hero_get_inventory(hero), demo->file);
+  fn_demo_write_uint32(demo->file,
+      (Uint32)(fn_hero_get_score(hero) & 0xFFFFFFFF));
+  fn_demo_write_uint32(demo->file,
+      (Uint32)(fn_hero_get_score(hero) >> 32));
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read the next run of input of the replayed level.
+ *
+ * @param  demo  The demo.
+ *
+ * @return 1 if a run was read, 0 if the level has no more input.
+ */
+static Uint8 fn_demo_read_run(fn_demo_t * demo)
+{
+  int length = fgetc(demo->file);
+  int value = fgetc(demo->file);
+  if (length == EOF || length == 0 || value == EOF) {
+    /* the length byte 0 is the start of the chunk trailer,
+     * we give the value back to fn_demo_end_level. */
+    if (value != EOF) {
+      ungetc(value, demo->file);
+    }
+    demo->exhausted = 1;
+    return 0;
+  }
+  demo->run_length = length;
+  demo->run_input = value;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_tick(fn_demo_t * demo, Uint8 * input)
+{
+  if (!fn_demo_is_replaying(demo)) {
+    if (demo->run_length > 0 &&
+        (demo->run_input != *input || demo->run_length == 0xFF))
+    {
+      fn_demo_flush_run(demo);
+    }
+    demo->run_input = *input;
+    demo->run_length++;
+    demo->ticks++;
+    return 1;
+  }
+
+  if (demo->exhausted) {
+    return 0;
+  }
+
+  if (demo->run_length == 0 && !fn_demo_read_run(demo)) {
+    return 0;
+  }
+
+  *input = demo->run_input;
+  demo->run_length--;
+  demo->ticks++;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_demo_end_level(fn_demo_t * demo, fn_level_t * lv)
+{
+  Uint32 checksum = fn_demo_checksum(lv);
+  Uint32 duration = SDL_GetTicks() - demo->starttime;
+
+  if (!fn_demo_is_replaying(demo)) {
+    fn_demo_flush_run(demo);
+    fputc(0, demo->file);
+    fn_demo_write_uint32(demo->file, demo->ticks);
+    fn_demo_write_uint32(demo->file, checksum);
+    fflush(demo->file);
+    return 1;
+  }
+
+  /* skip the input the level did not consume, it is not counted
+   * in the ticks */
+  demo->run_length = 0;
+  while (!demo->exhausted && fn_demo_read_run(demo)) {
+    demo->run_length = 0;
+  }
+
+  Uint32 recorded_ticks = fn_demo_read_uint32(demo->file);
+  Uint32 recorded_checksum = fn_demo_read_uint32(demo->file);
+
+  Uint8 matches = (recorded_ticks == demo->ticks &&
+      recorded_checksum == checksum);
+
+  if (!matches) {
+    demo->differs = 1;
+  }
+
+  printf("Demo level %d: %u ticks in %u ms, %s.\n",
+      demo->levelnumber,
+      demo->ticks,
+      duration,
+      matches ? "state matches" : "STATE DIFFERS");
+
+  return matches;
+}
+
+/* --------------------------------------------------------------- */
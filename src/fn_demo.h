@@ -0,0 +1,214 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Demo recording and playback
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_DEMO_H
+#define FN_DEMO_H
+
+/* --------------------------------------------------------------- */
+
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+typedef struct fn_demo_t fn_demo_t;
+
+/* --------------------------------------------------------------- */
+
+#include "fn_hero.h"
+#include "fn_level.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The demo file format version written by this implementation.
+ */
+#define FN_DEMO_VERSION           3
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The demo is being recorded.
+ */
+#define FN_DEMO_MODE_RECORD       0
+/**
+ * The demo is played back with the normal game timer.
+ */
+#define FN_DEMO_MODE_REALTIME     1
+/**
+ * The demo is played back as fast as possible, drawing every frame.
+ */
+#define FN_DEMO_MODE_FASTFORWARD  2
+/**
+ * The demo is played back as fast as possible without drawing.
+ */
+#define FN_DEMO_MODE_HEADLESS     3
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Open a demo file for recording.
+ *
+ * A demo file consists of a file header followed by one chunk
+ * per played level. Each chunk stores the level number, the seed
+ * of the random number generator and the state of the hero when
+ * entering the level, followed by the run length encoded input
+ * state of every game tick (FNK_* bits), and is terminated by the
+ * number of ticks and a checksum of the simulation state at the
+ * end of the level.
+ *
+ * @param  path  The path of the file to write.
+ *
+ * @return The demo, or NULL if the file could not be created.
+ */
+fn_demo_t * fn_demo_open_record(char * path);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Open a demo file for playback.
+ *
+ * @param  path  The path of the file to read.
+ * @param  mode  The playback mode (FN_DEMO_MODE_REALTIME,
+ *               FN_DEMO_MODE_FASTFORWARD or FN_DEMO_MODE_HEADLESS).
+ *
+ * @return The demo, or NULL if the file could not be read or is
+ *         not a valid demo file.
+ */
+fn_demo_t * fn_demo_open_replay(char * path, Uint8 mode);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Close a demo file and free all its resources.
+ *
+ * @param  demo  The demo.
+ */
+void fn_demo_free(fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the mode of a demo.
+ *
+ * @param  demo  The demo.
+ *
+ * @return The mode (one of the FN_DEMO_MODE_* values).
+ */
+Uint8 fn_demo_get_mode(fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if a demo is being played back.
+ *
+ * @param  demo  The demo.
+ *
+ * @return 1 if the demo is played back, 0 if it is recorded.
+ */
+Uint8 fn_demo_is_replaying(fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if all levels replayed so far ended in the recorded state.
+ *
+ * @param  demo  The demo.
+ *
+ * @return 1 if no replayed level differed from the recording,
+ *         otherwise 0.
+ */
+Uint8 fn_demo_matches(fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read the header of the next level chunk of a replayed demo.
+ *
+ * @param  demo  The demo.
+ *
+ * @return The number of the level to play, or 0 if the demo
+ *         contains no more levels.
+ */
+Uint8 fn_demo_read_level(fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Start a level inside the demo.
+ *
+ * When recording, the chunk header is written from the passed
+ * values. When replaying, the hero state and the seed are set
+ * to the values stored in the chunk that was read by
+ * fn_demo_read_level.
+ *
+ * @param  demo         The demo.
+ * @param  levelnumber  The number of the level.
+ * @param  hero         The hero.
+ * @param  seed         The seed for the random number generator.
+ */
+void fn_demo_start_level(fn_demo_t * demo,
+    Uint8 levelnumber,
+    fn_hero_t * hero,
+    Uint32 * seed);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Process the input of one game tick.
+ *
+ * When recording, the input is appended to the demo. When
+ * replaying, the input is replaced by the recorded one.
+ *
+ * @param  demo   The demo.
+ * @param  input  The input state of the tick (FNK_* bits).
+ *
+ * @return 1 if the tick was processed, 0 if the recorded input
+ *         of the level is exhausted.
+ */
+Uint8 fn_demo_tick(fn_demo_t * demo, Uint8 * input);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Finish a level inside the demo.
+ *
+ * When recording, the chunk trailer is written. When replaying,
+ * the simulation state is compared with the recorded one and the
+ * result is printed together with the time the level took.
+ *
+ * @param  demo  The demo.
+ * @param  lv    The level that was played.
+ *
+ * @return 1 if the simulation state matches the recording (or
+ *         the demo is recorded), 0 if it differs.
+ */
+Uint8 fn_demo_end_level(fn_demo_t * demo, fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_DEMO_H */
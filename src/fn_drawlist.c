@@ -0,0 +1,412 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Recorded blits rendered in horizontal bands
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_drawlist.h"
+#include "fn_blit.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A recorded blit, already clipped against the target.
+ */
+typedef struct fn_drawlist_entry_t {
+  /**
+   * The source surface, whose reference count was increased.
+   */
+  SDL_Surface * src;
+
+  /**
+   * The part of the source which is drawn.
+   */
+  SDL_Rect area;
+
+  /**
+   * The position on the target.
+   */
+  Sint16 x;
+  Sint16 y;
+} fn_drawlist_entry_t;
+
+/* --------------------------------------------------------------- */
+
+struct fn_drawlist_t {
+  /**
+   * The surface which is drawn to.
+   */
+  SDL_Surface * target;
+
+  /**
+   * The recorded blits. The array only grows, so recording a
+   * frame does not allocate memory once it is large enough.
+   */
+  fn_drawlist_entry_t * entries;
+  size_t num_entries;
+  size_t max_entries;
+
+  /**
+   * Non-zero if a blit needs SDL.
+   */
+  Uint8 needs_sdl;
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The threads which help rendering, and the draw list they work on.
+ */
+typedef struct fn_drawlist_pool_t {
+  SDL_Thread * threads[FN_DRAWLIST_MAX_THREADS];
+
+  /**
+   * The number of threads, including the one rendering. Zero
+   * before any were set, which means one.
+   */
+  Uint8 num_threads;
+
+  /**
+   * Posted once per helper when there is work, or when they quit.
+   */
+  SDL_sem * start;
+
+  /**
+   * Posted by every helper when it is done.
+   */
+  SDL_sem * done;
+
+  /**
+   * Protects next_band.
+   */
+  SDL_mutex * mutex;
+
+  fn_drawlist_t * dl;
+  Uint8 num_bands;
+  Uint8 next_band;
+  int top;
+  int height;
+  Uint8 quit;
+} fn_drawlist_pool_t;
+
+static fn_drawlist_pool_t fn_drawlist_pool;
+
+/* --------------------------------------------------------------- */
+
+fn_drawlist_t * fn_drawlist_create(void)
+{
+  fn_drawlist_t * dl = malloc(sizeof(fn_drawlist_t));
+  memset(dl, 0, sizeof(fn_drawlist_t));
+  return dl;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_drawlist_clear(fn_drawlist_t * dl)
+{
+  size_t i = 0;
+  for (i = 0; i < dl->num_entries; i++) {
+    SDL_FreeSurface(dl->entries[i].src);
+  }
+  dl->num_entries = 0;
+  dl->needs_sdl = 0;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_drawlist_free(fn_drawlist_t * dl)
+{
+  fn_drawlist_clear(dl);
+  free(dl->entries);
+  free(dl);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_drawlist_begin(fn_drawlist_t * dl, SDL_Surface * target)
+{
+  fn_drawlist_clear(dl);
+  dl->target = target;
+}
+
+/* --------------------------------------------------------------- */
+
+SDL_Surface * fn_drawlist_get_target(fn_drawlist_t * dl)
+{
+  return dl->target;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_drawlist_blit(fn_drawlist_t * dl,
+    SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * dstrect)
+{
+  SDL_Rect fulldst;
+  SDL_Rect area;
+
+  if (dstrect == NULL) {
+    fulldst.x = 0;
+    fulldst.y = 0;
+    dstrect = &fulldst;
+  }
+  if (!fn_blit_clip(src, srcrect, &(dl->target->clip_rect),
+        dstrect, &area))
+  {
+    return;
+  }
+
+  if (dl->num_entries == dl->max_entries) {
+    size_t max = (dl->max_entries == 0) ? 64 : dl->max_entries * 2;
+    fn_drawlist_entry_t * entries =
+      realloc(dl->entries, max * sizeof(fn_drawlist_entry_t));
+    if (entries == NULL) {
+      return;
+    }
+    dl->entries = entries;
+    dl->max_entries = max;
+  }
+
+  fn_drawlist_entry_t * entry = &(dl->entries[dl->num_entries]);
+  entry->src = src;
+  entry->area = area;
+  entry->x = dstrect->x;
+  entry->y = dstrect->y;
+  src->refcount++;
+  dl->num_entries++;
+
+  if (!fn_blit_can_copy(src, dl->target)) {
+    dl->needs_sdl = 1;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Do the recorded blits inside the rows from top to bottom.
+ */
+static void fn_drawlist_render_rows(fn_drawlist_t * dl,
+    int top,
+    int bottom)
+{
+  size_t i = 0;
+  for (i = 0; i < dl->num_entries; i++) {
+    fn_drawlist_entry_t * entry = &(dl->entries[i]);
+    SDL_Rect area = entry->area;
+    int y = entry->y;
+    /* the fields of SDL_Rect are too small to get negative */
+    int h = area.h;
+
+    if (y < top) {
+      h -= top - y;
+      area.y += top - y;
+      y = top;
+    }
+    if (y + h > bottom) {
+      h = bottom - y;
+    }
+    if (h > 0) {
+      area.h = h;
+      fn_blit_copy(entry->src, &area, dl->target, entry->x, y);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Render the bands of the pool which are not taken yet.
+ */
+static void fn_drawlist_render_bands(fn_drawlist_pool_t * pool)
+{
+  while (1) {
+    Uint8 band = 0;
+
+    SDL_LockMutex(pool->mutex);
+    band = pool->next_band;
+    if (pool->next_band < pool->num_bands) {
+      pool->next_band++;
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    if (band >= pool->num_bands) {
+      return;
+    }
+
+    int top = pool->top + pool->height * band / pool->num_bands;
+    int bottom = pool->top + pool->height * (band + 1) / pool->num_bands;
+    if (band == 0) {
+      top = 0;
+    }
+    if (band == pool->num_bands - 1) {
+      bottom = pool->dl->target->h;
+    }
+    fn_drawlist_render_rows(pool->dl, top, bottom);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_drawlist_thread(void * data)
+{
+  fn_drawlist_pool_t * pool = data;
+
+  while (1) {
+    SDL_SemWait(pool->start);
+    if (pool->quit) {
+      return 0;
+    }
+    fn_drawlist_render_bands(pool);
+    SDL_SemPost(pool->done);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_drawlist_render(fn_drawlist_t * dl, SDL_Rect * area)
+{
+  fn_drawlist_pool_t * pool = &fn_drawlist_pool;
+  SDL_Surface * target = dl->target;
+  size_t i = 0;
+  Uint8 t = 0;
+
+  if (dl->needs_sdl) {
+    for (i = 0; i < dl->num_entries; i++) {
+      fn_drawlist_entry_t * entry = &(dl->entries[i]);
+      SDL_Rect dstrect;
+      dstrect.x = entry->x;
+      dstrect.y = entry->y;
+      SDL_BlitSurface(entry->src, &(entry->area), target, &dstrect);
+    }
+  } else if (pool->num_threads <= 1 || dl->num_entries == 0) {
+    fn_drawlist_render_rows(dl, 0, target->h);
+  } else {
+    /* choose the blitter here, not in the helpers at the same time */
+    fn_blit_get_impl();
+
+    pool->dl = dl;
+    pool->num_bands = pool->num_threads;
+    pool->next_band = 0;
+    pool->top = (area != NULL) ? area->y : 0;
+    pool->height = (area != NULL) ? area->h : target->h;
+
+    for (t = 1; t < pool->num_threads; t++) {
+      SDL_SemPost(pool->start);
+    }
+    fn_drawlist_render_bands(pool);
+    for (t = 1; t < pool->num_threads; t++) {
+      SDL_SemWait(pool->done);
+    }
+    pool->dl = NULL;
+  }
+
+  fn_drawlist_clear(dl);
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_drawlist_stop_threads(void)
+{
+  fn_drawlist_pool_t * pool = &fn_drawlist_pool;
+  Uint8 t = 0;
+
+  if (pool->num_threads <= 1) {
+    return;
+  }
+  pool->quit = 1;
+  for (t = 1; t < pool->num_threads; t++) {
+    SDL_SemPost(pool->start);
+  }
+  for (t = 1; t < pool->num_threads; t++) {
+    if (pool->threads[t] != NULL) {
+      SDL_WaitThread(pool->threads[t], NULL);
+      pool->threads[t] = NULL;
+    }
+  }
+  SDL_DestroySemaphore(pool->start);
+  SDL_DestroySemaphore(pool->done);
+  SDL_DestroyMutex(pool->mutex);
+  pool->quit = 0;
+  pool->num_threads = 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_drawlist_get_threads(void)
+{
+  if (fn_drawlist_pool.num_threads == 0) {
+    return 1;
+  }
+  return fn_drawlist_pool.num_threads;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_drawlist_set_threads(Uint8 threads)
+{
+  static Uint8 registered = 0;
+  fn_drawlist_pool_t * pool = &fn_drawlist_pool;
+  Uint8 t = 0;
+
+  if (threads < 1) {
+    threads = 1;
+  }
+  if (threads > FN_DRAWLIST_MAX_THREADS) {
+    threads = FN_DRAWLIST_MAX_THREADS;
+  }
+  if (threads == fn_drawlist_get_threads()) {
+    return;
+  }
+
+  fn_drawlist_stop_threads();
+  if (threads == 1) {
+    return;
+  }
+  if (!registered) {
+    atexit(fn_drawlist_stop_threads);
+    registered = 1;
+  }
+
+  pool->start = SDL_CreateSemaphore(0);
+  pool->done = SDL_CreateSemaphore(0);
+  pool->mutex = SDL_CreateMutex();
+  pool->num_threads = threads;
+  for (t = 1; t < threads; t++) {
+    pool->threads[t] = SDL_CreateThread(fn_drawlist_thread, pool);
+    if (pool->threads[t] == NULL) {
+      /* render with the threads we got */
+      pool->num_threads = t;
+      break;
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,151 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Recorded blits rendered in horizontal bands
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_DRAWLIST_H
+#define FN_DRAWLIST_H
+
+/* --------------------------------------------------------------- */
+
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The maximum number of threads rendering a draw list.
+ */
+#define FN_DRAWLIST_MAX_THREADS 16
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The blits onto one surface in the order they were done, so they
+ * can be rendered later, split into bands of rows which are drawn
+ * in parallel.
+ */
+typedef struct fn_drawlist_t fn_drawlist_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create an empty draw list.
+ *
+ * @return The draw list.
+ */
+fn_drawlist_t * fn_drawlist_create(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a draw list.
+ *
+ * @param  dl  The draw list.
+ */
+void fn_drawlist_free(fn_drawlist_t * dl);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Start recording the blits onto a surface. Blits which were
+ * recorded before and not rendered are dropped.
+ *
+ * @param  dl      The draw list.
+ * @param  target  The surface which is drawn to.
+ */
+void fn_drawlist_begin(fn_drawlist_t * dl, SDL_Surface * target);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the surface a draw list records the blits for.
+ *
+ * @param  dl  The draw list.
+ *
+ * @return The surface.
+ */
+SDL_Surface * fn_drawlist_get_target(fn_drawlist_t * dl);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Record a blit instead of doing it. The rectangles are used and
+ * changed like SDL_BlitSurface does it. The source is kept until
+ * the draw list is rendered, even if it is freed in between.
+ *
+ * @param  dl       The draw list.
+ * @param  src      The source surface.
+ * @param  srcrect  The part of the source to blit, or NULL for all.
+ * @param  dstrect  The position on the target, or NULL for the top
+ *                  left corner. Set to the blitted area.
+ */
+void fn_drawlist_blit(fn_drawlist_t * dl,
+    SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * dstrect);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Do the recorded blits and empty the draw list. The rows of an
+ * area are split into one band per thread; the first band also
+ * gets the rows above it and the last one the rows below it, so
+ * every blit is drawn completely. Every band does the blits in the
+ * recorded order, so the result is the same as without bands.
+ *
+ * If a blit can not be done without SDL, all of them are done by
+ * SDL one after the other.
+ *
+ * @param  dl    The draw list.
+ * @param  area  The area whose rows are split, or NULL for the
+ *               whole target.
+ */
+void fn_drawlist_render(fn_drawlist_t * dl, SDL_Rect * area);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Set the number of threads rendering draw lists, including the
+ * one calling fn_drawlist_render. The others are started here and
+ * wait for work.
+ *
+ * @param  threads  The number of threads, 1 renders without
+ *                  bands.
+ */
+void fn_drawlist_set_threads(Uint8 threads);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the number of threads rendering draw lists.
+ *
+ * @return The number of threads.
+ */
+Uint8 fn_drawlist_get_threads(void);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_DRAWLIST_H */
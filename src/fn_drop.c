@@ -56,6 +56,7 @@ FnTexture * fn_drop_load(int fd, fn_environment_t * env)
       FN_DROP_WIDTH * FN_TILE_WIDTH,
       FN_DROP_HEIGHT * FN_TILE_HEIGHT,
       graphic_options);
+  fn_texture_set_category(drop, FN_TEXTURE_CATEGORY_BACKDROP);
 
   size_t num_loads = FN_DROP_WIDTH *  FN_DROP_HEIGHT;
 
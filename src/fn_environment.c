@@ -117,6 +117,7 @@ TTF_Font * fn_environment_loadfont(fontsize)
 char const * const subpath_config = "/.freenukum";
 char const * const subpath_data = "/data";
 char const * const subpath_configfile = "/config";
+char const * const subpath_savefile = "/quicksave";
 
 /* --------------------------------------------------------------- */
 
@@ -133,13 +134,16 @@ fn_environment_t * fn_environment_create()
   env->draw_collision_bounds = 0;
   env->configfilepath = NULL;
   env->datapath = NULL;
+  env->savefilepath = NULL;
   env->settings = NULL;
   env->screen = NULL;
   env->tilecache = NULL;
+  env->textcache = fn_textcache_create(FN_TEXTCACHE_BYTES);
   env->episode = 1;
   env->num_episodes = 0;
   env->hero = fn_hero_create(env);
   env->graphics = NULL;
+  env->demo = NULL;
 
   /* create all the path variables */
   char * homepath = getenv("HOME");
@@ -172,6 +176,14 @@ fn_environment_t * fn_environment_create()
   snprintf(env->datapath, datapath_size, "%s%s",
       configpath, subpath_data);
 
+  size_t savefilepath_size =
+    strlen(configpath) +
+    strlen(subpath_savefile) +
+    2;
+  env->savefilepath = malloc(savefilepath_size);
+  snprintf(env->savefilepath, savefilepath_size, "%s%s",
+      configpath, subpath_savefile);
+
   /* check if the paths exist and create them if necessary */
   DIR * configdir = opendir(configpath);
   if (configdir == NULL) {
@@ -235,10 +247,18 @@ fn_environment_t * fn_environment_create()
     g_printerr("Can't initialize graphics.\n");
   }
 
+  /* 8 bit textures with the EGA palette of the original game */
+  unsigned char indexed = 0;
+  fn_settings_get_bool_with_default(env->settings,
+      "indexed",
+      &indexed, FN_DEFAULT_INDEXED);
+
   env->graphic_options =
     fn_graphic_options_new_with_defaults();
+  g_object_set(env->graphic_options, "indexed", (gboolean)indexed, NULL);
 
   env->screen = fn_graphics_get_screen(env->graphics);
+  fn_screen_set_indexed(env->screen, indexed);
 
   SDL_WM_SetCaption("Freenukum " VERSION, "Freenukum " VERSION);
 
@@ -259,9 +279,15 @@ void fn_environment_delete(fn_environment_t * env)
   if (env->datapath != NULL) {
     free(env->datapath); env->datapath = NULL;
   }
+  if (env->savefilepath != NULL) {
+    free(env->savefilepath); env->savefilepath = NULL;
+  }
   if (env->tilecache != NULL) {
     fn_tilecache_destroy(env->tilecache); env->tilecache = NULL;
   }
+  if (env->textcache != NULL) {
+    fn_textcache_free(env->textcache); env->textcache = NULL;
+  }
   if (env->screen != NULL) {
     g_object_unref(env->screen); env->screen = NULL;
   }
@@ -272,6 +298,7 @@ void fn_environment_delete(fn_environment_t * env)
   if (env->graphics != NULL) {
     g_object_unref(env->graphics); env->graphics = NULL;
   }
+  fn_texture_clear_pool();
 
   free(env);
 }
@@ -416,6 +443,8 @@ Uint8 fn_environment_check_for_episodes(fn_environment_t * env)
 
 Uint8 fn_environment_load_tilecache(fn_environment_t * env)
 {
+  /* the cached texts were rendered with the old font */
+  fn_textcache_clear(env->textcache);
   env->tilecache = fn_tilecache_create();
   return fn_tilecache_loadtiles(env->tilecache, env);
 }
@@ -568,6 +597,13 @@ char * fn_environment_get_datapath(fn_environment_t * env)
 
 /* --------------------------------------------------------------- */
 
+char * fn_environment_get_savefilepath(fn_environment_t * env)
+{
+  return env->savefilepath;
+}
+
+/* --------------------------------------------------------------- */
+
 fn_tilecache_t * fn_environment_get_tilecache(fn_environment_t * env)
 {
   return env->tilecache;
@@ -575,6 +611,13 @@ fn_tilecache_t * fn_environment_get_tilecache(fn_environment_t * env)
 
 /* --------------------------------------------------------------- */
 
+fn_textcache_t * fn_environment_get_textcache(fn_environment_t * env)
+{
+  return env->textcache;
+}
+
+/* --------------------------------------------------------------- */
+
 Uint8 fn_environment_tilecache_loaded(fn_environment_t * env)
 {
   return (env->tilecache != NULL);
@@ -610,3 +653,18 @@ fn_hero_t * fn_environment_get_hero(fn_environment_t * env)
 
 /* --------------------------------------------------------------- */
 
+fn_demo_t * fn_environment_get_demo(fn_environment_t * env)
+{
+  return env->demo;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_environment_set_demo(fn_environment_t * env,
+    fn_demo_t * demo)
+{
+  env->demo = demo;
+}
+
+/* --------------------------------------------------------------- */
+
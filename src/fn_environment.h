@@ -44,8 +44,10 @@ typedef struct fn_environment_t fn_environment_t;
 #include "fngraphics.h"
 #include "fn_settings.h"
 #include "fn_tilecache.h"
+#include "fn_textcache.h"
 #include "fn_hero.h"
 #include "fntexture.h"
+#include "fn_demo.h"
 
 /* --------------------------------------------------------------- */
 
@@ -90,6 +92,11 @@ struct fn_environment_t {
    */
   char * datapath;
 
+  /**
+   * The path where the quicksave snapshot is stored.
+   */
+  char * savefilepath;
+
   /**
    * The game settings.
    */
@@ -105,6 +112,12 @@ struct fn_environment_t {
    */
   fn_tilecache_t * tilecache;
 
+  /**
+   * The texts and message boxes rendered with the tiles of the
+   * tilecache, and the decoded splash pictures.
+   */
+  fn_textcache_t * textcache;
+
   /**
    * The episode number.
    */
@@ -129,6 +142,12 @@ struct fn_environment_t {
    * The graphic options.
    */
   FnGraphicOptions * graphic_options;
+
+  /**
+   * The demo that is currently recorded or played back.
+   * This is NULL if no demo is active.
+   */
+  fn_demo_t * demo;
 };
 
 /* --------------------------------------------------------------- */
@@ -371,10 +390,32 @@ char * fn_environment_get_datapath(fn_environment_t * env);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Get the path of the quicksave file.
+ *
+ * @param  env  The environment.
+ *
+ * @return The path of the quicksave file.
+ */
+char * fn_environment_get_savefilepath(fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
 fn_tilecache_t * fn_environment_get_tilecache(fn_environment_t * env);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Get the cache of rendered texts, message boxes and pictures.
+ *
+ * @param  env  The environment.
+ *
+ * @return The text cache.
+ */
+fn_textcache_t * fn_environment_get_textcache(fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
 Uint8 fn_environment_tilecache_loaded(fn_environment_t * env);
 
 /* --------------------------------------------------------------- */
@@ -397,4 +438,27 @@ fn_hero_t * fn_environment_get_hero(fn_environment_t * env);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Get the demo that is currently recorded or played back.
+ *
+ * @param  env  The environment.
+ *
+ * @return The demo, or NULL if no demo is active.
+ */
+fn_demo_t * fn_environment_get_demo(fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Set the demo that is recorded or played back. The environment
+ * does not take ownership of the demo.
+ *
+ * @param  env   The environment.
+ * @param  demo  The demo, or NULL to stop using a demo.
+ */
+void fn_environment_set_demo(fn_environment_t * env,
+    fn_demo_t * demo);
+
+/* --------------------------------------------------------------- */
+
 #endif /* FN_ENVIRONMENT_H */
@@ -42,6 +42,17 @@
 #include "fn_infobox.h"
 #include "fn_level.h"
 #include "fn_drop.h"
+#include "fn_demo.h"
+#include "fn_snapshot.h"
+#include "fn_rewind.h"
+#include "fn_profile.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The largest scale F7 cycles through on a native screen.
+ */
+#define FN_GAME_MAX_SCALE 4
 
 /* --------------------------------------------------------------- */
 
@@ -60,14 +71,126 @@ Uint32 fn_game_timer_triggered(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Draw the borders and the status display around the level window.
+ *
+ * @param  env  The environment.
+ */
+static void fn_game_blit_borders(
+    fn_environment_t * env)
+{
+  SDL_Surface * screen = fn_environment_get_screen_sdl(env);
+  SDL_FillRect(screen, NULL, 0);
+
+  fn_borders_blit(env);
+
+  fn_borders_blit_life(env);
+
+  fn_borders_blit_score(env);
+
+  fn_borders_blit_firepower(env);
+
+  fn_borders_blit_inventory(env);
+
+  SDL_UpdateRect(screen, 0, 0, 0, 0);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Play a level.
+ *
+ * @param  levelnumber  The level number (must be between 1 and 12).
+ * @param  sequence     The number of the last regular level that
+ *                      was played, stored in quicksaves.
+ * @param  snapshot     The snapshot from which the level state is
+ *                      restored, or NULL to start the level from
+ *                      the beginning.
+ * @param  env          The environment.
+ *
+ * @return Non-zero if the level was completed successfully, else zero.
+ */
+static int fn_game_play_level(
+    int levelnumber,
+    int sequence,
+    fn_snapshot_t * snapshot,
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Play the levels of an episode in their order, with the
+ * interlevel between them.
+ *
+ * @param  env         The environment.
+ * @param  level       The regular level to start with.
+ * @param  interlevel  If non-zero, the interlevel following
+ *                     the regular level is played first.
+ * @param  snapshot    The snapshot from which the first level is
+ *                     restored, or NULL.
+ *
+ * @return Non-zero if all levels were completed, else zero.
+ */
+static int fn_game_play_sequence(
+    fn_environment_t * env,
+    int level,
+    int interlevel,
+    fn_snapshot_t * snapshot)
+{
+  int success = 1;
+
+  while (success && level < 13) {
+    if (interlevel) {
+      /* interlevel */
+      success = fn_game_play_level(2, level,
+          snapshot, env);
+      level++;
+      if (level == 2) {
+        level++;
+      }
+      interlevel = 0;
+    } else {
+      /* real level */
+      success = fn_game_play_level(level, level,
+          snapshot, env);
+      interlevel = 1;
+    }
+    snapshot = NULL;
+  }
+
+  return success;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Bring the hero and the screen up to date after the state of the
+ * level was restored from a snapshot.
+ *
+ * @param  env   The environment.
+ * @param  hero  The hero.
+ */
+static void fn_game_restored(
+    fn_environment_t * env,
+    fn_hero_t * hero)
+{
+  /* the keys held at the time of the snapshot are not held now */
+  fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+  fn_hero_fire_stop(hero);
+  fn_hero_update_animation(hero);
+
+  fn_hero_post_event(hero, fn_event_heromoved);
+
+  fn_game_blit_borders(env);
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_game_start(
     fn_environment_t * env)
 {
   int res;
 
-  /* Initialize Random Number Generator. */
-  srand(time(NULL));
-
   char * msg1 =
     "So you're the pitiful\n"
     "hero they sent to stop\n"
@@ -102,47 +225,16 @@ void fn_game_start(
   fn_hero_t * hero = fn_environment_get_hero(env);
   fn_hero_reset(hero);
 
-  SDL_Surface * screen = fn_environment_get_screen_sdl(env);
-  SDL_FillRect(screen, NULL, 0);
-
-  fn_borders_blit(env);
-
-  fn_borders_blit_life(env);
-
-  fn_borders_blit_score(env);
-
-  fn_borders_blit_firepower(env);
-
-  fn_borders_blit_inventory(env);
-
-  SDL_UpdateRect(screen, 0, 0, 0, 0);
+  fn_game_blit_borders(env);
 
   { /* start the game itself */
 
-    int level = 1;
-    int interlevel = 0;
     int success = 1;
 
     fn_infobox_show(env,
         "Get ready FreeNukum,\nyou are going in.\n");
 
-    while (success && level < 13) {
-      if (interlevel) {
-        /* interlevel */
-        success = fn_game_start_in_level(2,
-            env);
-        level++;
-        if (level == 2) {
-          level++;
-        }
-        interlevel = 0;
-      } else {
-        /* real level */
-        success = fn_game_start_in_level(level,
-            env);
-        interlevel = 1;
-      }
-    }
+    success = fn_game_play_sequence(env, 1, 0, NULL);
 
     if (success) {
       /* the player finished, so we show the end sequence */
@@ -152,9 +244,95 @@ void fn_game_start(
 
 }
 
+/* --------------------------------------------------------------- */
+
+int fn_game_replay_demo(
+    fn_environment_t * env,
+    char * path,
+    Uint8 mode)
+{
+  int success = 1;
+  Uint8 levelnumber = 0;
+
+  fn_demo_t * demo = fn_demo_open_replay(path, mode);
+  if (demo == NULL) {
+    return 0;
+  }
+
+  fn_hero_t * hero = fn_environment_get_hero(env);
+  fn_hero_reset(hero);
+
+  fn_game_blit_borders(env);
+
+  fn_environment_set_demo(env, demo);
+
+  levelnumber = fn_demo_read_level(demo);
+  while (success && levelnumber != 0) {
+    success = fn_game_start_in_level(levelnumber, env);
+    levelnumber = fn_demo_read_level(demo);
+  }
+
+  /* the levels may be lost in the demo, only a replay that differs
+   * from the recording fails */
+  success = fn_demo_matches(demo);
+
+  fn_environment_set_demo(env, NULL);
+  fn_demo_free(demo);
+
+  return success;
+}
+
+/* --------------------------------------------------------------- */
+
+int fn_game_restore(
+    fn_environment_t * env,
+    char * path)
+{
+  Uint8 episode = 0;
+  Uint8 levelnumber = 0;
+  Uint8 sequence = 0;
+
+  fn_snapshot_t * snapshot = fn_snapshot_load(path);
+  if (snapshot == NULL) {
+    return 0;
+  }
+
+  if (!fn_snapshot_get_level(snapshot,
+        &episode, &levelnumber, &sequence) ||
+      episode != fn_environment_get_episode(env))
+  {
+    fn_snapshot_free(snapshot);
+    return 0;
+  }
+
+  fn_hero_t * hero = fn_environment_get_hero(env);
+  fn_hero_reset(hero);
+
+  fn_game_blit_borders(env);
+
+  fn_game_play_sequence(env, sequence, (levelnumber == 2), snapshot);
+
+  fn_snapshot_free(snapshot);
+
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
 int fn_game_start_in_level(
     int levelnumber,
     fn_environment_t * env)
+{
+  return fn_game_play_level(levelnumber, levelnumber, NULL, env);
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_game_play_level(
+    int levelnumber,
+    int sequence,
+    fn_snapshot_t * snapshot,
+    fn_environment_t * env)
 {
   int returnvalue = 0;
   int fd = 0;
@@ -165,14 +343,29 @@ int fn_game_start_in_level(
   int res = 0;
   int doupdate = 1;
 
+  fn_demo_t * demo = fn_environment_get_demo(env);
+  Uint8 replaying = (demo != NULL && fn_demo_is_replaying(demo));
+  Uint8 headless = (replaying &&
+      fn_demo_get_mode(demo) == FN_DEMO_MODE_HEADLESS);
+  Uint8 realtime = (!replaying ||
+      fn_demo_get_mode(demo) == FN_DEMO_MODE_REALTIME);
+
   fn_hero_t * hero = fn_environment_get_hero(env);
 
+  /* the quicksave of this level */
+  fn_snapshot_t * quicksave = NULL;
+
+  /* the states of the last ticks, for going back in time */
+  fn_rewind_t * rewind = NULL;
+  Uint8 rewinding = 0;
+
   FnGraphicOptions * graphic_options =
     fn_environment_get_graphic_options(env);
   FnTexture * level = fn_texture_new_with_options(
       FN_TILE_WIDTH * FN_LEVEL_WIDTH,
       FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
       graphic_options);
+  fn_texture_set_category(level, FN_TEXTURE_CATEGORY_LEVEL);
 
   FnTexture * backdrop = NULL;;
   SDL_TimerID tick = 0;
@@ -258,6 +451,23 @@ int fn_game_start_in_level(
   }
   close(fd);
 
+  {
+    Uint32 seed = time(NULL);
+    if (demo != NULL) {
+      fn_demo_start_level(demo, levelnumber, hero, &seed);
+    }
+    fn_level_set_seed(lv, seed);
+  }
+
+  if (snapshot != NULL && !fn_snapshot_restore_level(snapshot, lv)) {
+    fprintf(stderr, "Could not restore level %d, starting it anew\n",
+        levelnumber);
+  }
+
+  /* no key is held when we enter the level */
+  fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+  fn_hero_fire_stop(hero);
+
   dstrect = fn_geometry_new(
       FN_TILE_WIDTH,
       FN_TILE_HEIGHT,
@@ -283,19 +493,26 @@ int fn_game_start_in_level(
       FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH,
       FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT);
 
-  tick = SDL_AddTimer(80, fn_game_timer_triggered, 0);
+  if (demo == NULL) {
+    rewind = fn_rewind_create(FN_REWIND_CAPACITY, FN_REWIND_ENTRIES);
+    fn_rewind_record(rewind, lv, levelnumber, sequence);
+  }
 
-  {
-    /* make the first frame appear */
-    SDL_Event event;
-    event.type = SDL_USEREVENT;
-    event.user.code = fn_event_heromoved;
-    event.user.data1 = hero;
-    event.user.data2 = 0;
-    SDL_PushEvent(&event);
+  if (realtime) {
+    tick = SDL_AddTimer(FN_REWIND_TICK_DURATION,
+        fn_game_timer_triggered, 0);
   }
 
-  Uint8 directions = 0;
+  /* make the first frame appear */
+  fn_hero_post_event(hero, fn_event_heromoved);
+
+  /* The input (FNK_* bits) is sampled once every tick so that
+   * a recorded demo plays back exactly like it was played.
+   * Keys pressed and released between two ticks are latched
+   * until the next tick. */
+  Uint8 input = 0;
+  Uint8 latched = 0;
+  Uint8 applied = 0;
 
   int updateWholeScreen = 1;
 
@@ -305,7 +522,23 @@ int fn_game_start_in_level(
   /* The mainloop of the level */
   while (fn_level_keep_on_playing(lv))
   {
-    if (doupdate) {
+    {
+      /* hand the events of the hero over to the event queue */
+      Uint8 heroevents = fn_hero_take_events(hero);
+      int code = 0;
+      for (code = 0; heroevents != 0; code++) {
+        if (heroevents & (1 << code)) {
+          event.type = SDL_USEREVENT;
+          event.user.code = code;
+          event.user.data1 = hero;
+          event.user.data2 = 0;
+          SDL_PushEvent(&event);
+          heroevents &= ~(1 << code);
+        }
+      }
+    }
+
+    if (doupdate && !headless) {
       fn_level_blit_to_texture(
           lv,
           level,
@@ -313,18 +546,61 @@ int fn_game_start_in_level(
           srcrect,
           backdrop,
           NULL);
+      if (fn_profile_overlay_shown()) {
+        FnRect overlayrect = {
+          fn_geometry_get_x(srcrect) + FN_HALFTILE_WIDTH,
+          fn_geometry_get_y(srcrect) + FN_HALFTILE_HEIGHT,
+          0, 0
+        };
+        fn_profile_draw_overlay(level, &overlayrect, env);
+      }
+      FN_PROFILE_BEGIN(FN_PROFILE_CLONE);
       fn_screen_clone_texture(screen, dstrect, level, srcrect);
+      FN_PROFILE_END(FN_PROFILE_CLONE);
+      FN_PROFILE_BEGIN(FN_PROFILE_PRESENT);
+      if (updateWholeScreen) {
+        fn_screen_update(screen);
+        updateWholeScreen = 0;
+      } else {
+        /* the status display marks its own changes */
+        FnRect levelrect;
+        fn_geometry_get_rect(dstrect, &levelrect);
+        fn_screen_mark_dirty(screen, &levelrect);
+        fn_screen_update_dirty(screen);
+      }
+      FN_PROFILE_END(FN_PROFILE_PRESENT);
+      FN_PROFILE_FRAME_DONE();
 
       doupdate = 0;
     }
 
-    res = SDL_WaitEvent(&event);
+    if (realtime) {
+      res = SDL_WaitEvent(&event);
+    } else {
+      res = SDL_PollEvent(&event);
+      if (res == 0) {
+        /* nothing left to do, so we go on with the next tick */
+        event.type = SDL_USEREVENT;
+        event.user.code = fn_event_timer;
+        event.user.data1 = 0;
+        event.user.data2 = 0;
+        res = 1;
+      }
+    }
     if (res == 1) {
+      FN_PROFILE_BEGIN(FN_PROFILE_EVENTS);
       switch(event.type) {
         case SDL_QUIT:
           goto cleanup;
           break;
         case SDL_KEYDOWN:
+          if (demo != NULL &&
+              event.key.keysym.sym >= SDLK_0 &&
+              event.key.keysym.sym <= SDLK_9)
+          {
+            /* cheats are not part of the demo */
+            break;
+          }
           switch(event.key.keysym.sym) {
             case SDLK_q:
             case SDLK_ESCAPE:
@@ -382,6 +658,81 @@ int fn_game_start_in_level(
             case SDLK_f:
               fn_environment_toggle_fullscreen(env);
               break;
+            case SDLK_F3:
+              fn_profile_toggle_overlay();
+              doupdate = 1;
+              break;
+            case SDLK_F7:
+              /* only a native screen scales without reloading */
+              if (fn_screen_is_native(screen)) {
+                fn_screen_set_scale(screen,
+                    fn_screen_get_scale(screen) % FN_GAME_MAX_SCALE + 1);
+                fn_screen_update(screen);
+              }
+              break;
+            case SDLK_F8:
+              if (fn_screen_is_native(screen)) {
+                fn_screen_set_filter(screen,
+                    (fn_screen_get_filter(screen) + 1) %
+                    FN_SCALE_NUM_FILTERS);
+                fn_screen_update(screen);
+              }
+              break;
+            case SDLK_F5:
+              if (demo != NULL) {
+                /* a demo only contains the input */
+                break;
+              }
+              if (quicksave == NULL) {
+                quicksave = fn_snapshot_create();
+              }
+              fn_snapshot_save_level(quicksave, lv, levelnumber, sequence);
+              if (!fn_snapshot_store(quicksave,
+                    fn_environment_get_savefilepath(env)))
+              {
+                fprintf(stderr, "Could not store the quicksave in %s\n",
+                    fn_environment_get_savefilepath(env));
+              }
+              break;
+            case SDLK_BACKSPACE:
+              rewinding = 1;
+              break;
+            case SDLK_F9:
+              if (demo != NULL) {
+                break;
+              }
+              {
+                Uint8 restored = 0;
+                if (quicksave != NULL) {
+                  restored = fn_snapshot_restore_level(quicksave, lv);
+                } else {
+                  /* there might be a quicksave from an earlier game */
+                  fn_snapshot_t * stored = fn_snapshot_load(
+                      fn_environment_get_savefilepath(env));
+                  Uint8 episode = 0;
+                  Uint8 storedlevel = 0;
+                  Uint8 storedsequence = 0;
+                  if (stored != NULL &&
+                      fn_snapshot_get_level(stored, &episode,
+                        &storedlevel, &storedsequence) &&
+                      episode == fn_environment_get_episode(env) &&
+                      storedlevel == levelnumber)
+                  {
+                    restored = fn_snapshot_restore_level(stored, lv);
+                    quicksave = stored;
+                  } else if (stored != NULL) {
+                    fn_snapshot_free(stored);
+                  }
+                }
+                if (restored) {
+                  input = 0;
+                  latched = 0;
+                  applied = 0;
+                  fn_game_restored(env, hero);
+                  doupdate = 1;
+                }
+              }
+              break;
             case SDLK_DOWN:
               if (event.key.keysym.mod & KMOD_SHIFT) {
                 gint y = fn_geometry_get_y(srcrect);
@@ -400,7 +751,8 @@ int fn_game_start_in_level(
                   fn_geometry_set_y(srcrect, y - FN_HALFTILE_HEIGHT);
                 }
               } else {
-                fn_level_hero_interact_start(lv);
+                input |= FNK_INTERACT_ENABLED;
+                latched |= FNK_INTERACT_ENABLED;
               }
               doupdate = 1;
               break;
@@ -411,15 +763,8 @@ int fn_game_start_in_level(
                   fn_geometry_set_x(srcrect, x - FN_HALFTILE_WIDTH);
                 }
               } else {
-                directions |= FNK_LEFT_ENABLED;
-                if (directions & FNK_RIGHT_ENABLED) {
-                  fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
-                } else {
-                  fn_hero_set_direction(hero,
-                      fn_horizontal_direction_left);
-                  fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
-                }
-                fn_hero_update_animation(hero);
+                input |= FNK_LEFT_ENABLED;
+                latched |= FNK_LEFT_ENABLED;
               }
               doupdate = 1;
               break;
@@ -432,26 +777,18 @@ int fn_game_start_in_level(
                   fn_geometry_set_x(srcrect, x + FN_HALFTILE_WIDTH);
                 }
               } else {
-                directions |= FNK_RIGHT_ENABLED;
-                if (directions & FNK_LEFT_ENABLED) {
-                  fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
-                } else {
-                  fn_hero_set_direction(hero,
-                      fn_horizontal_direction_right);
-                  fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
-                }
-                fn_hero_update_animation(hero);
+                input |= FNK_RIGHT_ENABLED;
+                latched |= FNK_RIGHT_ENABLED;
               }
               doupdate = 1;
               break;
             case SDLK_LCTRL:
-              fn_hero_set_flying(hero, FN_HERO_FLYING_TRUE);
-              fn_hero_update_animation(hero);
+              input |= FNK_JUMP_ENABLED;
+              latched |= FNK_JUMP_ENABLED;
               break;
             case SDLK_LALT:
-              fn_hero_fire_start(hero);
-              fn_level_fire_shot(lv);
-              fn_hero_update_animation(hero);
+              input |= FNK_FIRE_ENABLED;
+              latched |= FNK_FIRE_ENABLED;
               break;
             default:
               /* do nothing on other key input (yet) */
@@ -460,34 +797,24 @@ int fn_game_start_in_level(
           break;
         case SDL_KEYUP:
           switch(event.key.keysym.sym) {
+            case SDLK_BACKSPACE:
+              rewinding = 0;
+              break;
             case SDLK_UP:
-              fn_level_hero_interact_stop(lv);
+              input &= ~FNK_INTERACT_ENABLED;
               doupdate = 1;
               break;
             case SDLK_LEFT:
-              directions &= ~FNK_LEFT_ENABLED;
-              if (directions & FNK_RIGHT_ENABLED) {
-                fn_hero_set_direction(hero,
-                    fn_horizontal_direction_right);
-                fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
-              } else {
-                fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
-              }
-              fn_hero_update_animation(hero);
+              input &= ~FNK_LEFT_ENABLED;
               break;
             case SDLK_RIGHT:
-              directions &= ~FNK_RIGHT_ENABLED;
-              if (directions & FNK_LEFT_ENABLED) {
-                  fn_hero_set_direction(hero,
-                      fn_horizontal_direction_left);
-                  fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
-              } else {
-                fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
-              }
+              input &= ~FNK_RIGHT_ENABLED;
+              break;
+            case SDLK_LCTRL:
+              input &= ~FNK_JUMP_ENABLED;
               break;
             case SDLK_LALT:
-              fn_hero_fire_stop(hero);
-              fn_hero_update_animation(hero);
+              input &= ~FNK_FIRE_ENABLED;
               break;
             default:
               /* do nothing on other keys. */
@@ -497,16 +824,16 @@ int fn_game_start_in_level(
         case SDL_MOUSEBUTTONDOWN:
           switch(event.button.button) {
             case SDL_BUTTON_LEFT:
-              fn_hero_fire_start(hero);
-              fn_level_fire_shot(lv);
-              fn_hero_update_animation(hero);
+              input |= FNK_FIRE_ENABLED;
+              latched |= FNK_FIRE_ENABLED;
               break;
             case SDL_BUTTON_RIGHT:
-              fn_hero_set_flying(hero, FN_HERO_FLYING_TRUE);
-              fn_hero_update_animation(hero);
+              input |= FNK_JUMP_ENABLED;
+              latched |= FNK_JUMP_ENABLED;
               break;
             case SDL_BUTTON_MIDDLE:
-              fn_level_hero_interact_start(lv);
+              input |= FNK_INTERACT_ENABLED;
+              latched |= FNK_INTERACT_ENABLED;
               doupdate = 1;
               break;
             default:
@@ -517,13 +844,13 @@ int fn_game_start_in_level(
         case SDL_MOUSEBUTTONUP:
           switch(event.button.button) {
             case SDL_BUTTON_LEFT:
-              fn_hero_fire_stop(hero);
-              fn_hero_update_animation(hero);
+              input &= ~FNK_FIRE_ENABLED;
               break;
             case SDL_BUTTON_RIGHT:
+              input &= ~FNK_JUMP_ENABLED;
               break;
             case SDL_BUTTON_MIDDLE:
-              fn_level_hero_interact_stop(lv);
+              input &= ~FNK_INTERACT_ENABLED;
               doupdate = 1;
               break;
             default:
@@ -537,71 +864,62 @@ int fn_game_start_in_level(
         case SDL_USEREVENT:
           switch(event.user.code) {
             case fn_event_timer:
+              if (rewinding && rewind != NULL) {
+                /* go back one tick instead of acting */
+                if (fn_rewind_step_back(rewind, lv)) {
+                  latched = 0;
+                  applied = 0;
+                  fn_game_restored(env, hero);
+                  doupdate = 1;
+                }
+                break;
+              }
+              {
+                Uint8 tickinput = input | latched;
+                latched = 0;
+                if (demo != NULL && !fn_demo_tick(demo, &tickinput)) {
+                  /* the recorded input is exhausted */
+                  lv->do_play = 0;
+                  break;
+                }
+                fn_level_apply_input(lv, applied, tickinput);
+                applied = tickinput;
+              }
+              {
+                SDL_Rect view;
+                view.x = fn_geometry_get_x(srcrect);
+                view.y = fn_geometry_get_y(srcrect);
+                view.w = fn_geometry_get_width(srcrect);
+                view.h = fn_geometry_get_height(srcrect);
+                fn_level_update_visibility(lv, &view);
+              }
               fn_level_act(lv);
+              if (rewind != NULL) {
+                fn_rewind_record(rewind, lv, levelnumber, sequence);
+              }
               doupdate = 1;
               break;
             case fn_event_heromoved:
               {
-                SDL_Rect * heropos = fn_hero_get_position(hero);
-                gint x =
-                    heropos->x + heropos->w / 2 -
-                    FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH / 2;
-                if (x < 0) {
-                  x = 0;
-                }
-                fn_geometry_set_x(srcrect, x);
-
-                gint y =
-                  heropos->y - FN_LEVEL_HEIGHT * FN_TILE_HEIGHT / 2;
-                if (y < 0) {
-                  y = 0;
-                }
-                fn_geometry_set_y(srcrect, y);
-
-                guint width = fn_geometry_get_width(srcrect);
-
-                if (x + width >
-                    FN_LEVEL_WIDTH * FN_TILE_WIDTH)
-                {
-                  fn_geometry_set_x(srcrect,
-                      FN_LEVEL_WIDTH * FN_TILE_WIDTH - width);
-                }
-
-                guint height = fn_geometry_get_height(srcrect);
-                if (y + height >
-                    FN_LEVEL_HEIGHT * FN_TILE_HEIGHT)
-                {
-                  fn_geometry_set_y(srcrect,
-                    FN_LEVEL_HEIGHT * FN_TILE_HEIGHT - height);
-                }
+                SDL_Rect view;
+                view.w = fn_geometry_get_width(srcrect);
+                view.h = fn_geometry_get_height(srcrect);
+                fn_level_center_view(lv, &view);
+                fn_geometry_set_x(srcrect, view.x);
+                fn_geometry_set_y(srcrect, view.y);
               }
               break;
             case fn_event_heroscored:
-              fn_borders_blit_score(
-                  env);
-              /* TODO separately update this area. */
-              updateWholeScreen = 1;
+              fn_borders_update_score(env);
               break;
             case fn_event_hero_firepower_changed:
-              fn_borders_blit_firepower(env);
-              /* TODO separately update this area. */
-              updateWholeScreen = 1;
+              fn_borders_update_firepower(env);
               break;
             case fn_event_hero_inventory_changed:
-              fn_borders_blit_inventory(env);
-              /* TODO separately update this area. */
-              updateWholeScreen = 1;
+              fn_borders_update_inventory(env);
               break;
             case fn_event_hero_health_changed:
-              fn_borders_blit_life(env);
-              /* TODO separately update this area. */
-              updateWholeScreen = 1;
-              break;
-            case fn_event_herolanded:
-              fn_level_add_actor(lv, FN_LEVEL_ACTOR_DUSTCLOUD,
-                  fn_hero_get_x(hero),
-                  fn_hero_get_y(hero) + FN_TILE_HEIGHT
-                  );
+              fn_borders_update_life(env);
               break;
             default:
               /* don't do anything on other events. */
@@ -616,18 +934,38 @@ int fn_game_start_in_level(
           /* do nothing on any other events. */
           break;
       }
+      FN_PROFILE_END(FN_PROFILE_EVENTS);
     }
   }
 
 cleanup:
+  /* we might have left the loop in the middle of an event */
+  FN_PROFILE_END(FN_PROFILE_EVENTS);
   if (backdrop != NULL) {
     g_object_unref(backdrop);
   }
   if (lv != NULL) {
+    if (demo != NULL) {
+      fn_demo_end_level(demo, lv);
+    }
+    if (fn_profile_actors_enabled) {
+      fn_profile_actor_report(stdout, levelnumber);
+    }
     returnvalue = lv->levelpassed;
     fn_level_free(lv);
   }
-  SDL_RemoveTimer(tick);
+  if (tick != 0) {
+    SDL_RemoveTimer(tick);
+  }
+  if (quicksave != NULL) {
+    fn_snapshot_free(quicksave);
+  }
+  if (rewind != NULL) {
+    if (getenv("FREENUKUM_REWIND_STATS") != NULL) {
+      fn_rewind_print_stats(rewind);
+    }
+    fn_rewind_free(rewind);
+  }
   g_object_unref(level);
 
   return returnvalue;
@@ -67,4 +67,37 @@ int fn_game_start_in_level(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Play back a recorded demo.
+ *
+ * @param  env   The environment.
+ * @param  path  The path of the demo file.
+ * @param  mode  The playback mode (one of FN_DEMO_MODE_REALTIME,
+ *               FN_DEMO_MODE_FASTFORWARD and FN_DEMO_MODE_HEADLESS).
+ *
+ * @return Non-zero if the demo could be played and every level
+ *         ended in the recorded state, else zero.
+ */
+int fn_game_replay_demo(
+    fn_environment_t * env,
+    char * path,
+    Uint8 mode);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Continue a game from a quicksave file. The game goes on with
+ * the levels following the restored one.
+ *
+ * @param  env   The environment.
+ * @param  path  The path of the quicksave file.
+ *
+ * @return Non-zero if the quicksave could be restored, else zero.
+ */
+int fn_game_restore(
+    fn_environment_t * env,
+    char * path);
+
+/* --------------------------------------------------------------- */
+
 #endif /* FN_GAME_H */
@@ -93,6 +93,8 @@ void fn_hero_reset(fn_hero_t * hero)
   hero->turned_around = 0;
 
   hero->is_moving_horizontally = 0;
+
+  hero->events = 0;
 }
 
 /* --------------------------------------------------------------- */
@@ -130,13 +132,46 @@ void fn_hero_enterlevel(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Draw a tile of the hero, onto the level if there is one.
+ *
+ * @param  hero    The hero.
+ * @param  target  The target surface if there is no level.
+ * @param  level   The level, or NULL.
+ * @param  tilenr  The number of the tile.
+ * @param  x       The x position in level pixels.
+ * @param  y       The y position in level pixels.
+ */
+static void fn_hero_blit_tile(fn_hero_t * hero,
+    SDL_Surface * target,
+    fn_level_t * level,
+    int tilenr,
+    int x,
+    int y)
+{
+  SDL_Rect dstrect;
+
+  if (level != NULL) {
+    fn_level_draw_tile(level, tilenr, x, y, FN_LEVEL_LAYER_HERO);
+    return;
+  }
+
+  Uint8 pixelsize = fn_environment_get_pixelsize(hero->env);
+  dstrect.x = pixelsize * x;
+  dstrect.y = pixelsize * y;
+  dstrect.w = pixelsize * FN_TILE_WIDTH;
+  dstrect.h = pixelsize * FN_TILE_HEIGHT;
+  fn_texture_blit_to_sdl_surface(fn_environment_get_tile(hero->env, tilenr),
+      NULL, target, &dstrect);
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_hero_blit(fn_hero_t * hero,
     SDL_Surface * target,
     fn_level_t * level)
 {
-  SDL_Rect dstrect;
   int tilenr;
-  FnTexture * tile;
 
   if (hero->hidden) {
     return;
@@ -148,10 +183,10 @@ void fn_hero_blit(fn_hero_t * hero,
   fn_environment_t * env = hero->env;
   Uint8 pixelsize = fn_environment_get_pixelsize(env);
 
-  dstrect.x = pixelsize * (fn_hero_get_x(hero) - FN_HALFTILE_WIDTH);
-  dstrect.y = pixelsize * fn_hero_get_y(hero);
-  dstrect.w = pixelsize * fn_hero_get_w(hero);
-  dstrect.h = pixelsize * fn_hero_get_h(hero);
+  int x = fn_hero_get_x(hero) - FN_HALFTILE_WIDTH;
+  int y = fn_hero_get_y(hero);
+  int w = fn_hero_get_w(hero);
+  int h = fn_hero_get_h(hero);
 
   tilenr = hero->tilenr;
   if (hero->immunitycountdown > hero->immunityduration - 1) {
@@ -162,24 +197,21 @@ void fn_hero_blit(fn_hero_t * hero,
     }
   }
 
-  tile = fn_environment_get_tile(env, tilenr);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-  dstrect.x += dstrect.w;
-  tile = fn_environment_get_tile(env, tilenr+1);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-  dstrect.x -= dstrect.w;
-  dstrect.y += dstrect.h;
-  tile = fn_environment_get_tile(env, tilenr+2);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
-
-  dstrect.x += dstrect.w;
-  tile = fn_environment_get_tile(env, tilenr+3);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &dstrect);
+  fn_hero_blit_tile(hero, target, level, tilenr, x, y);
+  fn_hero_blit_tile(hero, target, level, tilenr+1, x + w, y);
+  fn_hero_blit_tile(hero, target, level, tilenr+2, x, y + h);
+  fn_hero_blit_tile(hero, target, level, tilenr+3, x + w, y + h);
 
   if (fn_environment_get_draw_collision_bounds(env)) {
-    fn_collision_rect_draw(target, pixelsize, &(hero->position));
+    if (level == NULL) {
+      fn_collision_rect_draw(target, pixelsize, &(hero->position));
+      return;
+    }
+
+    fn_level_draw_bounds(level,
+        hero->position.x, hero->position.y,
+        hero->position.w, hero->position.h,
+        FN_LEVEL_LAYER_HERO);
 
     Uint16 i = 0;
     Uint16 j = 0;
@@ -192,17 +224,12 @@ void fn_hero_blit(fn_hero_t * hero,
           j += FN_TILE_HEIGHT) {
         Uint16 tile_x = i / FN_TILE_WIDTH;
         Uint16 tile_y = j / FN_TILE_HEIGHT;
-        if (level != NULL) {
-          if (fn_level_is_solid(level, tile_x, tile_y))
-          {
-            SDL_Rect obstacle;
-            obstacle.x = tile_x * FN_TILE_WIDTH;
-            obstacle.y = tile_y * FN_TILE_HEIGHT;
-            obstacle.w = FN_TILE_WIDTH;
-            obstacle.h = FN_TILE_HEIGHT;
-
-            fn_collision_rect_draw(target, pixelsize, &obstacle);
-          }
+        if (fn_level_is_solid(level, tile_x, tile_y))
+        {
+          fn_level_draw_bounds(level,
+              tile_x * FN_TILE_WIDTH, tile_y * FN_TILE_HEIGHT,
+              FN_TILE_WIDTH, FN_TILE_HEIGHT,
+              FN_LEVEL_LAYER_HERO);
         }
       }
     }
@@ -327,12 +354,7 @@ int fn_hero_act(
         fn_hero_get_y(hero) + FN_HALFTILE_HEIGHT
         )) {
     if (hero->flying == FN_HERO_FLYING_TRUE) {
-      SDL_Event event;
-      event.type = SDL_USEREVENT;
-      event.user.code = fn_event_herolanded;
-      event.user.data1 = hero;
-      event.user.data2 = 0;
-      SDL_PushEvent(&event);
+      fn_hero_post_event(hero, fn_event_herolanded);
     }
     /* we are standing on solid ground */
     fn_hero_set_flying(hero, FN_HERO_FLYING_FALSE);
@@ -346,12 +368,7 @@ int fn_hero_act(
   }
 
   if (heromoved) {
-    SDL_Event event;
-    event.type = SDL_USEREVENT;
-    event.user.code = fn_event_heromoved;
-    event.user.data1 = hero;
-    event.user.data2 = 0;
-    SDL_PushEvent(&event);
+    fn_hero_post_event(hero, fn_event_heromoved);
   }
 
   return hero->health;
@@ -364,12 +381,7 @@ void fn_hero_replace(fn_hero_t * hero,
 {
   fn_hero_set_x(hero, x);
   fn_hero_set_y(hero, y);
-  SDL_Event event;
-  event.type = SDL_USEREVENT;
-  event.user.code = fn_event_heromoved;
-  event.user.data1 = hero;
-  event.user.data2 = 0;
-  SDL_PushEvent(&event);
+  fn_hero_post_event(hero, fn_event_heromoved);
 }
 
 /* --------------------------------------------------------------- */
@@ -515,18 +527,12 @@ void fn_hero_set_firepower(
     fn_hero_t * hero,
     Uint8 firepower)
 {
-  SDL_Event event;
-
   if (firepower > 4) {
     firepower = 4;
   }
   hero->firepower = firepower;
 
-  event.type = SDL_USEREVENT;
-  event.user.code = fn_event_hero_firepower_changed;
-  event.user.data1 = hero;
-  event.user.data2 = 0;
-  SDL_PushEvent(&event);
+  fn_hero_post_event(hero, fn_event_hero_firepower_changed);
 }
 
 /* --------------------------------------------------------------- */
@@ -544,15 +550,9 @@ void fn_hero_set_inventory(
     fn_hero_t * hero,
     Uint8 inventory)
 {
-  SDL_Event event;
-
   hero->inventory = inventory;
 
-  event.type = SDL_USEREVENT;
-  event.user.code = fn_event_hero_inventory_changed;
-  event.user.data1 = hero;
-  event.user.data2 = 0;
-  SDL_PushEvent(&event);
+  fn_hero_post_event(hero, fn_event_hero_inventory_changed);
 }
 
 /* --------------------------------------------------------------- */
@@ -579,16 +579,11 @@ Uint8 fn_hero_get_health(fn_hero_t * hero)
 
 void fn_hero_set_health(fn_hero_t * hero, Uint8 health)
 {
-  SDL_Event event;
   hero->health = health;
   if (hero->health > 8) {
     hero->health = 8;
   }
-  event.type = SDL_USEREVENT;
-  event.user.code = fn_event_hero_health_changed;
-  event.user.data1 = hero;
-  event.user.data2 = 0;
-  SDL_PushEvent(&event);
+  fn_hero_post_event(hero, fn_event_hero_health_changed);
 }
 
 /* --------------------------------------------------------------- */
@@ -704,15 +699,9 @@ int fn_hero_would_collide(fn_hero_t * hero, void * level,
 
 void fn_hero_add_score(fn_hero_t * hero, Uint64 score)
 {
-  SDL_Event event;
-
   hero->score += score;
 
-  event.type = SDL_USEREVENT;
-  event.user.code = fn_event_heroscored;
-  event.user.data1 = hero;
-  event.user.data2 = 0;
-  SDL_PushEvent(&event);
+  fn_hero_post_event(hero, fn_event_heroscored);
 }
 
 /* --------------------------------------------------------------- */
@@ -794,12 +783,7 @@ Sint8 fn_hero_push_horizontally(
 
   if (!fn_hero_collides_with_solid(hero, level)) {
     /* no solids in the way */
-    SDL_Event event;
-    event.type = SDL_USEREVENT;
-    event.user.code = fn_event_heromoved;
-    event.user.data1 = hero;
-    event.user.data2 = 0;
-    SDL_PushEvent(&event);
+    fn_hero_post_event(hero, fn_event_heromoved);
     return offset;
   }
 
@@ -811,12 +795,7 @@ Sint8 fn_hero_push_horizontally(
   for (i = 0; i < offset_abs; i++) {
     hero->position.x -= direction;
     if (!fn_hero_collides_with_solid(hero, level)) {
-      SDL_Event event;
-      event.type = SDL_USEREVENT;
-      event.user.code = fn_event_heromoved;
-      event.user.data1 = hero;
-      event.user.data2 = 0;
-      SDL_PushEvent(&event);
+      fn_hero_post_event(hero, fn_event_heromoved);
       return i * direction;
     }
   }
@@ -835,12 +814,7 @@ Sint8 fn_hero_push_vertically(
 
   if (!fn_hero_collides_with_solid(hero, level)) {
     /* no solids in the way */
-    SDL_Event event;
-    event.type = SDL_USEREVENT;
-    event.user.code = fn_event_heromoved;
-    event.user.data1 = hero;
-    event.user.data2 = 0;
-    SDL_PushEvent(&event);
+    fn_hero_post_event(hero, fn_event_heromoved);
     return offset;
   }
 
@@ -852,12 +826,7 @@ Sint8 fn_hero_push_vertically(
   for (i = 0; i < offset_abs; i++) {
     hero->position.y -= direction;
     if (!fn_hero_collides_with_solid(hero, level)) {
-      SDL_Event event;
-      event.type = SDL_USEREVENT;
-      event.user.code = fn_event_heromoved;
-      event.user.data1 = hero;
-      event.user.data2 = 0;
-      SDL_PushEvent(&event);
+      fn_hero_post_event(hero, fn_event_heromoved);
       return i * direction;
     }
   }
@@ -899,3 +868,19 @@ int fn_hero_collides_with_solid(fn_hero_t * hero, fn_level_t * level)
 
 /* --------------------------------------------------------------- */
 
+void fn_hero_post_event(fn_hero_t * hero, fn_event_e code)
+{
+  hero->events |= (1 << code);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_hero_take_events(fn_hero_t * hero)
+{
+  Uint8 events = hero->events;
+  hero->events = 0;
+  return events;
+}
+
+/* --------------------------------------------------------------- */
+
@@ -170,6 +170,12 @@ struct fn_hero_t {
    * Indicates if the hero is currently moving horizontally.
    */
   Uint8 is_moving_horizontally;
+
+  /**
+   * The events which occurred since they were last taken,
+   * one bit per fn_event_e value.
+   */
+  Uint8 events;
 };
 
 /* --------------------------------------------------------------- */
@@ -589,4 +595,28 @@ int fn_hero_collides_with_solid(fn_hero_t * hero, fn_level_t * level);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Notify about something that happened to the hero. The event is
+ * kept inside the hero until it is taken by the code running the
+ * level, so that several heroes can live side by side without
+ * sharing the SDL event queue.
+ *
+ * @param  hero  The hero.
+ * @param  code  The event.
+ */
+void fn_hero_post_event(fn_hero_t * hero, fn_event_e code);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Take the events which occurred since the last call.
+ *
+ * @param  hero  The hero.
+ *
+ * @return The events, one bit (1 << code) per fn_event_e value.
+ */
+Uint8 fn_hero_take_events(fn_hero_t * hero);
+
+/* --------------------------------------------------------------- */
+
 #endif /* FN_HERO_H */
@@ -42,7 +42,7 @@ void fn_infobox_show(
 
   SDL_Event event;
 
-  msgbox = fn_msgbox(
+  msgbox = fn_msgbox_cached(
       env,
       msg);
 
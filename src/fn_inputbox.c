@@ -70,6 +70,7 @@ fn_inputbox_answer_t fn_inputbox_show(
       FN_FONT_HEIGHT,
       graphic_options
       );
+  fn_texture_set_category(inputfield_surface, FN_TEXTURE_CATEGORY_UI);
 
   msgbox = fn_msgbox(env, buffer);
 
@@ -142,6 +142,7 @@ void fn_inputfield_blit(fn_inputfield_t * field,
         (FN_FONT_HEIGHT - 2) * pixelsize);
 
   fn_texture_fill_area(target, cursorrect, 0x88, 0x88, 0x88);
+  g_object_unref(cursorrect);
 }
 
 /* --------------------------------------------------------------- */
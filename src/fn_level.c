@@ -27,6 +27,7 @@
  *******************************************************************/
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 
 /* --------------------------------------------------------------- */
@@ -36,11 +37,186 @@
 #include "fn_hero.h"
 #include "fn_object.h"
 #include "fn_collision.h"
+#include "fn_profile.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Add an animated background tile to the level.
+ *
+ * @param  lv          The level.
+ * @param  tile        The first frame in the tilecache.
+ * @param  num_frames  The number of frames.
+ * @param  x           The column of the tile.
+ * @param  y           The row of the tile.
+ */
+static void fn_level_add_animation(fn_level_t * lv,
+    Uint16 tile,
+    Uint8 num_frames,
+    size_t x,
+    size_t y)
+{
+  if (lv->num_animations == lv->max_animations) {
+    size_t max = (lv->max_animations == 0) ? 64 : lv->max_animations * 2;
+    fn_level_animation_t * animations =
+      realloc(lv->animations, max * sizeof(fn_level_animation_t));
+    if (animations == NULL) {
+      return;
+    }
+    lv->animations = animations;
+    lv->max_animations = max;
+  }
+  fn_level_animation_t * animation = &(lv->animations[lv->num_animations]);
+  animation->x = x;
+  animation->y = y;
+  animation->tile = tile;
+  animation->num_frames = num_frames;
+  lv->num_animations++;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if the actors of a type may be kept as spawn records
+ * until the view comes near. Actors that other actors look for
+ * anywhere in the level, and the conveyors, which change the
+ * tiles when they are created, are created right away.
+ *
+ * @param  type  The actor type.
+ *
+ * @return 1 if the actors may be created later, otherwise 0.
+ */
+static Uint8 fn_level_spawns_lazily(fn_level_actor_type_e type)
+{
+  switch(type) {
+    case FN_LEVEL_ACTOR_TELEPORTER1:
+    case FN_LEVEL_ACTOR_TELEPORTER2:
+    case FN_LEVEL_ACTOR_DOOR_RED:
+    case FN_LEVEL_ACTOR_DOOR_BLUE:
+    case FN_LEVEL_ACTOR_DOOR_PINK:
+    case FN_LEVEL_ACTOR_DOOR_GREEN:
+    case FN_LEVEL_ACTOR_ACCESS_CARD_DOOR:
+    case FN_LEVEL_ACTOR_EXPANDINGFLOOR:
+    case FN_LEVEL_ACTOR_CONVEYOR_LEFTMOVING_RIGHTEND:
+    case FN_LEVEL_ACTOR_CONVEYOR_RIGHTMOVING_RIGHTEND:
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Add a spawn record for an actor loaded with the level.
+ *
+ * @param  lv    The level.
+ * @param  type  The actor type.
+ * @param  x     The x coordinate in tiles.
+ * @param  y     The y coordinate in tiles.
+ *
+ * @return 1 on success, 0 if there was no memory for the record.
+ */
+static Uint8 fn_level_add_spawn(fn_level_t * lv,
+    fn_level_actor_type_e type,
+    Uint16 x,
+    Uint16 y)
+{
+  if (lv->num_spawns == lv->max_spawns) {
+    size_t max = (lv->max_spawns == 0) ? 256 : lv->max_spawns * 2;
+    fn_level_spawn_t * spawns =
+      realloc(lv->spawns, max * sizeof(fn_level_spawn_t));
+    if (spawns == NULL) {
+      return 0;
+    }
+    lv->spawns = spawns;
+    lv->max_spawns = max;
+  }
+  fn_level_spawn_t * spawn = &(lv->spawns[lv->num_spawns]);
+  spawn->x = x;
+  spawn->y = y;
+  spawn->type = type;
+  spawn->state = FN_LEVEL_SPAWN_WAITING;
+  spawn->sequence = lv->next_sequence;
+  lv->next_sequence++;
+  lv->num_spawns++;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the region a spawn record lies in.
+ *
+ * @param  spawn  The spawn record.
+ *
+ * @return The region.
+ */
+static Uint16 fn_level_spawn_region(const fn_level_spawn_t * spawn)
+{
+  return (spawn->y / FN_LEVEL_REGION_SIZE) * FN_LEVEL_REGION_COLUMNS +
+    spawn->x / FN_LEVEL_REGION_SIZE;
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_level_compare_spawns(const void * a, const void * b)
+{
+  const fn_level_spawn_t * x = a;
+  const fn_level_spawn_t * y = b;
+  Uint16 xregion = fn_level_spawn_region(x);
+  Uint16 yregion = fn_level_spawn_region(y);
+
+  if (xregion != yregion) {
+    return (xregion > yregion) - (xregion < yregion);
+  }
+  return (x->sequence > y->sequence) - (x->sequence < y->sequence);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Sort the spawn records by region and find the first record of
+ * each region.
+ *
+ * @param  lv  The level.
+ */
+static void fn_level_sort_spawns(fn_level_t * lv)
+{
+  size_t i = 0;
+
+  qsort(lv->spawns, lv->num_spawns, sizeof(fn_level_spawn_t),
+      fn_level_compare_spawns);
+
+  memset(lv->spawn_regions, 0, sizeof(lv->spawn_regions));
+  for (i = 0; i < lv->num_spawns; i++) {
+    lv->spawn_regions[fn_level_spawn_region(&(lv->spawns[i])) + 1]++;
+  }
+  for (i = 1; i <= FN_LEVEL_NUM_REGIONS; i++) {
+    lv->spawn_regions[i] += lv->spawn_regions[i - 1];
+  }
+}
 
 /* --------------------------------------------------------------- */
 
 fn_level_t * fn_level_load(int fd,
     fn_environment_t * env)
+{
+  return fn_level_load_with_hero(fd, env,
+      fn_environment_get_hero(env));
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Load a level. A headless level gets no textures, and its fixed
+ * tiles are not drawn, so no surface shared through the environment
+ * is blitted from while it is loaded.
+ */
+static fn_level_t * fn_level_load_internal(int fd,
+    fn_environment_t * env,
+    fn_hero_t * hero,
+    Uint8 headless)
 {
   FnGraphicOptions * graphic_options =
     fn_environment_get_graphic_options(env);
@@ -52,6 +228,9 @@ fn_level_t * fn_level_load(int fd,
   Uint8 lowertile;
 
   lv->environment = env;
+  lv->hero = hero;
+  lv->tilecache = fn_environment_get_tilecache(env);
+  lv->seed = 1;
 
   lv->animated_frames = 0;
 
@@ -63,18 +242,26 @@ fn_level_t * fn_level_load(int fd,
   lv->bots = NULL;
   lv->shots = NULL;
   lv->interactor = NULL;
+  lv->snapshot = NULL;
 
   lv->do_play = 1;
 
-  lv->texture_fixed = fn_texture_new_with_options(
-      FN_TILE_WIDTH * FN_LEVEL_WIDTH,
-      FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
-      graphic_options);
-
-  lv->texture = fn_texture_new_with_options(
-      FN_TILE_WIDTH * FN_LEVEL_WIDTH,
-      FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
-      graphic_options);
+  if (!headless) {
+    lv->texture_fixed = fn_texture_new_with_options(
+        FN_TILE_WIDTH * FN_LEVEL_WIDTH,
+        FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
+        graphic_options);
+    fn_texture_set_category(lv->texture_fixed, FN_TEXTURE_CATEGORY_LEVEL);
+
+    lv->texture = fn_texture_new_with_options(
+        FN_TILE_WIDTH * FN_LEVEL_WIDTH,
+        FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
+        graphic_options);
+    fn_texture_set_category(lv->texture, FN_TEXTURE_CATEGORY_LEVEL);
+    /* every frame covers the view with the opaque static layer, so
+     * the level is copied out without a colour key */
+    SDL_SetColorKey(fn_level_get_surface(lv), 0, 0);
+  }
 
   while (i != FN_LEVEL_HEIGHT * FN_LEVEL_WIDTH)
   {
@@ -88,6 +275,10 @@ fn_level_t * fn_level_load(int fd,
     read(fd, &uppertile, 1);
     tilenr = (uppertile << 8) | lowertile;
 
+    if (x == 0) {
+      lv->animation_rows[y] = lv->num_animations;
+    }
+
     lv->raw[y][x] = tilenr;
 
     if ((tilenr >= 4) && (tilenr <= 0x2fe0)) {
@@ -95,60 +286,58 @@ fn_level_t * fn_level_load(int fd,
       lv->solid[y][x] = (tilenr >= 0x1800);
     }
 
-    fn_hero_t * hero = fn_environment_get_hero(env);
-
     switch(tilenr) {
       case 0x0080: /* written text on black screen */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_TEXT_ON_SCREEN_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x0004, 4, x, y);
         break;
       case 0x0100: /* blue high voltage flash */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_HIGH_VOLTAGE_FLASH_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x0008, 4, x, y);
         break;
       case 0x0180: /* red flash light */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_RED_FLASHLIGHT_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x000C, 4, x, y);
         break;
       case 0x0200: /* blue high voltage flash */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_BLUE_FLASHLIGHT_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x0010, 4, x, y);
         break;
       case 0x0280: /* key panel on the wall */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_KEYPANEL_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x0014, 4, x, y);
         break;
       case 0x0300: /* red rotation light */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_RED_ROTATIONLIGHT_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x0018, 4, x, y);
         break;
       case 0x0380: /* flashing up arrow */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_UPARROW_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            0x001C, 4, x, y);
         break;
       case 0x0400: /* background blinking blue box */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND1, x, y);
+        fn_level_add_animation(lv,
+            0x0020, 4, x, y);
         break;
       case 0x0420: /* background blinking blue box */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND2, x, y);
+        fn_level_add_animation(lv,
+            0x0021, 4, x, y);
         break;
       case 0x0440: /* background blinking blue box */
-        fn_level_add_initial_actor(lv,
-          FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND3, x, y);
+        fn_level_add_animation(lv,
+          0x0022, 4, x, y);
         break;
       case 0x0460: /* background blinking blue box */
-        fn_level_add_initial_actor(lv,
-          FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND4, x, y);
+        fn_level_add_animation(lv,
+          0x0023, 4, x, y);
         break;
       case 0x0480: /* background green poison liquid */
-        fn_level_add_initial_actor(lv,
-          FN_LEVEL_ACTOR_GREEN_POISON_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+          0x0028, 4, x, y);
         break;
       case 0x0500: /* background lava */
-        fn_level_add_initial_actor(lv,
-          FN_LEVEL_ACTOR_LAVA_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+          0x002C, 4, x, y);
         break;
       case 0x1800: /* solid wall which can be shot */
         lv->tiles[y][x] = 0x17E0/0x20;
@@ -415,8 +604,8 @@ fn_level_t * fn_level_load(int fd,
         if (y > 0) {
           lv->tiles[y][x] = lv->tiles[y-1][x];
         }
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_BROKENWALL_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            ANIM_BROKENWALLBG, 1, x, y);
         break;
       case 0x3026: /* left end of background stone wall */
         /* TODO */
@@ -425,8 +614,8 @@ fn_level_t * fn_level_load(int fd,
         /* TODO */
         break;
       case 0x3028: /* window inside background stone wall */
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_STONEWINDOW_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            ANIM_STONEWINDOWBG, 1, x, y);
         break;
       case 0x3029: /* grey box with full life */
         if (x > 0) {
@@ -558,13 +747,13 @@ fn_level_t * fn_level_load(int fd,
         break;
       case 0x303e: /* window - left part */
         lv->tiles[y][x] = 0;
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_WINDOWLEFT_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            ANIM_WINDOWBG, 1, x, y);
         break;
       case 0x303f: /* window - right part */
         lv->tiles[y][x] = 0;
-        fn_level_add_initial_actor(lv,
-            FN_LEVEL_ACTOR_WINDOWRIGHT_BACKGROUND, x, y);
+        fn_level_add_animation(lv,
+            ANIM_WINDOWBG + 1, 1, x, y);
         break;
       case 0x3040: /* the notebook */
         if (x > 0) {
@@ -744,8 +933,16 @@ fn_level_t * fn_level_load(int fd,
 
     i++;
   }
+  lv->animation_rows[FN_LEVEL_HEIGHT] = lv->num_animations;
+  fn_level_sort_spawns(lv);
 
   /* Put the correct tile behind the cameras. */
+  for (i = 0; i < lv->num_spawns; i++) {
+    fn_level_spawn_t * spawn = &(lv->spawns[i]);
+    if (spawn->type == FN_LEVEL_ACTOR_CAMERA) {
+      lv->tiles[spawn->y][spawn->x] = lv->tiles[spawn->y+1][spawn->x];
+    }
+  }
   fn_list_t * cameras =
     fn_level_get_items_of_type(lv,
         FN_LEVEL_ACTOR_CAMERA);
@@ -761,21 +958,49 @@ fn_level_t * fn_level_load(int fd,
   }
   fn_list_free(cameras);
 
-  /*
-   * Blit everything fixed to lv->surface_fixed.
-   */
-  Uint32 transparent;
-  transparent = SDL_MapRGB(lv->surface_fixed->format, 100, 1, 1);
-  SDL_SetColorKey(lv->surface, SDL_SRCCOLORKEY, transparent);
-  SDL_FillRect(lv->surface_fixed, NULL, transparent);
+  if (!headless) {
+    fn_level_blit_fixed(lv);
+  }
+
+  return lv;
+}
+
+/* --------------------------------------------------------------- */
+
+fn_level_t * fn_level_load_with_hero(int fd,
+    fn_environment_t * env,
+    fn_hero_t * hero)
+{
+  return fn_level_load_internal(fd, env, hero, 0);
+}
+
+/* --------------------------------------------------------------- */
+
+fn_level_t * fn_level_load_headless(int fd,
+    fn_environment_t * env,
+    fn_hero_t * hero)
+{
+  return fn_level_load_internal(fd, env, hero, 1);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_blit_fixed(fn_level_t * lv)
+{
+  SDL_Surface * fixed = fn_texture_get_sdl_surface(lv->texture_fixed);
+
+  /* no fixed tile is the colour key of the layer */
+  SDL_FillRect(fixed, NULL, fixed->format->colorkey);
+  lv->static_valid = 0;
 
   SDL_Rect r;
-  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+  Uint8 pixelsize = fn_environment_get_pixelsize(lv->environment);
   r.w = FN_TILE_WIDTH * pixelsize;
   r.h = FN_TILE_HEIGHT * pixelsize;
 
   Uint16 y = 0;
   Uint16 x = 0;
+  Uint16 tilenr = 0;
   FnTexture * tile = NULL;
   for (y = 0; y < FN_LEVEL_HEIGHT; y++) {
     for (x = 0; x < FN_LEVEL_WIDTH; x++) {
@@ -784,13 +1009,11 @@ fn_level_t * fn_level_load(int fd,
       if (tilenr > 1 && tilenr < (48 * 8)) {
         r.x = x * FN_TILE_WIDTH * pixelsize;
         r.y = y * FN_TILE_WIDTH * pixelsize;
-        tile = fn_environment_get_tile(env, tilenr);
-        fn_texture_blit_to_sdl_surface(tile, NULL, lv->surface_fixed, &r);
+        tile = fn_environment_get_tile(lv->environment, tilenr);
+        fn_texture_blit_to_sdl_surface(tile, NULL, fixed, &r);
       }
     }
   }
-
-  return lv;
 }
 
 /* --------------------------------------------------------------- */
@@ -825,8 +1048,33 @@ void fn_level_free(fn_level_t * lv)
   }
   fn_list_free(lv->actors);
 
-  SDL_FreeSurface(lv->surface);
-  SDL_FreeSurface(lv->surface_fixed);
+  if (lv->texture != NULL) {
+    g_object_unref(lv->texture);
+    g_object_unref(lv->texture_fixed);
+  }
+  if (lv->surface_static != NULL) {
+    SDL_FreeSurface(lv->surface_static);
+  }
+  if (lv->drawlist != NULL) {
+    fn_drawlist_free(lv->drawlist);
+  }
+  if (lv->surface_blank != NULL) {
+    SDL_FreeSurface(lv->surface_blank);
+  }
+  free(lv->draws);
+  free(lv->draws_sorted);
+  free(lv->animations);
+  free(lv->active);
+  free(lv->pending);
+  free(lv->spawns);
+  if (lv->spawn_scratch != NULL) {
+    fn_snapshot_free(lv->spawn_scratch);
+  }
+  if (lv->spawn_initial != NULL) {
+    fn_snapshot_free(lv->spawn_initial);
+  }
+  free(lv->spawn_initial_pos);
+  free(lv->spawn_initial_size);
 
   free(lv);
 }
@@ -884,197 +1132,1338 @@ void fn_level_set_solid(fn_level_t * lv, int x, int y, Uint8 solid)
 
 /* --------------------------------------------------------------- */
 
-void fn_level_blit_to_surface(fn_level_t * lv,
-    SDL_Surface * target,
-    SDL_Rect * targetrect,
-    SDL_Rect * sourcerect,
-    FnTexture * backdrop1,
-    FnTexture * backdrop2)
+/**
+ * Calculate the tiles around a view in which things are visible.
+ *
+ * @param  view     The view in level pixels.
+ * @param  x_start  Where to store the first visible column.
+ * @param  x_end    Where to store the column after the last one.
+ * @param  y_start  Where to store the first visible row.
+ * @param  y_end    Where to store the row after the last one.
+ */
+static void fn_level_get_visible_bounds(SDL_Rect * view,
+    int * x_start, int * x_end,
+    int * y_start, int * y_end)
 {
-  int x_start = 0;
-  int x_end = FN_LEVEL_WIDTH;
-  int y_start = 0;
-  int y_end = FN_LEVEL_HEIGHT;
-  SDL_Rect r;
-  fn_list_t * iter = NULL;
-
-  fn_environment_t * env = fn_level_get_environment(lv);
-  Uint8 pixelsize = fn_environment_get_pixelsize(env);
-
-  /* load the background tiles */
-  /*
-  SDL_FillRect(lv->surface, sourcerect, 0);
-  */
-  if (backdrop1 != NULL) {
-    fn_texture_blit_to_sdl_surface(
-        backdrop1, NULL, lv->surface, sourcerect);
-  } else {
-    SDL_FillRect(lv->surface, sourcerect, 0);
+  *x_start = (view->x / FN_TILE_WIDTH) - (FN_LEVELWINDOW_WIDTH / 2);
+  if (*x_start < 0) {
+    *x_start = 0;
+  }
+  *x_end = *x_start + (view->w / FN_TILE_WIDTH) * 2;
+  if (*x_end > FN_LEVEL_WIDTH) {
+    *x_end = FN_LEVEL_WIDTH;
+    *x_start = *x_end - FN_LEVELWINDOW_WIDTH * 2;
   }
 
-  SDL_BlitSurface(
-      lv->surface_fixed, sourcerect,
-      lv->surface, sourcerect);
-
-  /* calculate the bounds of the area we have to blit. */
-  if (sourcerect) {
-    x_start = (sourcerect->x / FN_TILE_WIDTH / pixelsize)
-      - (FN_LEVELWINDOW_WIDTH / 2);
-    if (x_start < 0) {
-      x_start = 0;
-    }
-    x_end = x_start + (sourcerect->w / FN_TILE_WIDTH / pixelsize) * 2;
-    if (x_end > FN_LEVEL_WIDTH) {
-      x_end = FN_LEVEL_WIDTH;
-      x_start = x_end - FN_LEVELWINDOW_WIDTH * 2;
-    }
-
-    y_start = (sourcerect->y / FN_TILE_HEIGHT / pixelsize)
-      - (FN_LEVELWINDOW_HEIGHT / 2);
-    if (y_start < 0) {
-      y_start = 0;
-    }
-    y_end =
-      y_start +
-      (sourcerect->h / FN_TILE_HEIGHT / pixelsize) * 2;
-    if (y_end > FN_LEVEL_HEIGHT) {
-      y_end = FN_LEVEL_HEIGHT;
-      y_start = y_end - FN_LEVELWINDOW_HEIGHT * 2;
-    }
+  *y_start = (view->y / FN_TILE_HEIGHT) - (FN_LEVELWINDOW_HEIGHT / 2);
+  if (*y_start < 0) {
+    *y_start = 0;
+  }
+  *y_end = *y_start + (view->h / FN_TILE_HEIGHT) * 2;
+  if (*y_end > FN_LEVEL_HEIGHT) {
+    *y_end = FN_LEVEL_HEIGHT;
+    *y_start = *y_end - FN_LEVELWINDOW_HEIGHT * 2;
   }
+}
 
-  r.x = 0;
-  r.y = 0;
-  r.w = FN_TILE_WIDTH * pixelsize;
-  r.h = FN_TILE_HEIGHT * pixelsize;
+/* --------------------------------------------------------------- */
 
-  fn_hero_t * hero = fn_environment_get_hero(env);
+/**
+ * Check if an actor reaches into the visible tiles.
+ *
+ * @param  actor    The actor.
+ * @param  x_start  The first visible column.
+ * @param  x_end    The column after the last visible one.
+ * @param  y_start  The first visible row.
+ * @param  y_end    The row after the last visible one.
+ *
+ * @return 1 if the actor is visible, otherwise 0.
+ */
+static Uint8 fn_level_actor_in_bounds(fn_level_actor_t * actor,
+    int x_start, int x_end,
+    int y_start, int y_end)
+{
+  Uint16 xl = fn_level_actor_get_x(actor) / FN_TILE_WIDTH;
+  Uint16 yt = fn_level_actor_get_y(actor) / FN_TILE_HEIGHT;
+  Uint16 xr = xl + fn_level_actor_get_w(actor) / FN_TILE_WIDTH;
+  Uint16 yb = yt + fn_level_actor_get_h(actor) / FN_TILE_HEIGHT;
 
-  /* blit the actors in the background */
-  for (iter = fn_list_first(lv->actors);
-      iter != NULL;
-      iter = fn_list_next(iter)) {
-    fn_level_actor_t * actor = (fn_level_actor_t *)iter->data;
+  return (xr > x_start && yb > y_start && xl < x_end && yt < y_end);
+}
 
-    if (actor != NULL) {
-      Uint16 xl = fn_level_actor_get_x(actor) / FN_TILE_WIDTH;
-      Uint16 yt = fn_level_actor_get_y(actor) / FN_TILE_HEIGHT;
-      Uint16 xr = xl + fn_level_actor_get_w(actor) / FN_TILE_WIDTH;
-      Uint16 yb = yt + fn_level_actor_get_h(actor) / FN_TILE_HEIGHT;
+/* --------------------------------------------------------------- */
 
-      if (xr > x_start && yb > y_start && xl < x_end && yt < y_end) {
-        fn_level_actor_set_visible(actor, 1);
-        if (!fn_level_actor_in_foreground(actor)) {
-          fn_level_actor_blit(actor);
-        }
-      } else {
-        fn_level_actor_set_visible(actor, 0);
-      }
+/**
+ * Append an actor to an array of actors, growing the array if
+ * it is full.
+ *
+ * @param  array  The array.
+ * @param  num    The number of actors in the array.
+ * @param  max    The number of actors the array has room for.
+ * @param  actor  The actor.
+ *
+ * @return 1 on success, 0 if the array could not grow.
+ */
+static Uint8 fn_level_schedule_push(fn_level_actor_t *** array,
+    size_t * num,
+    size_t * max,
+    fn_level_actor_t * actor)
+{
+  if (*num == *max) {
+    size_t newmax = (*max == 0) ? 64 : *max * 2;
+    fn_level_actor_t ** grown =
+      realloc(*array, newmax * sizeof(fn_level_actor_t *));
+    if (grown == NULL) {
+      return 0;
     }
+    *array = grown;
+    *max = newmax;
   }
+  (*array)[*num] = actor;
+  (*num)++;
+  return 1;
+}
 
-  /* blit the hero */
-  fn_hero_blit(hero,
-      lv->surface,
-      lv);
+/* --------------------------------------------------------------- */
 
-  /* blit the actors in the foreground */
-  for (iter = fn_list_first(lv->actors);
-      iter != NULL;
-      iter = fn_list_next(iter)) {
-    fn_level_actor_t * actor = (fn_level_actor_t *)iter->data;
+/**
+ * Let an actor wait in the region of its top left corner.
+ *
+ * @param  lv     The level.
+ * @param  actor  The actor.
+ */
+static void fn_level_schedule_sleep(fn_level_t * lv,
+    fn_level_actor_t * actor)
+{
+  Uint16 x = fn_level_actor_get_x(actor) /
+    (FN_TILE_WIDTH * FN_LEVEL_REGION_SIZE);
+  Uint16 y = fn_level_actor_get_y(actor) /
+    (FN_TILE_HEIGHT * FN_LEVEL_REGION_SIZE);
 
-    if (actor != NULL && fn_level_actor_is_visible(actor)) {
-      if (fn_level_actor_in_foreground(actor)) {
-        fn_level_actor_blit(actor);
-      }
-    }
+  if (x >= FN_LEVEL_REGION_COLUMNS) {
+    x = FN_LEVEL_REGION_COLUMNS - 1;
   }
-
-  /* blit the bots */
-  for (iter = fn_list_first(lv->bots);
-      iter != NULL;
-      iter = fn_list_next(iter)) {
-    fn_bot_t * bot = (fn_bot_t *)iter->data;
-    int x = fn_bot_get_x(bot) / 2;
-    int y = fn_bot_get_y(bot) / 2;
-    if (x > x_start && y > y_start && x < x_end && y < y_end) {
-      fn_bot_blit(bot, lv->surface);
-    }
+  if (y >= FN_LEVEL_REGION_ROWS) {
+    y = FN_LEVEL_REGION_ROWS - 1;
   }
+  actor->region = y * FN_LEVEL_REGION_COLUMNS + x;
+  actor->schedule = FN_LEVEL_SCHEDULE_DORMANT;
+  actor->next_dormant = lv->dormant[actor->region];
+  lv->dormant[actor->region] = actor;
+}
 
-  /* blit the shots */
-  for (iter = fn_list_first(lv->shots);
-      iter != NULL;
-      iter = fn_list_next(iter)) {
-    fn_shot_t * shot = (fn_shot_t *)iter->data;
+/* --------------------------------------------------------------- */
 
-    if (shot != NULL) {
-      Uint16 x = fn_shot_get_x(shot) / FN_TILE_WIDTH;
-      Uint16 y = fn_shot_get_y(shot) / FN_TILE_HEIGHT;
-      if (x > x_start && y > y_start && x < x_end && y < y_end) {
-        fn_shot_blit(shot);
-      } else {
-        fn_shot_gets_out_of_sight(shot);
-      }
+/**
+ * Let an actor act every tick. The active actors stay in the
+ * order they were added, so they act in the same order as if
+ * all actors were walked.
+ *
+ * @param  lv     The level.
+ * @param  actor  The actor.
+ */
+static void fn_level_schedule_wake(fn_level_t * lv,
+    fn_level_actor_t * actor)
+{
+  size_t lo = 0;
+  size_t hi = lv->num_active;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (lv->active[mid]->sequence < actor->sequence) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
 
-  /* blit the whole thing to the caller */
-  SDL_BlitSurface(lv->surface, sourcerect, target, targetrect);
+  if (!fn_level_schedule_push(&(lv->active),
+        &(lv->num_active), &(lv->max_active), actor))
+  {
+    fn_level_schedule_sleep(lv, actor);
+    return;
+  }
+  memmove(&(lv->active[lo + 1]), &(lv->active[lo]),
+      (lv->num_active - 1 - lo) * sizeof(fn_level_actor_t *));
+  lv->active[lo] = actor;
+  actor->schedule = FN_LEVEL_SCHEDULE_ACTIVE;
 }
 
 /* --------------------------------------------------------------- */
 
-SDL_Surface * fn_level_get_surface(fn_level_t * lv)
+/**
+ * Keep a new actor until the visibility is updated.
+ *
+ * @param  lv     The level.
+ * @param  actor  The actor.
+ */
+static void fn_level_schedule_add(fn_level_t * lv,
+    fn_level_actor_t * actor)
 {
-  return lv->surface;
+  actor->next_dormant = NULL;
+  if (fn_level_schedule_push(&(lv->pending),
+        &(lv->num_pending), &(lv->max_pending), actor))
+  {
+    actor->schedule = FN_LEVEL_SCHEDULE_PENDING;
+  } else {
+    fn_level_schedule_sleep(lv, actor);
+  }
 }
 
 /* --------------------------------------------------------------- */
 
-/* TODO this is deprecated! remove it. */
-fn_tilecache_t * fn_level_get_tilecache(fn_level_t * lv)
+/**
+ * Free the actors that are done, after removing them from the
+ * list of actors.
+ *
+ * @param  lv  The level.
+ */
+static void fn_level_free_finished(fn_level_t * lv)
 {
-  return fn_environment_get_tilecache(lv->environment);
+  fn_list_t * iter = NULL;
+
+  for (iter = fn_list_first(lv->actors);
+      iter != NULL;
+      iter = fn_list_next(iter)) {
+    fn_level_actor_t * actor = (fn_level_actor_t *)iter->data;
+    if (actor != NULL &&
+        actor->schedule == FN_LEVEL_SCHEDULE_FINISHED)
+    {
+      fn_level_actor_free(actor); actor = NULL;
+      iter->data = NULL;
+    }
+  }
+  lv->actors = fn_list_remove_all(lv->actors, NULL);
 }
 
 /* --------------------------------------------------------------- */
 
-/* TODO this is deprecated! remove it. */
-Uint8 fn_level_get_pixelsize(fn_level_t * lv)
+/**
+ * Keep the serialized state of the actor of a spawn record the
+ * first time it is created, to compare it with later.
+ *
+ * @param  lv     The level.
+ * @param  index  The index of the spawn record.
+ * @param  actor  The newly created actor.
+ */
+static void fn_level_spawn_keep_initial(fn_level_t * lv,
+    size_t index,
+    fn_level_actor_t * actor)
 {
-  return fn_environment_get_pixelsize(lv->environment);
+  fn_snapshot_t * saved = lv->snapshot;
+  size_t pos = 0;
+
+  if (lv->spawn_initial == NULL) {
+    lv->spawn_initial_pos = calloc(lv->num_spawns, sizeof(size_t));
+    lv->spawn_initial_size = calloc(lv->num_spawns, sizeof(size_t));
+    if (lv->spawn_initial_pos == NULL || lv->spawn_initial_size == NULL) {
+      free(lv->spawn_initial_pos); lv->spawn_initial_pos = NULL;
+      free(lv->spawn_initial_size); lv->spawn_initial_size = NULL;
+      return;
+    }
+    lv->spawn_initial = fn_snapshot_create();
+  }
+  if (lv->spawn_initial_size[index] != 0 ||
+      !fn_level_actor_can_serialize(actor))
+  {
+    return;
+  }
+
+  pos = lv->spawn_initial->size;
+  lv->snapshot = lv->spawn_initial;
+  fn_level_actor_serialize(actor);
+  lv->snapshot = saved;
+  lv->spawn_initial_pos[index] = pos;
+  lv->spawn_initial_size[index] = lv->spawn_initial->size - pos;
 }
 
 /* --------------------------------------------------------------- */
 
-int fn_level_keep_on_playing(fn_level_t * lv) {
-  return lv->do_play;
+/**
+ * Create the actor of a spawn record. It gets the place among the
+ * other actors it would have had if it was created with the level.
+ *
+ * @param  lv     The level.
+ * @param  index  The index of the spawn record.
+ */
+static void fn_level_spawn_create(fn_level_t * lv, size_t index)
+{
+  fn_level_spawn_t * spawn = &(lv->spawns[index]);
+  fn_list_t * iter = NULL;
+  fn_list_t * prev = NULL;
+  fn_level_actor_t * actor = fn_level_actor_create(lv,
+      spawn->type,
+      spawn->x * FN_TILE_WIDTH,
+      spawn->y * FN_TILE_HEIGHT);
+
+  actor->sequence = spawn->sequence;
+  actor->spawn = index;
+  spawn->state = FN_LEVEL_SPAWN_CREATED;
+  fn_level_spawn_keep_initial(lv, index, actor);
+
+  for (iter = fn_list_first(lv->actors);
+      iter != NULL &&
+      ((fn_level_actor_t *)iter->data)->sequence < actor->sequence;
+      iter = fn_list_next(iter)) {
+    prev = iter;
+  }
+  lv->actors = fn_list_insert_after(lv->actors, prev, actor);
+  fn_level_schedule_add(lv, actor);
 }
 
 /* --------------------------------------------------------------- */
 
-fn_hero_t * fn_level_get_hero(fn_level_t * lv) {
-  return fn_environment_get_hero(lv->environment);
+/**
+ * Create the actors of the waiting spawn records of a region.
+ *
+ * @param  lv      The level.
+ * @param  region  The region.
+ */
+static void fn_level_spawn_region_create(fn_level_t * lv, Uint16 region)
+{
+  size_t i = 0;
+
+  for (i = lv->spawn_regions[region];
+      i < lv->spawn_regions[region + 1];
+      i++) {
+    if (lv->spawns[i].state == FN_LEVEL_SPAWN_WAITING) {
+      fn_level_spawn_create(lv, i);
+    }
+  }
 }
 
 /* --------------------------------------------------------------- */
 
-int fn_level_act(fn_level_t * lv) {
+/**
+ * Check if an actor can be turned back into its spawn record,
+ * which is the case if it is in exactly the state it was created
+ * in and nothing refers to it.
+ *
+ * @param  lv     The level.
+ * @param  actor  The actor.
+ *
+ * @return 1 if the actor can be turned back, otherwise 0.
+ */
+static Uint8 fn_level_spawn_is_resumable(fn_level_t * lv,
+    fn_level_actor_t * actor)
+{
+  fn_snapshot_t * saved = lv->snapshot;
+  fn_snapshot_t * scratch = NULL;
+  fn_list_t * iter = NULL;
+  size_t size = 0;
+
+  if (actor->spawn < 0 ||
+      lv->spawn_initial == NULL ||
+      lv->spawn_initial_size[actor->spawn] == 0 ||
+      actor == lv->interactor ||
+      !fn_level_actor_can_serialize(actor))
+  {
+    return 0;
+  }
+  for (iter = fn_list_first(lv->hero->hurtingactors);
+      iter != NULL;
+      iter = fn_list_next(iter)) {
+    if (iter->data == actor) {
+      return 0;
+    }
+  }
+
+  if (lv->spawn_scratch == NULL) {
+    lv->spawn_scratch = fn_snapshot_create();
+  }
+  scratch = lv->spawn_scratch;
+
+  /* compare the actor with the state it was created in */
+  fn_snapshot_clear(scratch);
+  lv->snapshot = scratch;
+  fn_level_actor_serialize(actor);
+  lv->snapshot = saved;
+
+  size = lv->spawn_initial_size[actor->spawn];
+  return (scratch->size == size &&
+      memcmp(scratch->data,
+        lv->spawn_initial->data + lv->spawn_initial_pos[actor->spawn],
+        size) == 0);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Turn the unchanged dormant actors of a region back into their
+ * spawn records. They are marked as finished, the caller frees
+ * them.
+ *
+ * @param  lv      The level.
+ * @param  region  The region.
+ *
+ * @return The number of actors turned back.
+ */
+static size_t fn_level_spawn_region_record(fn_level_t * lv, Uint16 region)
+{
+  fn_level_actor_t ** link = &(lv->dormant[region]);
+  size_t recorded = 0;
+
+  while (*link != NULL) {
+    fn_level_actor_t * actor = *link;
+    if (fn_level_spawn_is_resumable(lv, actor)) {
+      *link = actor->next_dormant;
+      actor->next_dormant = NULL;
+      actor->schedule = FN_LEVEL_SCHEDULE_FINISHED;
+      lv->spawns[actor->spawn].state = FN_LEVEL_SPAWN_WAITING;
+      recorded++;
+    } else {
+      link = &(actor->next_dormant);
+    }
+  }
+  return recorded;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if a region lies inside a rectangle of regions.
+ *
+ * @param  regions  The rectangle, in regions.
+ * @param  rx       The column of the region.
+ * @param  ry       The row of the region.
+ *
+ * @return 1 if the region is inside, otherwise 0.
+ */
+static Uint8 fn_level_region_inside(SDL_Rect * regions, int rx, int ry)
+{
+  return (rx >= regions->x && rx < regions->x + regions->w &&
+      ry >= regions->y && ry < regions->y + regions->h);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_spawn_around(fn_level_t * lv, SDL_Rect * area)
+{
+  int rx_start = area->x / (FN_TILE_WIDTH * FN_LEVEL_REGION_SIZE) - 1;
+  int rx_end = (area->x + area->w) /
+    (FN_TILE_WIDTH * FN_LEVEL_REGION_SIZE) + 1;
+  int ry_start = area->y / (FN_TILE_HEIGHT * FN_LEVEL_REGION_SIZE) - 1;
+  int ry_end = (area->y + area->h) /
+    (FN_TILE_HEIGHT * FN_LEVEL_REGION_SIZE) + 1;
+  int rx = 0;
+  int ry = 0;
+
+  if (rx_start < 0) {
+    rx_start = 0;
+  }
+  if (rx_end >= FN_LEVEL_REGION_COLUMNS) {
+    rx_end = FN_LEVEL_REGION_COLUMNS - 1;
+  }
+  if (ry_start < 0) {
+    ry_start = 0;
+  }
+  if (ry_end >= FN_LEVEL_REGION_ROWS) {
+    ry_end = FN_LEVEL_REGION_ROWS - 1;
+  }
+
+  for (ry = ry_start; ry <= ry_end; ry++) {
+    for (rx = rx_start; rx <= rx_end; rx++) {
+      /* the regions around the view have no waiting records */
+      if (!lv->near_valid ||
+          !fn_level_region_inside(&(lv->near_regions), rx, ry))
+      {
+        fn_level_spawn_region_create(lv,
+            ry * FN_LEVEL_REGION_COLUMNS + rx);
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_schedule_reset(fn_level_t * lv)
+{
+  fn_list_t * iter = NULL;
+
+  lv->num_active = 0;
+  lv->num_pending = 0;
+  lv->near_valid = 0;
+  memset(lv->dormant, 0, sizeof(lv->dormant));
+
+  for (iter = fn_list_first(lv->actors);
+      iter != NULL;
+      iter = fn_list_next(iter)) {
+    if (iter->data != NULL) {
+      fn_level_schedule_add(lv, (fn_level_actor_t *)iter->data);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_update_visibility(fn_level_t * lv, SDL_Rect * view)
+{
+  int x_start = 0;
+  int x_end = FN_LEVEL_WIDTH;
+  int y_start = 0;
+  int y_end = FN_LEVEL_HEIGHT;
+  int rx_start = 0;
+  int rx_end = 0;
+  int ry_start = 0;
+  int ry_end = 0;
+  int rx = 0;
+  int ry = 0;
+  SDL_Rect near;
+  SDL_Rect changed;
+  size_t recorded = 0;
+  size_t kept = 0;
+  size_t i = 0;
+
+  if (view != NULL) {
+    fn_level_get_visible_bounds(view,
+        &x_start, &x_end, &y_start, &y_end);
+  }
+
+  /* the regions around the view, one more on each side catches
+   * the actors reaching into the view */
+  rx_start = x_start / FN_LEVEL_REGION_SIZE - 1;
+  if (rx_start < 0) {
+    rx_start = 0;
+  }
+  rx_end = (x_end - 1) / FN_LEVEL_REGION_SIZE + 1;
+  if (rx_end >= FN_LEVEL_REGION_COLUMNS) {
+    rx_end = FN_LEVEL_REGION_COLUMNS - 1;
+  }
+  ry_start = y_start / FN_LEVEL_REGION_SIZE - 1;
+  if (ry_start < 0) {
+    ry_start = 0;
+  }
+  ry_end = (y_end - 1) / FN_LEVEL_REGION_SIZE + 1;
+  if (ry_end >= FN_LEVEL_REGION_ROWS) {
+    ry_end = FN_LEVEL_REGION_ROWS - 1;
+  }
+  near.x = rx_start;
+  near.y = ry_start;
+  near.w = rx_end - rx_start + 1;
+  near.h = ry_end - ry_start + 1;
+
+  /* the regions that may have come near or gone away since the
+   * last update */
+  if (lv->near_valid) {
+    changed.x = MIN(near.x, lv->near_regions.x);
+    changed.y = MIN(near.y, lv->near_regions.y);
+    changed.w = MAX(near.x + near.w,
+        lv->near_regions.x + lv->near_regions.w) - changed.x;
+    changed.h = MAX(near.y + near.h,
+        lv->near_regions.y + lv->near_regions.h) - changed.y;
+  } else {
+    changed.x = 0;
+    changed.y = 0;
+    changed.w = FN_LEVEL_REGION_COLUMNS;
+    changed.h = FN_LEVEL_REGION_ROWS;
+  }
+
+  /* the active actors that left the view fall asleep */
+  for (i = 0; i < lv->num_active; i++) {
+    fn_level_actor_t * actor = lv->active[i];
+    Uint8 visible = fn_level_actor_in_bounds(actor,
+        x_start, x_end, y_start, y_end);
+
+    fn_level_actor_set_visible(actor, visible);
+    if (visible || actor->acts_while_invisible) {
+      lv->active[kept] = actor;
+      kept++;
+    } else {
+      fn_level_schedule_sleep(lv, actor);
+    }
+  }
+  lv->num_active = kept;
+
+  /* the spawn records of the regions that came near are created,
+   * they are sorted in with the new actors below */
+  for (ry = changed.y; ry < changed.y + changed.h; ry++) {
+    for (rx = changed.x; rx < changed.x + changed.w; rx++) {
+      if (fn_level_region_inside(&near, rx, ry) &&
+          !(lv->near_valid &&
+            fn_level_region_inside(&(lv->near_regions), rx, ry)))
+      {
+        fn_level_spawn_region_create(lv,
+            ry * FN_LEVEL_REGION_COLUMNS + rx);
+      }
+    }
+  }
+
+  /* the dormant actors around the view wake up */
+  for (ry = ry_start; ry <= ry_end; ry++) {
+    for (rx = rx_start; rx <= rx_end; rx++) {
+      fn_level_actor_t ** link =
+        &(lv->dormant[ry * FN_LEVEL_REGION_COLUMNS + rx]);
+
+      while (*link != NULL) {
+        fn_level_actor_t * actor = *link;
+        if (fn_level_actor_in_bounds(actor,
+              x_start, x_end, y_start, y_end))
+        {
+          *link = actor->next_dormant;
+          actor->next_dormant = NULL;
+          fn_level_actor_set_visible(actor, 1);
+          fn_level_schedule_wake(lv, actor);
+        } else {
+          link = &(actor->next_dormant);
+        }
+      }
+    }
+  }
+
+  /* the new actors come after all others */
+  for (i = 0; i < lv->num_pending; i++) {
+    fn_level_actor_t * actor = lv->pending[i];
+    Uint8 visible = fn_level_actor_in_bounds(actor,
+        x_start, x_end, y_start, y_end);
+
+    fn_level_actor_set_visible(actor, visible);
+    if (visible || actor->acts_while_invisible) {
+      fn_level_schedule_wake(lv, actor);
+    } else {
+      fn_level_schedule_sleep(lv, actor);
+    }
+  }
+  lv->num_pending = 0;
+
+  /* the unchanged actors of the regions that went away become
+   * spawn records again */
+  for (ry = changed.y; ry < changed.y + changed.h; ry++) {
+    for (rx = changed.x; rx < changed.x + changed.w; rx++) {
+      if (!fn_level_region_inside(&near, rx, ry) &&
+          (!lv->near_valid ||
+           fn_level_region_inside(&(lv->near_regions), rx, ry)))
+      {
+        recorded += fn_level_spawn_region_record(lv,
+            ry * FN_LEVEL_REGION_COLUMNS + rx);
+      }
+    }
+  }
+  if (recorded > 0) {
+    fn_level_free_finished(lv);
+  }
+
+  lv->near_regions = near;
+  lv->near_valid = 1;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_center_view(fn_level_t * lv, SDL_Rect * view)
+{
+  SDL_Rect * heropos = fn_hero_get_position(fn_level_get_hero(lv));
+  int x = heropos->x + heropos->w / 2 -
+    FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH / 2;
+  int y = heropos->y - FN_LEVEL_HEIGHT * FN_TILE_HEIGHT / 2;
+
+  if (x < 0) {
+    x = 0;
+  }
+  if (y < 0) {
+    y = 0;
+  }
+  if (x + view->w > FN_LEVEL_WIDTH * FN_TILE_WIDTH) {
+    x = FN_LEVEL_WIDTH * FN_TILE_WIDTH - view->w;
+  }
+  if (y + view->h > FN_LEVEL_HEIGHT * FN_TILE_HEIGHT) {
+    y = FN_LEVEL_HEIGHT * FN_TILE_HEIGHT - view->h;
+  }
+  view->x = x;
+  view->y = y;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Compose the static layer, which is the base of every frame,
+ * unless it is still valid. Without a backdrop, it holds the fixed
+ * tiles of the whole level on black, so it is composed once and
+ * again only when the fixed tiles change. The backdrop stays at the
+ * top left corner of the view, so with one the layer only holds
+ * the backdrop in the size of the view, and the fixed tiles are
+ * blitted onto it every frame.
+ *
+ * @param  lv         The level.
+ * @param  area       The visible area of the level, or NULL for
+ *                    the whole level.
+ * @param  backdrop   The backdrop, or NULL for a black one.
+ */
+static void fn_level_update_static(fn_level_t * lv,
+    SDL_Rect * area,
+    FnTexture * backdrop)
+{
+  SDL_Surface * surface = fn_level_get_surface(lv);
+  SDL_PixelFormat * fmt = surface->format;
+  int w = surface->w;
+  int h = surface->h;
+
+  if (backdrop != NULL && area != NULL) {
+    w = area->w;
+    h = area->h;
+  }
+
+  if (lv->static_valid &&
+      lv->static_backdrop == backdrop &&
+      lv->surface_static->w == w && lv->surface_static->h == h)
+  {
+    return;
+  }
+
+  if (lv->surface_static != NULL &&
+      (lv->surface_static->w != w || lv->surface_static->h != h))
+  {
+    SDL_FreeSurface(lv->surface_static);
+    lv->surface_static = NULL;
+  }
+  if (lv->surface_static == NULL) {
+    /* no colour key, so copying it is a plain copy */
+    lv->surface_static = SDL_CreateRGBSurface(SDL_SWSURFACE,
+        w, h, fmt->BitsPerPixel,
+        fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+    if (fmt->palette != NULL) {
+      SDL_SetColors(lv->surface_static,
+          fmt->palette->colors, 0, fmt->palette->ncolors);
+    }
+  }
+
+  SDL_FillRect(lv->surface_static, NULL, 0);
+  if (backdrop != NULL) {
+    fn_texture_blit_to_sdl_surface(
+        backdrop, NULL, lv->surface_static, NULL);
+  } else {
+    SDL_BlitSurface(fn_texture_get_sdl_surface(lv->texture_fixed), NULL,
+        lv->surface_static, NULL);
+  }
+
+  lv->static_backdrop = backdrop;
+  lv->static_valid = 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Append a draw command to the current frame.
+ *
+ * @param  lv     The level.
+ *
+ * @return The new command, or NULL if there is no memory for it.
+ */
+static fn_level_draw_t * fn_level_draw_add(fn_level_t * lv)
+{
+  if (lv->num_draws == lv->max_draws) {
+    size_t max = (lv->max_draws == 0) ? 256 : lv->max_draws * 2;
+    fn_level_draw_t * draws = realloc(lv->draws,
+        max * sizeof(fn_level_draw_t));
+    fn_level_draw_t * sorted = realloc(lv->draws_sorted,
+        max * sizeof(fn_level_draw_t));
+    if (draws != NULL) {
+      lv->draws = draws;
+    }
+    if (sorted != NULL) {
+      lv->draws_sorted = sorted;
+    }
+    if (draws == NULL || sorted == NULL) {
+      fprintf(stderr, "Could not allocate memory for draw commands.\n");
+      return NULL;
+    }
+    lv->max_draws = max;
+  }
+  fn_level_draw_t * draw = &(lv->draws[lv->num_draws]);
+  lv->num_draws++;
+  return draw;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Append a draw command of any kind to the current frame.
+ */
+static void fn_level_draw(fn_level_t * lv,
+    fn_level_draw_kind_e kind,
+    Uint16 tile,
+    int x,
+    int y,
+    int w,
+    int h,
+    fn_level_layer_e layer)
+{
+  fn_level_draw_t * draw = fn_level_draw_add(lv);
+  if (draw == NULL) {
+    return;
+  }
+  draw->x = x;
+  draw->y = y;
+  draw->w = w;
+  draw->h = h;
+  draw->tile = tile;
+  draw->layer = layer;
+  draw->kind = kind;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_draw_tile(fn_level_t * lv,
+    Uint16 tile,
+    int x,
+    int y,
+    fn_level_layer_e layer)
+{
+  fn_level_draw(lv, FN_LEVEL_DRAW_TILE, tile,
+      x, y, FN_TILE_WIDTH, FN_TILE_HEIGHT, layer);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_draw_fill(fn_level_t * lv,
+    int x,
+    int y,
+    int w,
+    int h,
+    fn_level_layer_e layer)
+{
+  fn_level_draw(lv, FN_LEVEL_DRAW_FILL, 0, x, y, w, h, layer);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_draw_bounds(fn_level_t * lv,
+    int x,
+    int y,
+    int w,
+    int h,
+    fn_level_layer_e layer)
+{
+  fn_level_draw(lv, FN_LEVEL_DRAW_BOUNDS, 0, x, y, w, h, layer);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Fill a rectangle of the level surface with black. This goes
+ * through fn_level_blit_surface, so it can be recorded.
+ *
+ * @param  lv       The level.
+ * @param  dstrect  The rectangle on the level surface.
+ */
+static void fn_level_fill_black(fn_level_t * lv, SDL_Rect * dstrect)
+{
+  SDL_PixelFormat * fmt = fn_level_get_surface(lv)->format;
+  Uint8 pixelsize = fn_level_get_pixelsize(lv);
+  SDL_Rect srcrect;
+  SDL_Rect r;
+  int x = 0;
+  int y = 0;
+
+  if (lv->surface_blank == NULL) {
+    lv->surface_blank = SDL_CreateRGBSurface(SDL_SWSURFACE,
+        2 * FN_TILE_WIDTH * pixelsize, 2 * FN_TILE_HEIGHT * pixelsize,
+        fmt->BitsPerPixel,
+        fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+    if (lv->surface_blank == NULL) {
+      return;
+    }
+    if (fmt->palette != NULL) {
+      SDL_SetColors(lv->surface_blank,
+          fmt->palette->colors, 0, fmt->palette->ncolors);
+    }
+    SDL_FillRect(lv->surface_blank, NULL, 0);
+  }
+
+  /* larger rectangles are covered piece by piece */
+  for (y = 0; y < dstrect->h; y += lv->surface_blank->h) {
+    for (x = 0; x < dstrect->w; x += lv->surface_blank->w) {
+      srcrect.x = 0;
+      srcrect.y = 0;
+      srcrect.w = dstrect->w - x;
+      srcrect.h = dstrect->h - y;
+      if (srcrect.w > lv->surface_blank->w) {
+        srcrect.w = lv->surface_blank->w;
+      }
+      if (srcrect.h > lv->surface_blank->h) {
+        srcrect.h = lv->surface_blank->h;
+      }
+      r.x = dstrect->x + x;
+      r.y = dstrect->y + y;
+      fn_level_blit_surface(lv, lv->surface_blank, &srcrect, &r);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Execute the draw commands of the current frame. The commands
+ * outside of the view are dropped, the others are sorted by layer
+ * and drawn in the order they were issued within each layer.
+ *
+ * @param  lv    The level.
+ * @param  view  The visible part of the level in level pixels, or
+ *               NULL for the whole level.
+ */
+static void fn_level_draw_commands(fn_level_t * lv, SDL_Rect * view)
+{
+  size_t start[FN_LEVEL_NUM_LAYERS];
+  size_t count[FN_LEVEL_NUM_LAYERS];
+  size_t num = 0;
+  size_t i = 0;
+  fn_environment_t * env = fn_level_get_environment(lv);
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+  SDL_Surface * surface = fn_level_get_surface(lv);
+  SDL_Rect dstrect;
+
+  memset(count, 0, sizeof(count));
+
+  /* cull, and count the commands on each layer */
+  for (i = 0; i < lv->num_draws; i++) {
+    fn_level_draw_t * draw = &(lv->draws[i]);
+    if (view != NULL &&
+        (draw->x + draw->w <= view->x ||
+         draw->y + draw->h <= view->y ||
+         draw->x >= view->x + view->w ||
+         draw->y >= view->y + view->h))
+    {
+      draw->layer = FN_LEVEL_NUM_LAYERS;
+      continue;
+    }
+    count[draw->layer]++;
+  }
+
+  for (i = 0; i < FN_LEVEL_NUM_LAYERS; i++) {
+    start[i] = num;
+    num += count[i];
+  }
+  for (i = 0; i < lv->num_draws; i++) {
+    fn_level_draw_t * draw = &(lv->draws[i]);
+    if (draw->layer < FN_LEVEL_NUM_LAYERS) {
+      lv->draws_sorted[start[draw->layer]] = *draw;
+      start[draw->layer]++;
+    }
+  }
+
+  for (i = 0; i < num; i++) {
+    fn_level_draw_t * draw = &(lv->draws_sorted[i]);
+    dstrect.x = draw->x * pixelsize;
+    dstrect.y = draw->y * pixelsize;
+    dstrect.w = draw->w * pixelsize;
+    dstrect.h = draw->h * pixelsize;
+    switch (draw->kind) {
+      case FN_LEVEL_DRAW_TILE:
+        fn_texture_blit_to_sdl_surface(
+            fn_environment_get_tile(env, draw->tile),
+            NULL, surface, &dstrect);
+        break;
+      case FN_LEVEL_DRAW_FILL:
+        fn_level_fill_black(lv, &dstrect);
+        break;
+      case FN_LEVEL_DRAW_BOUNDS:
+        fn_collision_area_draw(surface, pixelsize,
+            draw->x, draw->y, draw->w, draw->h);
+        break;
+    }
+  }
+
+  lv->num_draws = 0;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw the animated background tiles inside an area. The frame of
+ * each one is derived from the ticks of the level.
+ *
+ * @param  lv       The level.
+ * @param  x_start  The first column.
+ * @param  x_end    The column after the last one.
+ * @param  y_start  The first row.
+ * @param  y_end    The row after the last one.
+ */
+static void fn_level_draw_animations(fn_level_t * lv,
+    int x_start, int x_end,
+    int y_start, int y_end)
+{
+  size_t i = 0;
+
+  if (y_start < 0) {
+    y_start = 0;
+  }
+  if (y_end > FN_LEVEL_HEIGHT) {
+    y_end = FN_LEVEL_HEIGHT;
+  }
+  if (y_end <= y_start) {
+    return;
+  }
+
+  /* the rows are in order, so only the visible ones are walked */
+  for (i = lv->animation_rows[y_start];
+      i < lv->animation_rows[y_end];
+      i++)
+  {
+    fn_level_animation_t * animation = &(lv->animations[i]);
+    if (animation->x >= x_start && animation->x < x_end) {
+      fn_level_draw_tile(lv,
+          animation->tile + lv->ticks % animation->num_frames,
+          animation->x * FN_TILE_WIDTH,
+          animation->y * FN_TILE_HEIGHT,
+          FN_LEVEL_LAYER_BACKGROUND);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Compose the current state of the level on the texture of the
+ * level.
+ *
+ * @param  lv          The level.
+ * @param  sourcerect  The visible area, scaled by the pixel size,
+ *                     or NULL for the whole level.
+ * @param  backdrop1   The first backdrop type.
+ * @param  backdrop2   The second backdrop type.
+ */
+static void fn_level_render(fn_level_t * lv,
+    SDL_Rect * sourcerect,
+    FnTexture * backdrop1,
+    FnTexture * backdrop2)
+{
+  int x_start = 0;
+  int x_end = FN_LEVEL_WIDTH;
+  int y_start = 0;
+  int y_end = FN_LEVEL_HEIGHT;
+  SDL_Rect r;
+  SDL_Rect view;
+  fn_list_t * iter = NULL;
+  size_t i = 0;
+
+  fn_environment_t * env = fn_level_get_environment(lv);
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+  SDL_Surface * surface = fn_level_get_surface(lv);
+
+  /* with several threads, the blits are only recorded here and
+   * rendered in bands at the end; the collision bounds are drawn
+   * directly, so they need the blits to be done right away */
+  lv->recording = (fn_drawlist_get_threads() > 1 &&
+      !fn_environment_get_draw_collision_bounds(env));
+  if (lv->recording) {
+    if (lv->drawlist == NULL) {
+      lv->drawlist = fn_drawlist_create();
+    }
+    fn_drawlist_begin(lv->drawlist, surface);
+    fn_texture_set_draw_list(lv->drawlist);
+  }
+
+  /* the backdrop and the fixed tiles, in one opaque copy */
+  FN_PROFILE_BEGIN(FN_PROFILE_STATIC_BLIT);
+  fn_level_update_static(lv, sourcerect, backdrop1);
+  r.x = (sourcerect != NULL) ? sourcerect->x : 0;
+  r.y = (sourcerect != NULL) ? sourcerect->y : 0;
+  if (backdrop1 == NULL) {
+    /* the view out of the layer of the whole level */
+    fn_level_blit_surface(lv, lv->surface_static, sourcerect, &r);
+  } else {
+    fn_level_blit_surface(lv, lv->surface_static, NULL, &r);
+    r.x = (sourcerect != NULL) ? sourcerect->x : 0;
+    r.y = (sourcerect != NULL) ? sourcerect->y : 0;
+    fn_level_blit_surface(lv,
+        fn_texture_get_sdl_surface(lv->texture_fixed), sourcerect, &r);
+  }
+  FN_PROFILE_END(FN_PROFILE_STATIC_BLIT);
+
+  /* calculate the bounds of the area we have to blit. */
+  if (sourcerect) {
+    view.x = sourcerect->x / pixelsize;
+    view.y = sourcerect->y / pixelsize;
+    view.w = sourcerect->w / pixelsize;
+    view.h = sourcerect->h / pixelsize;
+    fn_level_get_visible_bounds(&view,
+        &x_start, &x_end, &y_start, &y_end);
+  }
+  fn_level_update_visibility(lv, sourcerect ? &view : NULL);
+
+  fn_hero_t * hero = fn_level_get_hero(lv);
+
+  lv->num_draws = 0;
+
+  /* the animated background tiles, behind all actors */
+  FN_PROFILE_BEGIN(FN_PROFILE_ACTOR_BLIT);
+  fn_level_draw_animations(lv, x_start, x_end, y_start, y_end);
+  FN_PROFILE_END(FN_PROFILE_ACTOR_BLIT);
+
+  /* the actors only issue draw commands, they end up in front of
+   * or behind the hero by their layer */
+  FN_PROFILE_BEGIN(FN_PROFILE_ACTOR_BLIT);
+  for (i = 0; i < lv->num_active; i++) {
+    fn_level_actor_t * actor = lv->active[i];
+
+    if (fn_level_actor_is_visible(actor)) {
+      fn_level_actor_blit(actor);
+    }
+  }
+  FN_PROFILE_END(FN_PROFILE_ACTOR_BLIT);
+
+  /* blit the hero */
+  FN_PROFILE_BEGIN(FN_PROFILE_HERO_BLIT);
+  fn_hero_blit(hero,
+      surface,
+      lv);
+  FN_PROFILE_END(FN_PROFILE_HERO_BLIT);
+
+  /* blit the bots */
+  FN_PROFILE_BEGIN(FN_PROFILE_ACTOR_BLIT);
+  for (iter = fn_list_first(lv->bots);
+      iter != NULL;
+      iter = fn_list_next(iter)) {
+    fn_bot_t * bot = (fn_bot_t *)iter->data;
+    int x = fn_bot_get_x(bot) / 2;
+    int y = fn_bot_get_y(bot) / 2;
+    if (x > x_start && y > y_start && x < x_end && y < y_end) {
+      fn_bot_blit(bot, lv);
+    }
+  }
+
+  /* blit the shots */
+  for (iter = fn_list_first(lv->shots);
+      iter != NULL;
+      iter = fn_list_next(iter)) {
+    fn_shot_t * shot = (fn_shot_t *)iter->data;
+
+    if (shot != NULL) {
+      Uint16 x = fn_shot_get_x(shot) / FN_TILE_WIDTH;
+      Uint16 y = fn_shot_get_y(shot) / FN_TILE_HEIGHT;
+      if (x > x_start && y > y_start && x < x_end && y < y_end) {
+        fn_shot_blit(shot);
+      } else {
+        fn_shot_gets_out_of_sight(shot);
+      }
+    }
+  }
+  FN_PROFILE_END(FN_PROFILE_ACTOR_BLIT);
+
+  FN_PROFILE_BEGIN(FN_PROFILE_RASTER);
+  fn_level_draw_commands(lv, sourcerect ? &view : NULL);
+  if (lv->recording) {
+    fn_texture_set_draw_list(NULL);
+    lv->recording = 0;
+    fn_drawlist_render(lv->drawlist, sourcerect);
+  }
+  FN_PROFILE_END(FN_PROFILE_RASTER);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_blit_to_surface(fn_level_t * lv,
+    SDL_Surface * target,
+    SDL_Rect * targetrect,
+    SDL_Rect * sourcerect,
+    FnTexture * backdrop1,
+    FnTexture * backdrop2)
+{
+  fn_level_render(lv, sourcerect, backdrop1, backdrop2);
+
+  /* blit the whole thing to the caller */
+  SDL_BlitSurface(fn_level_get_surface(lv), sourcerect,
+      target, targetrect);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_blit_to_texture(
+    fn_level_t * lv,
+    FnTexture * texture,
+    FnGeometry * targetrect,
+    FnGeometry * sourcerect,
+    FnTexture * backdrop1,
+    FnTexture * backdrop2)
+{
+  Uint8 pixelsize = fn_level_get_pixelsize(lv);
+  SDL_Rect source;
+  FnRect src;
+  FnRect dst;
+
+  if (sourcerect != NULL) {
+    fn_geometry_get_rect(sourcerect, &src);
+    src.x *= pixelsize;
+    src.y *= pixelsize;
+    src.width *= pixelsize;
+    src.height *= pixelsize;
+    source.x = src.x;
+    source.y = src.y;
+    source.w = src.width;
+    source.h = src.height;
+  }
+  if (targetrect != NULL) {
+    fn_geometry_get_rect(targetrect, &dst);
+    dst.x *= pixelsize;
+    dst.y *= pixelsize;
+    dst.width *= pixelsize;
+    dst.height *= pixelsize;
+  }
+
+  fn_level_render(lv, sourcerect != NULL ? &source : NULL,
+      backdrop1, backdrop2);
+
+  /* the texture of the level has no colour key, so this copies */
+  fn_texture_clone_rect(lv->texture,
+      sourcerect != NULL ? &src : NULL,
+      texture,
+      targetrect != NULL ? &dst : NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_blit_surface(fn_level_t * lv,
+    SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * dstrect)
+{
+  if (lv->recording) {
+    fn_drawlist_blit(lv->drawlist, src, srcrect, dstrect);
+  } else {
+    SDL_BlitSurface(src, srcrect, fn_level_get_surface(lv), dstrect);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+SDL_Surface * fn_level_get_surface(fn_level_t * lv)
+{
+  return fn_texture_get_sdl_surface(lv->texture);
+}
+
+/* --------------------------------------------------------------- */
+
+/* TODO this is deprecated! remove it. */
+fn_tilecache_t * fn_level_get_tilecache(fn_level_t * lv)
+{
+  return lv->tilecache;
+}
+
+/* --------------------------------------------------------------- */
+
+/* TODO this is deprecated! remove it. */
+Uint8 fn_level_get_pixelsize(fn_level_t * lv)
+{
+  return fn_environment_get_pixelsize(lv->environment);
+}
+
+/* --------------------------------------------------------------- */
+
+int fn_level_keep_on_playing(fn_level_t * lv) {
+  return lv->do_play;
+}
+
+/* --------------------------------------------------------------- */
+
+fn_hero_t * fn_level_get_hero(fn_level_t * lv) {
+  return lv->hero;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_set_seed(fn_level_t * lv, Uint32 seed)
+{
+  lv->seed = seed;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint16 fn_level_random(fn_level_t * lv)
+{
+  lv->seed = lv->seed * 1103515245 + 12345;
+  return (lv->seed >> 16) & 0x7FFF;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_apply_input(fn_level_t * lv,
+    Uint8 previous,
+    Uint8 current)
+{
+  fn_hero_t * hero = fn_level_get_hero(lv);
+  Uint8 pressed = current & ~previous;
+  Uint8 released = previous & ~current;
+
+  if (released & FNK_LEFT_ENABLED) {
+    if (current & FNK_RIGHT_ENABLED) {
+      fn_hero_set_direction(hero,
+          fn_horizontal_direction_right);
+      fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
+    } else {
+      fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+    }
+    fn_hero_update_animation(hero);
+  }
+  if (released & FNK_RIGHT_ENABLED) {
+    if (current & FNK_LEFT_ENABLED) {
+      fn_hero_set_direction(hero,
+          fn_horizontal_direction_left);
+      fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
+    } else {
+      fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+    }
+  }
+  if (pressed & FNK_LEFT_ENABLED) {
+    if (current & FNK_RIGHT_ENABLED) {
+      fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+    } else {
+      fn_hero_set_direction(hero,
+          fn_horizontal_direction_left);
+      fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
+    }
+    fn_hero_update_animation(hero);
+  }
+  if (pressed & FNK_RIGHT_ENABLED) {
+    if (current & FNK_LEFT_ENABLED) {
+      fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+    } else {
+      fn_hero_set_direction(hero,
+          fn_horizontal_direction_right);
+      fn_hero_set_motion(hero, FN_HERO_MOTION_WALKING);
+    }
+    fn_hero_update_animation(hero);
+  }
+  if (pressed & FNK_JUMP_ENABLED) {
+    fn_hero_set_flying(hero, FN_HERO_FLYING_TRUE);
+    fn_hero_update_animation(hero);
+  }
+  if (pressed & FNK_FIRE_ENABLED) {
+    fn_hero_fire_start(hero);
+    fn_level_fire_shot(lv);
+    fn_hero_update_animation(hero);
+  }
+  if (released & FNK_FIRE_ENABLED) {
+    fn_hero_fire_stop(hero);
+    fn_hero_update_animation(hero);
+  }
+  if (pressed & FNK_INTERACT_ENABLED) {
+    fn_level_hero_interact_start(lv);
+  }
+  if (released & FNK_INTERACT_ENABLED) {
+    fn_level_hero_interact_stop(lv);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+int fn_level_act(fn_level_t * lv) {
   fn_list_t * iter = NULL;
   int res = 0;
   int cleanup = 0;
+  size_t kept = 0;
+  size_t i = 0;
 
-  fn_hero_t * hero = fn_environment_get_hero(lv->environment);
+  fn_hero_t * hero = fn_level_get_hero(lv);
 
+  lv->ticks++;
   lv->animated_frames ++;
   lv->animated_frames %= 1;
+  FN_PROFILE_BEGIN(FN_PROFILE_HERO);
   if (lv->animated_frames == 0) {
     /* do some action, not just animation */
     fn_hero_act(hero, lv);
   }
+  FN_PROFILE_END(FN_PROFILE_HERO);
 
+  FN_PROFILE_BEGIN(FN_PROFILE_SHOTS);
   for (iter = fn_list_first(lv->shots);
       iter != NULL;
       iter = fn_list_next(iter)) {
@@ -1097,34 +2486,53 @@ int fn_level_act(fn_level_t * lv) {
     cleanup = 0;
     lv->shots = fn_list_remove_all(lv->shots, NULL);
   }
+  FN_PROFILE_END(FN_PROFILE_SHOTS);
 
   int sum = 0;
 
-  for (iter = fn_list_first(lv->actors);
-      iter != NULL;
-      iter = fn_list_next(iter)) {
-    fn_level_actor_t * actor = (fn_level_actor_t *)iter->data;
+  FN_PROFILE_BEGIN(FN_PROFILE_ACTORS);
 
-    if  (actor->acts_while_invisible || actor->is_visible) {
-      sum++;
-      res = fn_level_actor_act(actor);
-      if (res == 0) {
-        /* set the cleanup flag and free the memory */
-        cleanup = 1;
-        iter->data = NULL;
-        fn_level_actor_free(actor); actor = NULL;
-      }
+  /* only the active actors are visible or act while invisible,
+   * the dormant ones are not even looked at */
+  for (i = 0; i < lv->num_active; i++) {
+    fn_level_actor_t * actor = lv->active[i];
+
+    sum++;
+    res = fn_level_actor_act(actor);
+    if (res == 0) {
+      /* set the cleanup flag, the memory is freed below */
+      cleanup = 1;
+      actor->schedule = FN_LEVEL_SCHEDULE_FINISHED;
     }
   }
 
   if (cleanup) {
     /* clean up the actors that are finished */
     cleanup = 0;
-    lv->actors = fn_list_remove_all(lv->actors, NULL);
+    kept = 0;
+    for (i = 0; i < lv->num_active; i++) {
+      fn_level_actor_t * actor = lv->active[i];
+      if (actor->schedule != FN_LEVEL_SCHEDULE_FINISHED) {
+        lv->active[kept] = actor;
+        kept++;
+      }
+    }
+    lv->num_active = kept;
+    fn_level_free_finished(lv);
+  }
+  FN_PROFILE_END(FN_PROFILE_ACTORS);
+
+  if (hero->events & (1 << fn_event_herolanded)) {
+    hero->events &= ~(1 << fn_event_herolanded);
+    fn_level_add_actor(lv, FN_LEVEL_ACTOR_DUSTCLOUD,
+        fn_hero_get_x(hero),
+        fn_hero_get_y(hero) + FN_TILE_HEIGHT);
   }
 
+  FN_PROFILE_BEGIN(FN_PROFILE_HERO);
   fn_hero_next_animationframe(hero);
   fn_hero_update_animation(hero);
+  FN_PROFILE_END(FN_PROFILE_HERO);
 
   return 1;
 };
@@ -1176,6 +2584,9 @@ fn_level_actor_t * fn_level_add_actor(fn_level_t * lv,
 {
   fn_level_actor_t * actor = fn_level_actor_create(lv, type, x, y);
   lv->actors = fn_list_append(lv->actors, actor);
+  actor->sequence = lv->next_sequence;
+  lv->next_sequence++;
+  fn_level_schedule_add(lv, actor);
 
   return actor;
 }
@@ -1187,6 +2598,12 @@ fn_level_actor_t * fn_level_add_initial_actor(fn_level_t * lv,
     Uint16 x,
     Uint16 y)
 {
+  if (fn_level_spawns_lazily(type) &&
+      fn_level_add_spawn(lv, type, x, y))
+  {
+    return NULL;
+  }
+
   fn_level_actor_t * actor = fn_level_add_actor(
       lv,
       type,
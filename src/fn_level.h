@@ -47,6 +47,162 @@ typedef struct fn_level_t fn_level_t;
 #include "fn_list.h"
 #include "fn_environment.h"
 #include "fntexture.h"
+#include "fn_snapshot.h"
+#include "fn_drawlist.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The size in tiles of the regions in which dormant actors wait,
+ * and the number of regions in a level.
+ */
+#define FN_LEVEL_REGION_SIZE 8
+#define FN_LEVEL_REGION_COLUMNS \
+  ((FN_LEVEL_WIDTH + FN_LEVEL_REGION_SIZE - 1) / FN_LEVEL_REGION_SIZE)
+#define FN_LEVEL_REGION_ROWS \
+  ((FN_LEVEL_HEIGHT + FN_LEVEL_REGION_SIZE - 1) / FN_LEVEL_REGION_SIZE)
+#define FN_LEVEL_NUM_REGIONS \
+  (FN_LEVEL_REGION_COLUMNS * FN_LEVEL_REGION_ROWS)
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Where the scheduler of a level keeps an actor.
+ */
+typedef enum fn_level_schedule_e {
+  /**
+   * Added since the visibility was last updated.
+   */
+  FN_LEVEL_SCHEDULE_PENDING,
+
+  /**
+   * Visible or acting while invisible, so it acts every tick.
+   */
+  FN_LEVEL_SCHEDULE_ACTIVE,
+
+  /**
+   * Far from the view, waiting in its region.
+   */
+  FN_LEVEL_SCHEDULE_DORMANT,
+
+  /**
+   * Done acting, freed at the end of the tick.
+   */
+  FN_LEVEL_SCHEDULE_FINISHED
+} fn_level_schedule_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The layers of a frame, drawn from the first to the last.
+ */
+typedef enum fn_level_layer_e {
+  FN_LEVEL_LAYER_BACKGROUND,
+  FN_LEVEL_LAYER_HERO,
+  FN_LEVEL_LAYER_FOREGROUND,
+  FN_LEVEL_NUM_LAYERS
+} fn_level_layer_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The kinds of draw commands.
+ */
+typedef enum fn_level_draw_kind_e {
+  /**
+   * Draw a tile.
+   */
+  FN_LEVEL_DRAW_TILE,
+
+  /**
+   * Fill a rectangle with black.
+   */
+  FN_LEVEL_DRAW_FILL,
+
+  /**
+   * Draw the outline of a collision area.
+   */
+  FN_LEVEL_DRAW_BOUNDS
+} fn_level_draw_kind_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A draw command. The position and size are in level pixels,
+ * without the pixelsize applied.
+ */
+typedef struct fn_level_draw_t {
+  Sint16 x;
+  Sint16 y;
+  Uint16 w;
+  Uint16 h;
+  Uint16 tile;
+  Uint8 layer;
+  Uint8 kind;
+} fn_level_draw_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A background tile whose look only depends on the time. It shows
+ * the frame (ticks % num_frames) of the tiles lined up in a row in
+ * the tilecache, starting at tile.
+ */
+typedef struct fn_level_animation_t {
+  Uint8 x;
+  Uint8 y;
+  Uint16 tile;
+  Uint8 num_frames;
+} fn_level_animation_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The states of a spawn record.
+ */
+typedef enum fn_level_spawn_state_e {
+  /**
+   * The actor does not exist, it is created once the view comes
+   * near.
+   */
+  FN_LEVEL_SPAWN_WAITING,
+
+  /**
+   * The actor was created. It is turned back into the record if
+   * it is left unchanged far from the view.
+   */
+  FN_LEVEL_SPAWN_CREATED
+} fn_level_spawn_state_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * An actor of the level file that is only created once the view
+ * comes near it.
+ */
+typedef struct fn_level_spawn_t {
+  /**
+   * The tile of the top left corner.
+   */
+  Uint8 x;
+  Uint8 y;
+
+  /**
+   * The actor type, one of fn_level_actor_type_e.
+   */
+  Uint8 type;
+
+  /**
+   * One of fn_level_spawn_state_e.
+   */
+  Uint8 state;
+
+  /**
+   * The sequence number the actor is created with, which keeps
+   * its place among the actors loaded with the level.
+   */
+  Uint16 sequence;
+} fn_level_spawn_t;
 
 /* --------------------------------------------------------------- */
 
@@ -79,6 +235,63 @@ struct fn_level_t {
    */
   FnTexture * texture;
 
+  /**
+   * The opaque base of every frame: the fixed tiles of the whole
+   * level on black, or the backdrop in the size of the view.
+   */
+  SDL_Surface * surface_static;
+
+  /**
+   * The backdrop surface_static was composed with.
+   */
+  FnTexture * static_backdrop;
+
+  /**
+   * Non-zero while surface_static matches the fixed tiles and the
+   * backdrop.
+   */
+  Uint8 static_valid;
+
+  /**
+   * The blits of a frame, recorded while the level is blitted and
+   * rendered in bands by several threads afterwards.
+   */
+  fn_drawlist_t * drawlist;
+
+  /**
+   * Non-zero while the blits onto the level are recorded.
+   */
+  Uint8 recording;
+
+  /**
+   * The draw commands of the current frame in the order they were
+   * issued, and the same commands sorted by layer.
+   */
+  fn_level_draw_t * draws;
+  fn_level_draw_t * draws_sorted;
+  size_t num_draws;
+  size_t max_draws;
+
+  /**
+   * A black surface to draw the fill commands with.
+   */
+  SDL_Surface * surface_blank;
+
+  /**
+   * The animated background tiles, row by row, and the index of
+   * the first one of each row. They are not actors, so they
+   * neither act nor are kept in snapshots.
+   */
+  fn_level_animation_t * animations;
+  size_t num_animations;
+  size_t max_animations;
+  Uint16 animation_rows[FN_LEVEL_HEIGHT + 1];
+
+  /**
+   * The number of times the level has acted.
+   */
+  Uint32 ticks;
+
   /**
    * The environment in which the level runs.
    */
@@ -89,6 +302,57 @@ struct fn_level_t {
    */
   fn_list_t * actors;
 
+  /**
+   * The actors that act every tick, in the order they were added,
+   * the actors added since the last visibility update, and the
+   * dormant actors of each region. Together they hold every actor
+   * of the list above.
+   */
+  fn_level_actor_t ** active;
+  size_t num_active;
+  size_t max_active;
+  fn_level_actor_t ** pending;
+  size_t num_pending;
+  size_t max_pending;
+  fn_level_actor_t * dormant[FN_LEVEL_NUM_REGIONS];
+
+  /**
+   * The sequence number of the next added actor.
+   */
+  Uint32 next_sequence;
+
+  /**
+   * The spawn records of the level, region by region, and the
+   * index of the first record of each region.
+   */
+  fn_level_spawn_t * spawns;
+  size_t num_spawns;
+  size_t max_spawns;
+  Uint16 spawn_regions[FN_LEVEL_NUM_REGIONS + 1];
+
+  /**
+   * The regions around the view in which the records were
+   * created at the last visibility update. Only valid while
+   * near_valid is non-zero.
+   */
+  SDL_Rect near_regions;
+  Uint8 near_valid;
+
+  /**
+   * A snapshot to compare the state of actors in.
+   */
+  fn_snapshot_t * spawn_scratch;
+
+  /**
+   * The serialized state each spawn record's actor had when it was
+   * first created, and where it lies inside spawn_initial. A size
+   * of 0 means the actor was not created yet. These are kept apart
+   * from the records, which are stored in snapshots.
+   */
+  fn_snapshot_t * spawn_initial;
+  size_t * spawn_initial_pos;
+  size_t * spawn_initial_size;
+
   /**
    * The shots inside the level.
    */
@@ -124,6 +388,28 @@ struct fn_level_t {
    * The actor with which the hero interacts.
    */
   fn_level_actor_t * interactor;
+
+  /**
+   * The snapshot which is currently written or read. Only set
+   * while a snapshot of the level is saved or restored.
+   */
+  fn_snapshot_t * snapshot;
+
+  /**
+   * The hero playing the level.
+   */
+  fn_hero_t * hero;
+
+  /**
+   * The tiles used by the level. They are shared between all
+   * levels and never changed while playing.
+   */
+  fn_tilecache_t * tilecache;
+
+  /**
+   * The state of the random number generator of the level.
+   */
+  Uint32 seed;
 };
 
 /* --------------------------------------------------------------- */
@@ -143,6 +429,42 @@ fn_level_t * fn_level_load(int fd,
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Load a level from a file for a hero that is not the one of
+ * the environment. The level only reads from the environment,
+ * so several levels loaded this way can be played at once.
+ *
+ * @param  fd    An already opened file descriptor to the level file.
+ * @param  env   The environment of the game.
+ * @param  hero  The hero playing the level.
+ *
+ * @return  The fully loaded level, or NULL on failure.
+ */
+fn_level_t * fn_level_load_with_hero(int fd,
+    fn_environment_t * env,
+    fn_hero_t * hero);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Load a level like fn_level_load_with_hero, but only to play it
+ * without showing it. It has no textures and can not be blitted.
+ * Drawing the fixed tiles blits from the tiles of the environment,
+ * which is not safe on several threads at once, so this is the way
+ * to load levels on several threads.
+ *
+ * @param  fd    An already opened file descriptor to the level file.
+ * @param  env   The environment of the game.
+ * @param  hero  The hero playing the level.
+ *
+ * @return  The loaded level, or NULL on failure.
+ */
+fn_level_t * fn_level_load_headless(int fd,
+    fn_environment_t * env,
+    fn_hero_t * hero);
+
+/* --------------------------------------------------------------- */
+
 /**
  * Destroy a level.
  *
@@ -219,13 +541,47 @@ void fn_level_set_solid(fn_level_t * lv, int x, int y, Uint8 solid);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Draw the tiles that never change into the fixed layer of the
+ * level. This is done when the level is loaded, and has to be
+ * done again whenever one of the fixed tiles changes, which also
+ * composes the static layer anew on the next blit.
+ *
+ * @param  lv  The level.
+ */
+void fn_level_blit_fixed(fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
 /**
  * Blit the current state of the level to an SDL Surface.
  *
  * @param  lv         The level to blit.
- * @param  target     The target texture.
+ * @param  target     The target surface.
  * @param  targetrect The target area to which to blit.
- * @param  sourcerect The source rectangle.
+ * @param  sourcerect The source rectangle, scaled by the pixel size.
+ * @param  backdrop1  The first backdrop type.
+ * @param  backdrop2  The second backdrop type.
+ */
+void fn_level_blit_to_surface(fn_level_t * lv,
+    SDL_Surface * target,
+    SDL_Rect * targetrect,
+    SDL_Rect * sourcerect,
+    FnTexture * backdrop1,
+    FnTexture * backdrop2);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit the current state of the level to a texture. The
+ * rectangles are in level pixels and scaled by the pixel size.
+ *
+ * @param  lv         The level to blit.
+ * @param  texture    The target texture.
+ * @param  targetrect The target area to which to blit, or NULL for
+ *                    the top left corner.
+ * @param  sourcerect The source rectangle, or NULL for the whole
+ *                    level.
  * @param  backdrop1  The first backdrop type.
  * @param  backdrop2  The second backdrop type.
  */
@@ -239,6 +595,81 @@ void fn_level_blit_to_texture(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Blit a surface onto the level. Use this instead of
+ * SDL_BlitSurface for everything drawn while the level is
+ * blitted, so the blit ends up in the right order when it is
+ * recorded.
+ *
+ * @param  lv       The level.
+ * @param  src      The surface to blit.
+ * @param  srcrect  The part of the surface, or NULL for all.
+ * @param  dstrect  The position on the level.
+ */
+void fn_level_blit_surface(fn_level_t * lv,
+    SDL_Surface * src,
+    SDL_Rect * srcrect,
+    SDL_Rect * dstrect);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw a tile onto the level. The tile is only drawn when the
+ * frame is complete, after everything on the layers below.
+ *
+ * @param  lv     The level.
+ * @param  tile   The number of the tile.
+ * @param  x      The x position in level pixels.
+ * @param  y      The y position in level pixels.
+ * @param  layer  The layer to draw the tile on.
+ */
+void fn_level_draw_tile(fn_level_t * lv,
+    Uint16 tile,
+    int x,
+    int y,
+    fn_level_layer_e layer);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Fill a rectangle on the level with black, like fn_level_draw_tile.
+ *
+ * @param  lv     The level.
+ * @param  x      The x position in level pixels.
+ * @param  y      The y position in level pixels.
+ * @param  w      The width in level pixels.
+ * @param  h      The height in level pixels.
+ * @param  layer  The layer to fill the rectangle on.
+ */
+void fn_level_draw_fill(fn_level_t * lv,
+    int x,
+    int y,
+    int w,
+    int h,
+    fn_level_layer_e layer);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw the outline of a collision area onto the level, like
+ * fn_level_draw_tile.
+ *
+ * @param  lv     The level.
+ * @param  x      The x position in level pixels.
+ * @param  y      The y position in level pixels.
+ * @param  w      The width in level pixels.
+ * @param  h      The height in level pixels.
+ * @param  layer  The layer to draw the outline on.
+ */
+void fn_level_draw_bounds(fn_level_t * lv,
+    int x,
+    int y,
+    int w,
+    int h,
+    fn_level_layer_e layer);
+
+/* --------------------------------------------------------------- */
+
 /**
  * Get the SDL surface to which the level is blitted.
  *
@@ -294,6 +725,97 @@ fn_hero_t * fn_level_get_hero(fn_level_t * lv);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Seed the random number generator of the level.
+ *
+ * @param  lv    The level.
+ * @param  seed  The seed.
+ */
+void fn_level_set_seed(fn_level_t * lv, Uint32 seed);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the next number from the random number generator of the
+ * level. Use this instead of rand() inside the game logic, so
+ * that the level plays the same on every machine and levels
+ * running in parallel do not influence each other.
+ *
+ * @param  lv  The level.
+ *
+ * @return A number between 0 and 32767.
+ */
+Uint16 fn_level_random(fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Apply the input state of a game tick to the hero of the level.
+ *
+ * @param  lv        The level.
+ * @param  previous  The input state of the previous tick (FNK_* bits).
+ * @param  current   The input state of this tick (FNK_* bits).
+ */
+void fn_level_apply_input(fn_level_t * lv,
+    Uint8 previous,
+    Uint8 current);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Mark the actors inside or near a view as visible and all
+ * others as invisible. Invisible actors do not act unless they
+ * act while invisible.
+ *
+ * Only the actors that were visible before, the new ones and the
+ * ones waiting in the regions around the view are looked at.
+ * Actors that leave the view wait in the region they left it in
+ * until the view comes near again.
+ *
+ * The spawn records in the regions around the view are turned
+ * into actors, and unchanged actors of the regions the view moved
+ * away from are turned back into their records.
+ *
+ * @param  lv    The level.
+ * @param  view  The view in level pixels, or NULL for the
+ *               whole level.
+ */
+void fn_level_update_visibility(fn_level_t * lv, SDL_Rect * view);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Schedule all actors of the level anew, after the list of actors
+ * was replaced. They act again once the visibility was updated.
+ *
+ * @param  lv  The level.
+ */
+void fn_level_schedule_reset(fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create the actors of the spawn records in the regions around
+ * an area, so that things passing far from the view, like shots,
+ * find them.
+ *
+ * @param  lv    The level.
+ * @param  area  The area in level pixels.
+ */
+void fn_level_spawn_around(fn_level_t * lv, SDL_Rect * area);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Move a view so that it shows the hero of the level.
+ *
+ * @param  lv    The level.
+ * @param  view  The view in level pixels. The size is kept.
+ */
+void fn_level_center_view(fn_level_t * lv, SDL_Rect * view);
+
+/* --------------------------------------------------------------- */
+
 /**
  * Call this function make the game act one step further.
  *
@@ -351,7 +873,11 @@ fn_level_actor_t * fn_level_add_actor(fn_level_t * lv,
  * @param  y      The y coordinate which will be interally multiplied
  *                by FN_TILE_HEIGHT.
  *
- * @return  The newly created actor.
+ * Most actors are only kept as a spawn record until the view
+ * comes near them.
+ *
+ * @return  The newly created actor, or NULL if it is only
+ *          created later.
  */
 fn_level_actor_t * fn_level_add_initial_actor(fn_level_t * lv,
     fn_level_actor_type_e type,
@@ -387,6 +913,7 @@ void fn_level_fire_shot(fn_level_t * lv);
 
 /**
  * Get a list containing all items in the level of a type.
+ * Actors still kept as spawn records are not included.
  *
  * @param  lv    The level.
  * @param  type  The type of which to get the items.
@@ -36,6 +36,7 @@
 #include "fn_infobox.h"
 #include "fn_error_cmdline.h"
 #include "fn_collision.h"
+#include "fn_profile.h"
 
 /* --------------------------------------------------------------- */
 
@@ -85,6 +86,18 @@ typedef enum fn_level_actor_function_type_e {
    * The actor gets hit by a shot.
    */
   FN_LEVEL_ACTOR_FUNCTION_SHOT,
+  /**
+   * The serialize function. Writes the actor specific data to the
+   * snapshot of the level. Actors without this function are not
+   * stored in snapshots.
+   */
+  FN_LEVEL_ACTOR_FUNCTION_SERIALIZE,
+  /**
+   * The deserialize function. Reads the actor specific data from
+   * the snapshot of the level. Is called instead of the create
+   * function when an actor is restored.
+   */
+  FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE,
   /**
    * The number of functions. Only used for getting the enum bounds.
    */
@@ -93,6 +106,69 @@ typedef enum fn_level_actor_function_type_e {
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Write the data of an actor to the snapshot of its level.
+ *
+ * @param  actor  The actor.
+ * @param  size   The size of the actor data.
+ */
+static void fn_level_actor_serialize_data(fn_level_actor_t * actor,
+    size_t size)
+{
+  fn_snapshot_write(actor->level->snapshot, actor->data, size);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read the data of an actor from the snapshot of its level.
+ *
+ * @param  actor  The actor.
+ * @param  size   The size of the actor data.
+ */
+static void fn_level_actor_deserialize_data(fn_level_actor_t * actor,
+    size_t size)
+{
+  actor->data = malloc(size);
+  fn_snapshot_read(actor->level->snapshot, actor->data, size);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_nodata_serialize(fn_level_actor_t * actor)
+{
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_nodata_deserialize(fn_level_actor_t * actor)
+{
+  actor->data = NULL;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw a tile of an actor onto the level, on the layer the actor
+ * is in.
+ *
+ * @param  actor  The actor.
+ * @param  tile   The number of the tile.
+ * @param  x      The x position in level pixels.
+ * @param  y      The y position in level pixels.
+ */
+static void fn_level_actor_draw_tile(fn_level_actor_t * actor,
+    Uint16 tile,
+    int x,
+    int y)
+{
+  fn_level_draw_tile(actor->level, tile, x, y,
+      actor->is_in_foreground ?
+      FN_LEVEL_LAYER_FOREGROUND : FN_LEVEL_LAYER_BACKGROUND);
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * The simple animation struct.
  * A simple animation is an animation which is one part high,
@@ -124,7 +200,7 @@ typedef struct fn_level_actor_simpleanimation_data_t {
  */
 void fn_level_actor_function_simpleanimation_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_simpleanimation_data_t * data = malloc(
+  fn_level_actor_simpleanimation_data_t * data = calloc(1,
       sizeof(fn_level_actor_simpleanimation_data_t));
 
   actor->is_in_foreground = 0;
@@ -228,6 +304,20 @@ void fn_level_actor_function_simpleanimation_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_simpleanimation_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_simpleanimation_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_simpleanimation_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_simpleanimation_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete a simple animation.
  *
@@ -263,18 +353,9 @@ void fn_level_actor_function_simpleanimation_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_simpleanimation_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_simpleanimation_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -302,7 +383,7 @@ typedef struct fn_level_actor_redball_jumping_data_t {
 
 void fn_level_actor_function_redball_jumping_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_redball_jumping_data_t * data = malloc(
+  fn_level_actor_redball_jumping_data_t * data = calloc(1,
       sizeof(fn_level_actor_redball_jumping_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -314,6 +395,20 @@ void fn_level_actor_function_redball_jumping_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_redball_jumping_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_redball_jumping_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_redball_jumping_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_redball_jumping_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_redball_jumping_free(fn_level_actor_t * actor)
 {
   fn_level_actor_redball_jumping_data_t * data = actor->data;
@@ -390,17 +485,8 @@ void fn_level_actor_function_redball_jumping_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_redball_jumping_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -434,7 +520,7 @@ typedef struct fn_level_actor_redball_lying_data_t {
 
 void fn_level_actor_function_redball_lying_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_redball_lying_data_t * data = malloc(
+  fn_level_actor_redball_lying_data_t * data = calloc(1,
       sizeof(fn_level_actor_redball_lying_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -443,6 +529,20 @@ void fn_level_actor_function_redball_lying_create(fn_level_actor_t * actor)
   data->touching_hero = 0;
 }
 
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_redball_lying_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_redball_lying_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_redball_lying_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_redball_lying_data_t));
+}
+
 
 /* --------------------------------------------------------------- */
 
@@ -497,17 +597,8 @@ void fn_level_actor_function_redball_lying_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_redball_lying_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -543,7 +634,7 @@ typedef struct fn_level_actor_robot_data_t {
 
 void fn_level_actor_function_robot_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_robot_data_t * data = malloc(
+  fn_level_actor_robot_data_t * data = calloc(1,
       sizeof(fn_level_actor_robot_data_t));
   actor->data = data;
   actor->is_in_foreground = 1;
@@ -558,6 +649,20 @@ void fn_level_actor_function_robot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_robot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_robot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_robot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_robot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_robot_free(fn_level_actor_t * actor)
 {
   fn_level_actor_robot_data_t * data = actor->data;
@@ -642,17 +747,8 @@ void fn_level_actor_function_robot_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_robot_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -713,7 +809,7 @@ typedef struct fn_level_actor_tankbot_data_t {
 
 void fn_level_actor_function_tankbot_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_tankbot_data_t * data = malloc(
+  fn_level_actor_tankbot_data_t * data = calloc(1,
       sizeof(fn_level_actor_tankbot_data_t));
   actor->data = data;
   actor->is_in_foreground = 1;
@@ -729,6 +825,20 @@ void fn_level_actor_function_tankbot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_tankbot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_tankbot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_tankbot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_tankbot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_tankbot_free(fn_level_actor_t * actor)
 {
   fn_level_actor_tankbot_data_t * data = actor->data;
@@ -848,24 +958,12 @@ void fn_level_actor_function_tankbot_act(fn_level_actor_t * actor)
 void fn_level_actor_function_tankbot_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_tankbot_data_t * data = actor->data;
+  Uint16 tile = data->tile + (data->current_frame/2) * 2;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame/2) * 2);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame/2) * 2 + 1);
-  destrect.x += pixelsize * FN_TILE_WIDTH;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, tile + 1,
+      actor->position.x + FN_TILE_WIDTH, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -931,7 +1029,7 @@ typedef struct fn_level_actor_firewheelbot_data_t {
 
 void fn_level_actor_function_firewheelbot_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_firewheelbot_data_t * data = malloc(
+  fn_level_actor_firewheelbot_data_t * data = calloc(1,
       sizeof(fn_level_actor_firewheelbot_data_t));
   actor->data = data;
   data->direction = fn_horizontal_direction_left;
@@ -948,6 +1046,20 @@ void fn_level_actor_function_firewheelbot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_firewheelbot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_firewheelbot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_firewheelbot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_firewheelbot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_firewheelbot_free(fn_level_actor_t * actor)
 {
   fn_level_actor_firewheelbot_data_t * data = actor->data;
@@ -1044,38 +1156,15 @@ void fn_level_actor_function_firewheelbot_act(fn_level_actor_t * actor)
 void fn_level_actor_function_firewheelbot_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_firewheelbot_data_t * data = actor->data;
+  Uint16 tile = data->tile + (data->current_frame) * 4;
+  int x = actor->position.x + actor->position.w / 2 - FN_TILE_WIDTH;
+  int y = actor->position.y - FN_TILE_HEIGHT;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = NULL;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame) * 4);
-  destrect.x = (actor->position.x +
-      actor->position.w / 2
-      - FN_TILE_WIDTH) * pixelsize;
-  destrect.y = (actor->position.y - FN_TILE_HEIGHT) * pixelsize;
-  destrect.w = FN_TILE_WIDTH * 2 * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame) * 4 + 1);
-  destrect.x += pixelsize * FN_TILE_WIDTH;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  destrect.x -= pixelsize * FN_TILE_WIDTH;
-  destrect.y += pixelsize * FN_TILE_HEIGHT;
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame) * 4 + 2);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  destrect.x += pixelsize * FN_TILE_WIDTH;
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->current_frame) * 4 + 3);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile, x, y);
+  fn_level_actor_draw_tile(actor, tile + 1, x + FN_TILE_WIDTH, y);
+  fn_level_actor_draw_tile(actor, tile + 2, x, y + FN_TILE_HEIGHT);
+  fn_level_actor_draw_tile(actor, tile + 3,
+      x + FN_TILE_WIDTH, y + FN_TILE_HEIGHT);
 }
 
 /* --------------------------------------------------------------- */
@@ -1138,7 +1227,7 @@ typedef struct fn_level_actor_wallcrawler_data_t {
 void fn_level_actor_function_wallcrawler_create(fn_level_actor_t * actor)
 {
 
-  fn_level_actor_wallcrawler_data_t * data = malloc(
+  fn_level_actor_wallcrawler_data_t * data = calloc(1,
       sizeof(fn_level_actor_wallcrawler_data_t));
   actor->data = data;
   actor->is_in_foreground = 1;
@@ -1161,6 +1250,20 @@ void fn_level_actor_function_wallcrawler_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_wallcrawler_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_wallcrawler_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_wallcrawler_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_wallcrawler_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_wallcrawler_free(fn_level_actor_t * actor)
 {
   fn_level_actor_wallcrawler_data_t * data = actor->data;
@@ -1261,17 +1364,8 @@ void fn_level_actor_function_wallcrawler_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_wallcrawler_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -1326,7 +1420,7 @@ typedef struct fn_level_actor_lift_data_t {
  */
 void fn_level_actor_function_lift_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_lift_data_t * data = malloc(
+  fn_level_actor_lift_data_t * data = calloc(1,
       sizeof(fn_level_actor_lift_data_t));
   data->state = fn_level_actor_lift_state_idle;
   actor->data = data;
@@ -1337,6 +1431,20 @@ void fn_level_actor_function_lift_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_lift_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_lift_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_lift_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_lift_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete the lift.
  *
@@ -1479,34 +1587,17 @@ void fn_level_actor_function_lift_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_lift_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = NULL;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
   int i = 0;
-  tile = fn_tilecache_get_tile(tc, SOLID_START + 23);
   for (i = 0;
       i < actor->position.h - FN_TILE_HEIGHT;
       i += FN_HALFTILE_HEIGHT) {
-    destrect.y += FN_HALFTILE_HEIGHT * pixelsize;
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+    fn_level_actor_draw_tile(actor, SOLID_START + 23,
+        actor->position.x,
+        actor->position.y + i + FN_HALFTILE_HEIGHT);
   }
 
-  tile = fn_tilecache_get_tile(tc,
-      OBJ_ELEVATOR);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
+  fn_level_actor_draw_tile(actor, OBJ_ELEVATOR,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -1534,7 +1625,7 @@ typedef struct fn_level_actor_acme_data_t {
 
 void fn_level_actor_function_acme_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_acme_data_t * data = malloc(
+  fn_level_actor_acme_data_t * data = calloc(1,
       sizeof(fn_level_actor_acme_data_t));
   actor->data = data;
   data->tile = OBJ_FALLINGBLOCK;
@@ -1547,6 +1638,20 @@ void fn_level_actor_function_acme_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_acme_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_acme_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_acme_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_acme_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_acme_free(fn_level_actor_t * actor)
 {
   fn_level_actor_acme_data_t * data = actor->data;
@@ -1638,21 +1743,10 @@ void fn_level_actor_function_acme_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_acme_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc, data->tile+1);
-  destrect.x += FN_TILE_WIDTH * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, data->tile + 1,
+      actor->position.x + FN_TILE_WIDTH, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -1727,7 +1821,7 @@ typedef struct fn_level_actor_fire_data_t {
 
 void fn_level_actor_function_fire_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_fire_data_t * data = malloc(
+  fn_level_actor_fire_data_t * data = calloc(1,
       sizeof(fn_level_actor_fire_data_t));
   actor->data = data;
 
@@ -1750,6 +1844,20 @@ void fn_level_actor_function_fire_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_fire_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_fire_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_fire_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_fire_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_fire_free(fn_level_actor_t * actor)
 {
   fn_level_actor_fire_data_t * data = actor->data;
@@ -1830,12 +1938,9 @@ void fn_level_actor_function_fire_act(fn_level_actor_t * actor)
 void fn_level_actor_function_fire_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_fire_data_t * data = actor->data;
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile0 = NULL;
-  FnTexture * tile1 = NULL;
-  FnTexture * tile2 = NULL;
+  int tile0 = -1;
+  int tile1 = -1;
+  int tile2 = -1;
 
   switch(data->state)
   {
@@ -1844,25 +1949,20 @@ void fn_level_actor_function_fire_blit(fn_level_actor_t * actor)
     case fn_level_actor_fire_state_ignition:
       if (data->counter % 2) {
         if (data->direction == fn_horizontal_direction_left) {
-          tile2 = fn_tilecache_get_tile(tc,
-              data->tile);
+          tile2 = data->tile;
         } else {
-          tile0 = fn_tilecache_get_tile(tc,
-              data->tile);
+          tile0 = data->tile;
         }
       }
       break;
     case fn_level_actor_fire_state_burning:
-      tile1 = fn_tilecache_get_tile(tc,
-          data->tile + 1 + (data->counter % 2));
+      tile1 = data->tile + 1 + (data->counter % 2);
       if (data->direction == fn_horizontal_direction_left) {
         tile2 = tile1;
-        tile0 = fn_tilecache_get_tile(tc, data->tile + 3 +
-            (data->counter % 2));
+        tile0 = data->tile + 3 + (data->counter % 2);
       } else {
         tile0 = tile1;
-        tile2 = fn_tilecache_get_tile(tc, data->tile + 3 +
-            (data->counter % 2));
+        tile2 = data->tile + 3 + (data->counter % 2);
       }
       break;
     default:
@@ -1871,21 +1971,17 @@ void fn_level_actor_function_fire_blit(fn_level_actor_t * actor)
           __LINE__);
       break;
   }
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  if (tile0 != NULL) {
-    fn_texture_blit_to_sdl_surface(tile0, NULL, target, &destrect);
+  if (tile0 != -1) {
+    fn_level_actor_draw_tile(actor, tile0,
+        actor->position.x, actor->position.y);
   }
-  destrect.x += FN_TILE_WIDTH * pixelsize;
-  if (tile1 != NULL) {
-    fn_texture_blit_to_sdl_surface(tile1, NULL, target, &destrect);
+  if (tile1 != -1) {
+    fn_level_actor_draw_tile(actor, tile1,
+        actor->position.x + FN_TILE_WIDTH, actor->position.y);
   }
-  destrect.x += FN_TILE_WIDTH * pixelsize;
-  if (tile2 != NULL) {
-    fn_texture_blit_to_sdl_surface(tile2, NULL, target, &destrect);
+  if (tile2 != -1) {
+    fn_level_actor_draw_tile(actor, tile2,
+        actor->position.x + 2 * FN_TILE_WIDTH, actor->position.y);
   }
 }
 
@@ -1918,7 +2014,7 @@ typedef struct fn_level_actor_mill_data_t {
 
 void fn_level_actor_function_mill_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_mill_data_t * data = malloc(
+  fn_level_actor_mill_data_t * data = calloc(1,
       sizeof(fn_level_actor_mill_data_t));
   actor->data = data;
   actor->is_in_foreground = 0;
@@ -1939,6 +2035,20 @@ void fn_level_actor_function_mill_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_mill_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_mill_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_mill_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_mill_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_mill_free(fn_level_actor_t * actor)
 {
   fn_level_actor_mill_data_t * data = actor->data;
@@ -1974,22 +2084,10 @@ void fn_level_actor_function_mill_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_mill_data_t * data = actor->data;
 
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = FN_TILE_WIDTH * pixelsize;
-  destrect.h = FN_TILE_HEIGHT * pixelsize;
-
   int i = 0;
   for (i = 0; i < (actor->position.h / FN_TILE_HEIGHT); i++) {
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-    destrect.y += FN_TILE_HEIGHT * pixelsize;
+    fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+        actor->position.x, actor->position.y + i * FN_TILE_HEIGHT);
   }
 }
 
@@ -2058,7 +2156,7 @@ void fn_level_actor_function_accesscard_slot_create(fn_level_actor_t * actor)
 {
   actor->position.w = FN_TILE_WIDTH;
   actor->position.h = FN_TILE_HEIGHT;
-  fn_level_actor_access_card_slot_data_t * data = malloc(
+  fn_level_actor_access_card_slot_data_t * data = calloc(1,
       sizeof(fn_level_actor_access_card_slot_data_t));
   data->tile = OBJ_ACCESS_CARD_SLOT;
   data->current_frame = 0;
@@ -2069,6 +2167,20 @@ void fn_level_actor_function_accesscard_slot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_accesscard_slot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_access_card_slot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_accesscard_slot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_access_card_slot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete an accesscard slot.
  *
@@ -2143,18 +2255,9 @@ void fn_level_actor_function_accesscard_slot_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_accesscard_slot_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_access_card_slot_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -2204,7 +2307,7 @@ void fn_level_actor_function_glove_slot_create(fn_level_actor_t * actor)
 {
   actor->position.w = FN_TILE_WIDTH;
   actor->position.h = FN_TILE_HEIGHT;
-  fn_level_actor_glove_slot_data_t * data = malloc(
+  fn_level_actor_glove_slot_data_t * data = calloc(1,
       sizeof(fn_level_actor_glove_slot_data_t));
   data->tile = OBJ_GLOVE_SLOT;
   data->current_frame = 0;
@@ -2217,6 +2320,20 @@ void fn_level_actor_function_glove_slot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_glove_slot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_glove_slot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_glove_slot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_glove_slot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_glove_slot_free(fn_level_actor_t * actor)
 {
   fn_level_actor_glove_slot_data_t * data = actor->data;
@@ -2335,26 +2452,14 @@ void fn_level_actor_function_glove_slot_act(fn_level_actor_t * actor)
 void fn_level_actor_function_glove_slot_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_glove_slot_data_t * data = actor->data;
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   Uint8 adder = (data->current_frame == 0 ? 0 : 1);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + adder);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  destrect.x -= FN_TILE_WIDTH * pixelsize;
-  tile = fn_tilecache_get_tile(tc, data->tile + 2);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
 
-  destrect.x += 2 * FN_TILE_WIDTH * pixelsize;
-  tile = fn_tilecache_get_tile(tc, data->tile + 3);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + adder,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, data->tile + 2,
+      actor->position.x - FN_TILE_WIDTH, actor->position.y);
+  fn_level_actor_draw_tile(actor, data->tile + 3,
+      actor->position.x + FN_TILE_WIDTH, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -2396,7 +2501,7 @@ typedef struct fn_level_actor_item_data_t {
  */
 void fn_level_actor_function_item_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_item_data_t * data = malloc(
+  fn_level_actor_item_data_t * data = calloc(1,
       sizeof(fn_level_actor_item_data_t));
 
   actor->data = data;
@@ -2537,6 +2642,20 @@ void fn_level_actor_function_item_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_item_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_item_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_item_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_item_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete an item.
  *
@@ -2758,18 +2877,9 @@ void fn_level_actor_function_item_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_item_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_item_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -2981,17 +3091,9 @@ void fn_level_actor_function_soda_flying_act(fn_level_actor_t * actor)
 
 void fn_level_actor_function_soda_flying_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc, ANIM_SODAFLY +
-      (actor->position.y/FN_HALFTILE_HEIGHT) % 4);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, ANIM_SODAFLY +
+      (actor->position.y/FN_HALFTILE_HEIGHT) % 4,
+      actor->position.x, actor->position.y);
 }
 
 
@@ -3017,7 +3119,7 @@ typedef struct fn_level_actor_balloon_data_t {
 void fn_level_actor_function_balloon_create(fn_level_actor_t * actor)
 {
   fn_level_actor_balloon_data_t * data =
-    malloc(sizeof(fn_level_actor_balloon_data_t));
+    calloc(1, sizeof(fn_level_actor_balloon_data_t));
   actor->data = data;
   data->destroyed = 0;
   data->current_frame = 0;
@@ -3027,6 +3129,20 @@ void fn_level_actor_function_balloon_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_balloon_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_balloon_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_balloon_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_balloon_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_balloon_free(fn_level_actor_t * actor)
 {
   fn_level_actor_balloon_data_t * data = actor->data;
@@ -3080,29 +3196,17 @@ void fn_level_actor_function_balloon_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_balloon_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
   if (data->destroyed) {
-    tile = fn_tilecache_get_tile(tc, OBJ_BALLOON + 4);
+    fn_level_actor_draw_tile(actor, OBJ_BALLOON + 4,
+        actor->position.x, actor->position.y);
   } else {
-    tile = fn_tilecache_get_tile(tc, OBJ_BALLOON);
+    fn_level_actor_draw_tile(actor, OBJ_BALLOON,
+        actor->position.x, actor->position.y);
   }
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  destrect.y += FN_TILE_HEIGHT * pixelsize;
 
-  tile = fn_tilecache_get_tile(tc,
-      OBJ_BALLOON + 1 + data->current_frame / 3);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor,
+      OBJ_BALLOON + 1 + data->current_frame / 3,
+      actor->position.x, actor->position.y + FN_TILE_HEIGHT);
 }
 
 /* --------------------------------------------------------------- */
@@ -3184,27 +3288,14 @@ void fn_level_actor_function_teleporter_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_teleporter_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
   int i = 0;
   for (i = 0; i < 3; i++) {
     int j = 0;
     for (j = 0; j < 3; j++) {
-      destrect.x = (actor->position.x - (1 - j) * FN_TILE_WIDTH) * pixelsize;
-      destrect.y = (actor->position.y - (2 - i) * FN_TILE_HEIGHT) * pixelsize;
-      tile = fn_tilecache_get_tile(tc,
-          ANIM_TELEPORTER1 + i * 3 + j
-          );
-      fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+      fn_level_actor_draw_tile(actor,
+          ANIM_TELEPORTER1 + i * 3 + j,
+          actor->position.x - (1 - j) * FN_TILE_WIDTH,
+          actor->position.y - (2 - i) * FN_TILE_HEIGHT);
     }
   }
 }
@@ -3239,7 +3330,7 @@ typedef struct fn_level_actor_singleanimation_data_t {
  */
 void fn_level_actor_function_singleanimation_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_singleanimation_data_t * data = malloc(
+  fn_level_actor_singleanimation_data_t * data = calloc(1,
       sizeof(fn_level_actor_singleanimation_data_t));
 
   actor->data = data;
@@ -3278,6 +3369,20 @@ void fn_level_actor_function_singleanimation_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_singleanimation_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_singleanimation_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_singleanimation_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_singleanimation_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete a singleanimation.
  *
@@ -3319,18 +3424,9 @@ void fn_level_actor_function_singleanimation_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_singleanimation_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_singleanimation_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -3362,14 +3458,14 @@ typedef struct fn_level_actor_particle_data_t {
 
 void fn_level_actor_function_particle_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_particle_data_t * data = malloc(
+  fn_level_actor_particle_data_t * data = calloc(1,
       sizeof(fn_level_actor_particle_data_t));
   actor->data = data;
   data->countdown = 20;
   actor->is_in_foreground = 1;
 
-  Uint16 hrand = rand();
-  Uint16 vrand = rand();
+  Uint16 hrand = fn_level_random(actor->level);
+  Uint16 vrand = fn_level_random(actor->level);
 
   int const hrand_max = 15;
   int const vrand_max = 15;
@@ -3402,6 +3498,20 @@ void fn_level_actor_function_particle_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_particle_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_particle_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_particle_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_particle_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_particle_free(fn_level_actor_t * actor)
 {
   fn_level_actor_particle_data_t * data = actor->data;
@@ -3429,16 +3539,8 @@ void fn_level_actor_function_particle_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_particle_data_t * data = actor->data;
 
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc, data->tile);
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -3470,7 +3572,7 @@ typedef struct fn_level_actor_rocket_data_t {
  */
 void fn_level_actor_function_rocket_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_rocket_data_t * data = malloc(
+  fn_level_actor_rocket_data_t * data = calloc(1,
       sizeof(fn_level_actor_rocket_data_t));
   actor->data = data;
   data->state = fn_level_actor_rocket_state_idle;
@@ -3480,6 +3582,20 @@ void fn_level_actor_function_rocket_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_rocket_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_rocket_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_rocket_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_rocket_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_rocket_free(fn_level_actor_t * actor)
 {
   fn_level_actor_rocket_data_t * data = actor->data;
@@ -3513,40 +3629,22 @@ void fn_level_actor_function_rocket_act(fn_level_actor_t * actor)
 void fn_level_actor_function_rocket_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_rocket_data_t * data = actor->data;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc, OBJ_ROCKET);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = (actor->position.y - FN_TILE_HEIGHT * 3) * pixelsize;
-  destrect.w = FN_TILE_WIDTH * pixelsize;
-  destrect.h = FN_TILE_HEIGHT * pixelsize;
-
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc, OBJ_ROCKET + 1);
-  destrect.y += FN_TILE_HEIGHT * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-  destrect.y += FN_TILE_HEIGHT * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-  destrect.y += FN_TILE_HEIGHT * pixelsize;
-
-  tile = fn_tilecache_get_tile(tc, OBJ_ROCKET + 2);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc, OBJ_ROCKET + 3);
-  destrect.x -= FN_TILE_WIDTH * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-  destrect.x += FN_TILE_WIDTH * 2 * pixelsize;
-  tile = fn_tilecache_get_tile(tc, OBJ_ROCKET + 4);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  int x = actor->position.x;
+  int y = actor->position.y - FN_TILE_HEIGHT * 3;
+
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET, x, y);
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET + 1, x, y + FN_TILE_HEIGHT);
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET + 1,
+      x, y + 2 * FN_TILE_HEIGHT);
+
+  y += 3 * FN_TILE_HEIGHT;
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET + 2, x, y);
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET + 3, x - FN_TILE_WIDTH, y);
+  fn_level_actor_draw_tile(actor, OBJ_ROCKET + 4, x + FN_TILE_WIDTH, y);
 
   if (data->state == fn_level_actor_rocket_state_flying) {
-    destrect.x -= FN_TILE_WIDTH * pixelsize;
-    destrect.y += FN_TILE_HEIGHT * pixelsize;
-    tile = fn_tilecache_get_tile(tc, OBJ_ROCKET + 6);
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+    fn_level_actor_draw_tile(actor, OBJ_ROCKET + 6,
+        x, y + FN_TILE_HEIGHT);
   }
 }
 
@@ -3608,7 +3706,7 @@ typedef struct fn_level_actor_bomb_data_t {
 
 void fn_level_actor_bomb_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_bomb_data_t * data = malloc(
+  fn_level_actor_bomb_data_t * data = calloc(1,
       sizeof(fn_level_actor_bomb_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -3626,6 +3724,20 @@ void fn_level_actor_bomb_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_bomb_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_bomb_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_bomb_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_bomb_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_bomb_free(fn_level_actor_t * actor)
 {
   fn_level_actor_bomb_data_t * data = actor->data;
@@ -3699,17 +3811,8 @@ void fn_level_actor_bomb_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_bomb_data_t * data = actor->data;
   if (data->counter < data->explode_threshold) {
-    SDL_Surface * target = fn_level_get_surface(actor->level);
-    SDL_Rect destrect;
-    fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-    FnTexture * tile = fn_tilecache_get_tile(tc,
-        data->tile + data->current_frame);
-    Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-    destrect.x = actor->position.x * pixelsize;
-    destrect.y = actor->position.y * pixelsize;
-    destrect.w = actor->position.w * pixelsize;
-    destrect.h = actor->position.h * pixelsize;
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+    fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+        actor->position.x, actor->position.y);
   }
 }
 
@@ -3739,7 +3842,7 @@ typedef struct fn_level_actor_bombfire_data_t {
 
 void fn_level_actor_bombfire_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_bombfire_data_t * data = malloc(
+  fn_level_actor_bombfire_data_t * data = calloc(1,
       sizeof(fn_level_actor_bombfire_data_t));
   actor->position.w = FN_TILE_WIDTH;
   actor->position.h = FN_TILE_HEIGHT;
@@ -3752,6 +3855,20 @@ void fn_level_actor_bombfire_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_bombfire_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_bombfire_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_bombfire_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_bombfire_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_bombfire_free(fn_level_actor_t * actor)
 {
   fn_level_actor_bombfire_data_t * data = actor->data;
@@ -3796,17 +3913,8 @@ void fn_level_actor_bombfire_act(fn_level_actor_t * actor)
 void fn_level_actor_bombfire_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_bombfire_data_t * data = actor->data;
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -3839,7 +3947,7 @@ typedef struct fn_level_actor_explosion_data_t {
  */
 void fn_level_actor_function_explosion_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_explosion_data_t * data = malloc(
+  fn_level_actor_explosion_data_t * data = calloc(1,
       sizeof(fn_level_actor_explosion_data_t));
 
   actor->data = data;
@@ -3854,6 +3962,20 @@ void fn_level_actor_function_explosion_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_explosion_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_explosion_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_explosion_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_explosion_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete an explosion.
  *
@@ -3891,18 +4013,9 @@ void fn_level_actor_function_explosion_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_explosion_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_explosion_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -3927,29 +4040,19 @@ void fn_level_actor_function_camera_create(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_camera_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
   fn_hero_t * hero = fn_level_get_hero(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
+  Uint16 tile;
 
   size_t x = fn_hero_get_x(hero);
   if (x-1 > actor->position.x) {
-    tile = fn_tilecache_get_tile(tc,
-        ANIM_CAMERA_RIGHT);
+    tile = ANIM_CAMERA_RIGHT;
   } else if (x+1 < actor->position.x) {
-    tile = fn_tilecache_get_tile(tc,
-        ANIM_CAMERA_LEFT);
+    tile = ANIM_CAMERA_LEFT;
   } else {
-    tile = fn_tilecache_get_tile(tc,
-        ANIM_CAMERA_CENTER);
+    tile = ANIM_CAMERA_CENTER;
   }
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4002,7 +4105,7 @@ typedef struct fn_level_actor_score_data_t {
  */
 void fn_level_actor_function_score_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_score_data_t * data = malloc(
+  fn_level_actor_score_data_t * data = calloc(1,
       sizeof(fn_level_actor_score_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -4081,6 +4184,20 @@ void fn_level_actor_function_score_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_score_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_score_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_score_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_score_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete a score.
  *
@@ -4118,18 +4235,9 @@ void fn_level_actor_function_score_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_score_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_score_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + (data->countdown % 2));
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + (data->countdown % 2),
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4155,7 +4263,7 @@ typedef struct fn_level_actor_unstablefloor_data_t {
 
 void fn_level_actor_function_unstablefloor_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_unstablefloor_data_t * data = malloc(
+  fn_level_actor_unstablefloor_data_t * data = calloc(1,
       sizeof(fn_level_actor_unstablefloor_data_t));
   actor->data = data;
   data->tile = SOLID_START + 77;
@@ -4167,6 +4275,20 @@ void fn_level_actor_function_unstablefloor_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_unstablefloor_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_unstablefloor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_unstablefloor_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_unstablefloor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_unstablefloor_free(fn_level_actor_t * actor)
 {
   fn_level_actor_unstablefloor_data_t * data = actor->data;
@@ -4268,24 +4390,11 @@ void fn_level_actor_function_unstablefloor_act(fn_level_actor_t * actor)
 void fn_level_actor_function_unstablefloor_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_unstablefloor_data_t * data = actor->data;
-  
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = NULL;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
 
   int i = 0;
   for (i = 0; i < (actor->position.w / FN_TILE_WIDTH); i++) {
-    tile = fn_tilecache_get_tile(tc,
-        data->tile + i % 2);
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-    destrect.x += FN_TILE_WIDTH * pixelsize;
+    fn_level_actor_draw_tile(actor, data->tile + i % 2,
+        actor->position.x + i * FN_TILE_WIDTH, actor->position.y);
   }
 }
 
@@ -4314,21 +4423,10 @@ void fn_level_actor_function_expandingfloor_act(fn_level_actor_t * actor)
 
 void fn_level_actor_function_expandingfloor_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc, SOLID_EXPANDINGFLOOR);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
   int i = 0;
   for (i = 0; i < (actor->position.w / FN_TILE_WIDTH); i++) {
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-    destrect.x += FN_TILE_WIDTH * pixelsize;
+    fn_level_actor_draw_tile(actor, SOLID_EXPANDINGFLOOR,
+        actor->position.x + i * FN_TILE_WIDTH, actor->position.y);
   }
 }
 
@@ -4357,7 +4455,7 @@ typedef struct fn_level_actor_conveyor_data_t {
 
 void fn_level_actor_function_conveyor_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_conveyor_data_t * data = malloc(
+  fn_level_actor_conveyor_data_t * data = calloc(1,
       sizeof(fn_level_actor_conveyor_data_t));
   actor->data = data;
   actor->is_in_foreground = 0;
@@ -4405,6 +4503,20 @@ void fn_level_actor_function_conveyor_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_conveyor_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_conveyor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_conveyor_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_conveyor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_conveyor_free(fn_level_actor_t * actor)
 {
   fn_level_actor_conveyor_data_t * data = actor->data;
@@ -4444,34 +4556,21 @@ void fn_level_actor_function_conveyor_act(fn_level_actor_t * actor)
 
 void fn_level_actor_function_conveyor_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_conveyor_data_t * data = actor->data;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
 
   Uint16 i = 0;
 
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      SOLID_CONVEYORBELT_LEFTEND + data->current_frame);
+  Uint16 tile = SOLID_CONVEYORBELT_LEFTEND + data->current_frame;
 
   for (i = actor->position.x; i < actor->position.x + actor->position.w; i+= FN_TILE_WIDTH) {
-    destrect.x = i * pixelsize;
     if (i + FN_TILE_WIDTH == actor->position.x + actor->position.w) {
       /* last element */
-      tile = fn_tilecache_get_tile(tc,
-          SOLID_CONVEYORBELT_RIGHTEND + data->current_frame);
+      tile = SOLID_CONVEYORBELT_RIGHTEND + data->current_frame;
     }
 
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+    fn_level_actor_draw_tile(actor, tile, i, actor->position.y);
 
-    tile = fn_tilecache_get_tile(tc,
-        SOLID_CONVEYORBELT_CENTER + data->current_frame % 2);
+    tile = SOLID_CONVEYORBELT_CENTER + data->current_frame % 2;
   }
 
 }
@@ -4506,23 +4605,10 @@ void fn_level_actor_function_surveillancescreen_interact_start(
 
 void fn_level_actor_function_surveillancescreen_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  FnTexture * tile = NULL;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  tile = fn_tilecache_get_tile(tc, ANIM_BADGUYSCREEN);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  destrect.x += FN_TILE_WIDTH * pixelsize;
-  tile = fn_tilecache_get_tile(tc, ANIM_BADGUYSCREEN + 1);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, ANIM_BADGUYSCREEN,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, ANIM_BADGUYSCREEN + 1,
+      actor->position.x + FN_TILE_WIDTH, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4551,7 +4637,7 @@ typedef struct fn_level_actor_hostileshot_data_t {
 
 void fn_level_actor_function_hostileshot_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_hostileshot_data_t * data = malloc(
+  fn_level_actor_hostileshot_data_t * data = calloc(1,
       sizeof(fn_level_actor_hostileshot_data_t));
   actor->position.w = FN_TILE_WIDTH;
   actor->position.h = FN_TILE_HEIGHT;
@@ -4568,6 +4654,20 @@ void fn_level_actor_function_hostileshot_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_hostileshot_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_hostileshot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_hostileshot_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_hostileshot_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_hostileshot_free(fn_level_actor_t * actor)
 {
   fn_level_actor_hostileshot_data_t * data = actor->data;
@@ -4627,17 +4727,8 @@ void fn_level_actor_function_hostileshot_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_hostileshot_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4669,19 +4760,8 @@ void fn_level_actor_function_notebook_interact_start(fn_level_actor_t * actor)
 
 void fn_level_actor_function_notebook_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  FnTexture * tile = NULL;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  tile = fn_tilecache_get_tile(tc, OBJ_NOTE);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, OBJ_NOTE,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4717,7 +4797,7 @@ typedef struct fn_level_actor_exitdoor_data_t {
  */
 void fn_level_actor_function_exitdoor_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_exitdoor_data_t * data = malloc(
+  fn_level_actor_exitdoor_data_t * data = calloc(1,
       sizeof(fn_level_actor_exitdoor_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH * 2;
@@ -4730,6 +4810,20 @@ void fn_level_actor_function_exitdoor_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_exitdoor_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_exitdoor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_exitdoor_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_exitdoor_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete an exit door.
  *
@@ -4801,54 +4895,25 @@ void fn_level_actor_function_exitdoor_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_exitdoor_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_exitdoor_data_t * data = actor->data;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = 0;
-  destrect.y = 0;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  SDL_Surface * tile = SDL_CreateRGBSurface(
-      target->flags,
-      actor->position.w * pixelsize,
-      actor->position.h * pixelsize,
-      target->format->BitsPerPixel,
-      0,
-      0,
-      0,
-      0);
-  FnTexture * part = fn_tilecache_get_tile(tc,
-      data->tile + data->counter * 4);
-  fn_texture_blit_to_sdl_surface(part, NULL, tile, &destrect);
-
-  destrect.x += pixelsize * FN_TILE_WIDTH;
-  part = fn_tilecache_get_tile(tc,
-    data->tile + data->counter * 4 + 1);
-  fn_texture_blit_to_sdl_surface(part, NULL, tile, &destrect);
-
-  destrect.x = 0;
-  destrect.y += pixelsize * FN_TILE_HEIGHT;
-  part = fn_tilecache_get_tile(tc,
-    data->tile + data->counter * 4 + 2);
-  fn_texture_blit_to_sdl_surface(part, NULL, tile, &destrect);
+  Uint16 tile = data->tile + data->counter * 4;
 
-  destrect.x += pixelsize * FN_TILE_WIDTH;
-  part = fn_tilecache_get_tile(tc,
-    data->tile + data->counter * 4 + 3);
-  fn_texture_blit_to_sdl_surface(part, NULL, tile, &destrect);
+  /* the door is drawn on black, the tiles have transparent parts */
+  fn_level_draw_fill(actor->level,
+      actor->position.x, actor->position.y,
+      actor->position.w, actor->position.h,
+      actor->is_in_foreground ?
+      FN_LEVEL_LAYER_FOREGROUND : FN_LEVEL_LAYER_BACKGROUND);
 
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  SDL_BlitSurface(tile, NULL, target, &destrect);
-
-  SDL_FreeSurface(tile); tile = NULL;
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, tile + 1,
+      actor->position.x + FN_TILE_WIDTH, actor->position.y);
+  fn_level_actor_draw_tile(actor, tile + 2,
+      actor->position.x, actor->position.y + FN_TILE_HEIGHT);
+  fn_level_actor_draw_tile(actor, tile + 3,
+      actor->position.x + FN_TILE_WIDTH,
+      actor->position.y + FN_TILE_HEIGHT);
 }
 
 /* --------------------------------------------------------------- */
@@ -4884,7 +4949,7 @@ typedef struct fn_level_actor_door_data_t {
  */
 void fn_level_actor_function_door_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_door_data_t * data = malloc(
+  fn_level_actor_door_data_t * data = calloc(1,
       sizeof(fn_level_actor_door_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -4897,6 +4962,20 @@ void fn_level_actor_function_door_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_door_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_door_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_door_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_door_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete a door.
  *
@@ -4955,20 +5034,10 @@ void fn_level_actor_function_door_act(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_door_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_door_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->counter);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
 
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->counter,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -4999,7 +5068,7 @@ typedef struct fn_level_actor_keyhole_data_t {
  */
 void fn_level_actor_function_keyhole_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_keyhole_data_t * data = malloc(
+  fn_level_actor_keyhole_data_t * data = calloc(1,
       sizeof(fn_level_actor_keyhole_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -5011,6 +5080,20 @@ void fn_level_actor_function_keyhole_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_keyhole_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_keyhole_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_keyhole_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_keyhole_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete a keyhole.
  *
@@ -5049,38 +5132,29 @@ void fn_level_actor_function_keyhole_act(fn_level_actor_t * actor)
 void fn_level_actor_function_keyhole_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_keyhole_data_t * data = actor->data;
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
+  Uint16 tile = data->tile;
 
   if (data->counter > 1) {
     switch(actor->type) {
       case FN_LEVEL_ACTOR_KEYHOLE_RED:
-        tile = fn_tilecache_get_tile(tc, OBJ_KEYHOLE_RED);
+        tile = OBJ_KEYHOLE_RED;
         break;
       case FN_LEVEL_ACTOR_KEYHOLE_BLUE:
-        tile = fn_tilecache_get_tile(tc, OBJ_KEYHOLE_BLUE);
+        tile = OBJ_KEYHOLE_BLUE;
         break;
       case FN_LEVEL_ACTOR_KEYHOLE_PINK:
-        tile = fn_tilecache_get_tile(tc, OBJ_KEYHOLE_PINK);
+        tile = OBJ_KEYHOLE_PINK;
         break;
       case FN_LEVEL_ACTOR_KEYHOLE_GREEN:
-        tile = fn_tilecache_get_tile(tc, OBJ_KEYHOLE_GREEN);
+        tile = OBJ_KEYHOLE_GREEN;
         break;
       default:
         fn_error_print_commandline("Invalid keyhole actor");
     }
   }
 
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -5214,27 +5288,19 @@ void fn_level_actor_function_key_touch_start(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_key_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = NULL;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
+  Uint16 tile = 0;
   switch(actor->type) {
     case FN_LEVEL_ACTOR_KEY_RED:
-      tile = fn_tilecache_get_tile(tc, OBJ_KEY_RED);
+      tile = OBJ_KEY_RED;
       break;
     case FN_LEVEL_ACTOR_KEY_BLUE:
-      tile = fn_tilecache_get_tile(tc, OBJ_KEY_BLUE);
+      tile = OBJ_KEY_BLUE;
       break;
     case FN_LEVEL_ACTOR_KEY_GREEN:
-      tile = fn_tilecache_get_tile(tc, OBJ_KEY_GREEN);
+      tile = OBJ_KEY_GREEN;
       break;
     case FN_LEVEL_ACTOR_KEY_PINK:
-      tile = fn_tilecache_get_tile(tc, OBJ_KEY_PINK);
+      tile = OBJ_KEY_PINK;
       break;
     default:
       printf(__FILE__ ":%d: warning: key #%d"
@@ -5243,7 +5309,8 @@ void fn_level_actor_function_key_blit(fn_level_actor_t * actor)
       return;
       break;
   }
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -5270,21 +5337,10 @@ void fn_level_actor_function_shootable_wall_create(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_shootable_wall_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  FnTexture * tile = NULL;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-
-  tile = fn_tilecache_get_tile(tc, 0x8C0/0x20);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-  tile = fn_tilecache_get_tile(tc, 0x1800/0x20);
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, 0x8C0/0x20,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, 0x1800/0x20,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -5334,7 +5390,7 @@ typedef struct fn_level_actor_accesscard_door_data_t
  */
 void fn_level_actor_function_access_card_door_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_accesscard_door_data_t * data = malloc(
+  fn_level_actor_accesscard_door_data_t * data = calloc(1,
       sizeof(fn_level_actor_accesscard_door_data_t));
   actor->data = data;
   actor->position.w = FN_TILE_WIDTH;
@@ -5348,6 +5404,20 @@ void fn_level_actor_function_access_card_door_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_access_card_door_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_accesscard_door_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_access_card_door_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_accesscard_door_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 /**
  * Delete an accesscard door.
  *
@@ -5368,18 +5438,9 @@ void fn_level_actor_function_access_card_door_free(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_access_card_door_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
   fn_level_actor_accesscard_door_data_t * data = actor->data;
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame);
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -5418,7 +5479,7 @@ typedef struct fn_level_actor_spike_data_t {
  */
 void fn_level_actor_function_spikes_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_spike_data_t * data = malloc(
+  fn_level_actor_spike_data_t * data = calloc(1,
       sizeof(fn_level_actor_spike_data_t));
   actor->data = data;
   data->touching_hero = 0;
@@ -5429,6 +5490,20 @@ void fn_level_actor_function_spikes_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_spikes_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_spike_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_spikes_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_spike_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 
 /**
  * Spikes actor deletion function.
@@ -5482,28 +5557,20 @@ void fn_level_actor_function_spikes_touch_end(fn_level_actor_t * actor)
  */
 void fn_level_actor_function_spikes_blit(fn_level_actor_t * actor)
 {
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-  FnTexture * tile = NULL;
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
+  Uint16 tile = 0;
   fn_level_actor_spike_data_t * data = actor->data;
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
   switch(actor->type) {
     case FN_LEVEL_ACTOR_SPIKES_UP:
-      tile = fn_tilecache_get_tile(tc, OBJ_SPIKES_UP);
+      tile = OBJ_SPIKES_UP;
       break;
     case FN_LEVEL_ACTOR_SPIKES_DOWN:
-      tile = fn_tilecache_get_tile(tc, OBJ_SPIKES_DOWN);
+      tile = OBJ_SPIKES_DOWN;
       break;
     case FN_LEVEL_ACTOR_SPIKE:
       if (data->touching_hero) {
-        tile = fn_tilecache_get_tile(tc, OBJ_SPIKE + 1);
+        tile = OBJ_SPIKE + 1;
       } else {
-        tile = fn_tilecache_get_tile(tc, OBJ_SPIKE);
+        tile = OBJ_SPIKE;
       }
 
       break;
@@ -5514,7 +5581,8 @@ void fn_level_actor_function_spikes_blit(fn_level_actor_t * actor)
       return;
       break;
   }
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, tile,
+      actor->position.x, actor->position.y);
 }
 
 /* --------------------------------------------------------------- */
@@ -5546,7 +5614,7 @@ typedef struct fn_level_actor_fan_data_t {
 
 void fn_level_actor_function_fan_create(fn_level_actor_t * actor)
 {
-  fn_level_actor_fan_data_t * data = malloc(
+  fn_level_actor_fan_data_t * data = calloc(1,
       sizeof(fn_level_actor_fan_data_t));
   actor->data = data;
   data->tile = ANIM_FAN;
@@ -5560,6 +5628,20 @@ void fn_level_actor_function_fan_create(fn_level_actor_t * actor)
 
 /* --------------------------------------------------------------- */
 
+void fn_level_actor_function_fan_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_serialize_data(actor, sizeof(fn_level_actor_fan_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_function_fan_deserialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_deserialize_data(actor, sizeof(fn_level_actor_fan_data_t));
+}
+
+/* --------------------------------------------------------------- */
+
 void fn_level_actor_function_fan_free(fn_level_actor_t * actor)
 {
   fn_level_actor_fan_data_t * data = actor->data;
@@ -5653,23 +5735,10 @@ void fn_level_actor_function_fan_blit(fn_level_actor_t * actor)
 {
   fn_level_actor_fan_data_t * data = actor->data;
 
-  SDL_Surface * target = fn_level_get_surface(actor->level);
-  SDL_Rect destrect;
-  fn_tilecache_t * tc = fn_level_get_tilecache(actor->level);
-
-  Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
-  FnTexture * tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame * 2);
-  destrect.x = actor->position.x * pixelsize;
-  destrect.y = actor->position.y * pixelsize;
-  destrect.w = actor->position.w * pixelsize;
-  destrect.h = actor->position.h * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
-
-  tile = fn_tilecache_get_tile(tc,
-      data->tile + data->current_frame * 2 + 1);
-  destrect.y += FN_TILE_HEIGHT * pixelsize;
-  fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame * 2,
+      actor->position.x, actor->position.y);
+  fn_level_actor_draw_tile(actor, data->tile + data->current_frame * 2 + 1,
+      actor->position.x, actor->position.y + FN_TILE_HEIGHT);
 }
 
 /* --------------------------------------------------------------- */
@@ -5713,6 +5782,10 @@ void
       fn_level_actor_function_firewheelbot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_firewheelbot_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_firewheelbot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_firewheelbot_deserialize,
   },
   [FN_LEVEL_ACTOR_FLAMEGNOMEBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5724,6 +5797,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_FLYINGBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5735,6 +5810,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_FOOTBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5746,6 +5823,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_HELICOPTERBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5757,6 +5836,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_RABBITOIDBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5768,6 +5849,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_REDBALL_JUMPING] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5786,6 +5869,10 @@ void
       fn_level_actor_function_redball_jumping_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_redball_jumping_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_redball_jumping_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_redball_jumping_deserialize,
   },
   [FN_LEVEL_ACTOR_REDBALL_LYING] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5802,6 +5889,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_redball_lying_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_redball_lying_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_redball_lying_deserialize,
   },
   [FN_LEVEL_ACTOR_ROBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5820,6 +5911,10 @@ void
       fn_level_actor_function_robot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_robot_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_robot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_robot_deserialize,
   },
   [FN_LEVEL_ACTOR_ROBOT_DISAPPEARING] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5835,6 +5930,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_singleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_singleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_singleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_SNAKEBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5846,6 +5945,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_TANKBOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5864,6 +5965,10 @@ void
       fn_level_actor_function_tankbot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_tankbot_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_tankbot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_tankbot_deserialize,
   },
   [FN_LEVEL_ACTOR_WALLCRAWLERBOT_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5882,6 +5987,10 @@ void
       fn_level_actor_function_wallcrawler_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_wallcrawler_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_wallcrawler_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_wallcrawler_deserialize,
   },
   [FN_LEVEL_ACTOR_WALLCRAWLERBOT_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5900,6 +6009,10 @@ void
       fn_level_actor_function_wallcrawler_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_wallcrawler_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_wallcrawler_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_wallcrawler_deserialize,
   },
   [FN_LEVEL_ACTOR_DRPROTON] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -5911,6 +6024,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_CAMERA] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5925,6 +6040,10 @@ void
       fn_level_actor_function_camera_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_camera_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_EXPLOSION] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5940,6 +6059,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_explosion_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_explosion_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_explosion_deserialize,
   },
   [FN_LEVEL_ACTOR_FIRE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5955,6 +6078,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_singleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_singleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_singleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_DUSTCLOUD] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5970,6 +6097,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_singleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_singleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_singleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_STEAM] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -5985,6 +6116,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_singleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_singleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_singleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_PARTICLE_PINK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6000,6 +6135,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_particle_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_particle_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_particle_deserialize,
   },
   [FN_LEVEL_ACTOR_PARTICLE_BLUE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6015,6 +6154,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_particle_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_particle_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_particle_deserialize,
   },
   [FN_LEVEL_ACTOR_PARTICLE_WHITE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6030,6 +6173,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_particle_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_particle_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_particle_deserialize,
   },
   [FN_LEVEL_ACTOR_PARTICLE_GREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6045,6 +6192,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_particle_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_particle_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_particle_deserialize,
   },
   [FN_LEVEL_ACTOR_ROCKET] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6061,6 +6212,10 @@ void
       fn_level_actor_function_rocket_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_rocket_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_rocket_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_rocket_deserialize,
   },
   [FN_LEVEL_ACTOR_BOMB] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6076,6 +6231,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_bomb_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_bomb_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_bomb_deserialize,
   },
   [FN_LEVEL_ACTOR_BOMBFIRE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6093,6 +6252,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_bombfire_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_bombfire_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_bombfire_deserialize,
   },
   [FN_LEVEL_ACTOR_WATER] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -6104,6 +6267,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_EXITDOOR] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6120,6 +6285,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_exitdoor_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_exitdoor_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_exitdoor_deserialize,
   },
   [FN_LEVEL_ACTOR_NOTEBOOK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6135,6 +6304,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_notebook_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_SURVEILLANCESCREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6150,6 +6323,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_surveillancescreen_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_HOSTILESHOT_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6167,6 +6344,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_hostileshot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_hostileshot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_hostileshot_deserialize,
   },
   [FN_LEVEL_ACTOR_HOSTILESHOT_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6184,6 +6365,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_hostileshot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_hostileshot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_hostileshot_deserialize,
   },
   [FN_LEVEL_ACTOR_SODA] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6202,6 +6387,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_SODA_FLYING] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6218,6 +6407,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_soda_flying_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_UNSTABLEFLOOR] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6233,6 +6426,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_unstablefloor_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_unstablefloor_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_unstablefloor_deserialize,
   },
   [FN_LEVEL_ACTOR_EXPANDINGFLOOR] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6248,6 +6445,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_expandingfloor_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_CONVEYOR_LEFTMOVING_RIGHTEND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6263,6 +6464,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_conveyor_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_conveyor_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_conveyor_deserialize,
   },
   [FN_LEVEL_ACTOR_CONVEYOR_RIGHTMOVING_RIGHTEND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6278,6 +6483,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_conveyor_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_conveyor_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_conveyor_deserialize,
   },
   [FN_LEVEL_ACTOR_FAN_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6294,6 +6503,10 @@ void
       fn_level_actor_function_fan_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_fan_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_fan_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_fan_deserialize,
   },
   [FN_LEVEL_ACTOR_FAN_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6310,6 +6523,10 @@ void
       fn_level_actor_function_fan_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_fan_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_fan_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_fan_deserialize,
   },
   [FN_LEVEL_ACTOR_BROKENWALL_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6325,6 +6542,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_STONE_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -6336,6 +6557,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_TELEPORTER1] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6351,6 +6574,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_teleporter_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_TELEPORTER2] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6366,6 +6593,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_teleporter_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_FENCE_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -6377,6 +6608,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_STONEWINDOW_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6392,6 +6625,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_WINDOWLEFT_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6407,6 +6644,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_WINDOWRIGHT_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6422,6 +6663,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_SCREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -6433,6 +6678,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_BOX_GREY_EMPTY] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6451,6 +6698,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_BOOTS] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6469,6 +6720,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOOTS] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6486,6 +6741,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_CLAMPS] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6504,6 +6763,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_CLAMPS] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6521,6 +6784,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_GUN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6539,6 +6806,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_GUN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6556,6 +6827,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_BOMB] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6574,6 +6849,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_RED_SODA] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6592,6 +6871,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_RED_CHICKEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6610,6 +6893,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_CHICKEN_SINGLE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6628,6 +6915,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_CHICKEN_DOUBLE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6645,6 +6936,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_FOOTBALL] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6663,6 +6958,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_FOOTBALL] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6680,6 +6979,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_FLAG] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6697,6 +7000,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_JOYSTICK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6715,6 +7022,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_JOYSTICK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6732,6 +7043,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_DISK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6750,6 +7065,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_DISK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6767,6 +7086,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_BALLOON] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6785,6 +7108,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BALLOON] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6802,6 +7129,10 @@ void
       fn_level_actor_function_balloon_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_balloon_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_balloon_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_balloon_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_GLOVE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6820,6 +7151,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_GLOVE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6837,6 +7172,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_FULL_LIFE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6855,6 +7194,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_FULL_LIFE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6872,6 +7215,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_FLAG] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6890,6 +7237,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_FLAG] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -6901,6 +7252,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_BOX_BLUE_RADIO] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6919,6 +7272,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_RADIO] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6936,6 +7293,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_ACCESS_CARD] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6954,6 +7315,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_ACCESS_CARD] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6971,6 +7336,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_LETTER_D] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -6989,6 +7358,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_LETTER_D] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7006,6 +7379,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_LETTER_U] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7024,6 +7401,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_LETTER_U] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7041,6 +7422,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_LETTER_K] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7059,6 +7444,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_LETTER_K] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7076,6 +7465,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_BOX_GREY_LETTER_E] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7094,6 +7487,10 @@ void
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_item_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_LETTER_E] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7111,6 +7508,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_item_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_item_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_item_deserialize,
   },
   [FN_LEVEL_ACTOR_ACCESS_CARD_SLOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7127,6 +7528,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_accesscard_slot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_accesscard_slot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_accesscard_slot_deserialize,
   },
   [FN_LEVEL_ACTOR_GLOVE_SLOT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7143,6 +7548,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_glove_slot_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_glove_slot_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_glove_slot_deserialize,
   },
   [FN_LEVEL_ACTOR_KEY_RED] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7157,6 +7566,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_key_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_KEYHOLE_RED] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7173,6 +7586,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_keyhole_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_keyhole_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_keyhole_deserialize,
   },
   [FN_LEVEL_ACTOR_DOOR_RED] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7188,6 +7605,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_door_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_door_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_door_deserialize,
   },
   [FN_LEVEL_ACTOR_KEY_BLUE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7202,6 +7623,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_key_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_KEYHOLE_BLUE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7218,6 +7643,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_keyhole_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_keyhole_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_keyhole_deserialize,
   },
   [FN_LEVEL_ACTOR_DOOR_BLUE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7233,6 +7662,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_door_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_door_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_door_deserialize,
   },
   [FN_LEVEL_ACTOR_KEY_PINK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7247,6 +7680,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_key_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_KEYHOLE_PINK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7263,6 +7700,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_keyhole_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_keyhole_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_keyhole_deserialize,
   },
   [FN_LEVEL_ACTOR_DOOR_PINK] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7278,6 +7719,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_door_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_door_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_door_deserialize,
   },
   [FN_LEVEL_ACTOR_KEY_GREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7292,6 +7737,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_key_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_KEYHOLE_GREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7308,6 +7757,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_keyhole_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_keyhole_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_keyhole_deserialize,
   },
   [FN_LEVEL_ACTOR_DOOR_GREEN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7323,6 +7776,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_door_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_door_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_door_deserialize,
   },
   [FN_LEVEL_ACTOR_SHOOTABLE_WALL] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7337,6 +7794,10 @@ void
       fn_level_actor_function_shootable_wall_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_shootable_wall_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_nodata_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_nodata_deserialize,
   },
   [FN_LEVEL_ACTOR_LIFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7354,6 +7815,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_lift_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_lift_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_lift_deserialize,
   },
   [FN_LEVEL_ACTOR_ACME] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7371,6 +7836,10 @@ void
       fn_level_actor_function_acme_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_acme_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_acme_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_acme_deserialize,
   },
   [FN_LEVEL_ACTOR_FIRE_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7388,6 +7857,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_fire_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_fire_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_fire_deserialize,
   },
   [FN_LEVEL_ACTOR_FIRE_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7405,6 +7878,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_fire_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_fire_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_fire_deserialize,
   },
   [FN_LEVEL_ACTOR_MILL] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7422,6 +7899,10 @@ void
       fn_level_actor_function_mill_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                =
       fn_level_actor_function_mill_shot,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_mill_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_mill_deserialize,
   },
   [FN_LEVEL_ACTOR_LASERBEAM] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              = NULL, /* TODO */
@@ -7433,6 +7914,8 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_ACT]                 = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                = NULL, /* TODO */
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           = NULL, /* TODO */
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         = NULL, /* TODO */
   },
   [FN_LEVEL_ACTOR_ACCESS_CARD_DOOR] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7448,6 +7931,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_access_card_door_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_access_card_door_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_access_card_door_deserialize,
   },
   [FN_LEVEL_ACTOR_SPIKES_UP] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7464,6 +7951,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_spikes_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_spikes_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_spikes_deserialize,
   },
   [FN_LEVEL_ACTOR_SPIKES_DOWN] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7480,6 +7971,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_spikes_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_spikes_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_spikes_deserialize,
   },
   [FN_LEVEL_ACTOR_SPIKE] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7496,6 +7991,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_spikes_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_spikes_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_spikes_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_100] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7511,6 +8010,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_200] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7526,6 +8029,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_500] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7541,6 +8048,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_1000] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7556,6 +8067,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_2000] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7571,6 +8086,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_5000] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7586,6 +8105,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_10000] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7601,6 +8124,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_1_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7616,6 +8143,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_1_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7631,6 +8162,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_2_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7646,6 +8181,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_2_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7661,6 +8200,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_3_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7676,6 +8219,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_3_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7691,6 +8238,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_4_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7706,6 +8257,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_4_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7721,6 +8276,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_5_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7736,6 +8295,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_5_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7751,6 +8314,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_6_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7766,6 +8333,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_6_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7781,6 +8352,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_7_LEFT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7796,6 +8371,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_SCORE_BONUS_7_RIGHT] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7811,6 +8390,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_score_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_score_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_score_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND1] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7826,6 +8409,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND2] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7841,6 +8428,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND3] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7856,6 +8447,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND4] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7871,6 +8466,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_TEXT_ON_SCREEN_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7886,6 +8485,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_HIGH_VOLTAGE_FLASH_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7901,6 +8504,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_RED_FLASHLIGHT_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7916,6 +8523,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_BLUE_FLASHLIGHT_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7931,6 +8542,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_KEYPANEL_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7946,6 +8561,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_RED_ROTATIONLIGHT_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7961,6 +8580,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_UPARROW_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7976,6 +8599,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_GREEN_POISON_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -7991,6 +8618,10 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
   [FN_LEVEL_ACTOR_LAVA_BACKGROUND] = {
     [FN_LEVEL_ACTOR_FUNCTION_CREATE]              =
@@ -8006,11 +8637,202 @@ void
     [FN_LEVEL_ACTOR_FUNCTION_BLIT]                =
       fn_level_actor_function_simpleanimation_blit,
     [FN_LEVEL_ACTOR_FUNCTION_SHOT]                = NULL,
+    [FN_LEVEL_ACTOR_FUNCTION_SERIALIZE]           =
+      fn_level_actor_function_simpleanimation_serialize,
+    [FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE]         =
+      fn_level_actor_function_simpleanimation_deserialize,
   },
 };
 
 /* --------------------------------------------------------------- */
 
+/**
+ * The names of the actor types, used for reports.
+ */
+static char * fn_level_actor_type_names[FN_LEVEL_ACTOR_NUM_TYPES] = {
+  [FN_LEVEL_ACTOR_FIREWHEELBOT] = "firewheelbot",
+  [FN_LEVEL_ACTOR_FLAMEGNOMEBOT] = "flamegnomebot",
+  [FN_LEVEL_ACTOR_FLYINGBOT] = "flyingbot",
+  [FN_LEVEL_ACTOR_FOOTBOT] = "footbot",
+  [FN_LEVEL_ACTOR_HELICOPTERBOT] = "helicopterbot",
+  [FN_LEVEL_ACTOR_RABBITOIDBOT] = "rabbitoidbot",
+  [FN_LEVEL_ACTOR_REDBALL_JUMPING] = "redball_jumping",
+  [FN_LEVEL_ACTOR_REDBALL_LYING] = "redball_lying",
+  [FN_LEVEL_ACTOR_ROBOT] = "robot",
+  [FN_LEVEL_ACTOR_ROBOT_DISAPPEARING] = "robot_disappearing",
+  [FN_LEVEL_ACTOR_SNAKEBOT] = "snakebot",
+  [FN_LEVEL_ACTOR_TANKBOT] = "tankbot",
+  [FN_LEVEL_ACTOR_WALLCRAWLERBOT_LEFT] = "wallcrawlerbot_left",
+  [FN_LEVEL_ACTOR_WALLCRAWLERBOT_RIGHT] = "wallcrawlerbot_right",
+  [FN_LEVEL_ACTOR_DRPROTON] = "drproton",
+  [FN_LEVEL_ACTOR_CAMERA] = "camera",
+  [FN_LEVEL_ACTOR_EXPLOSION] = "explosion",
+  [FN_LEVEL_ACTOR_FIRE] = "fire",
+  [FN_LEVEL_ACTOR_DUSTCLOUD] = "dustcloud",
+  [FN_LEVEL_ACTOR_STEAM] = "steam",
+  [FN_LEVEL_ACTOR_PARTICLE_PINK] = "particle_pink",
+  [FN_LEVEL_ACTOR_PARTICLE_BLUE] = "particle_blue",
+  [FN_LEVEL_ACTOR_PARTICLE_WHITE] = "particle_white",
+  [FN_LEVEL_ACTOR_PARTICLE_GREEN] = "particle_green",
+  [FN_LEVEL_ACTOR_ROCKET] = "rocket",
+  [FN_LEVEL_ACTOR_BOMB] = "bomb",
+  [FN_LEVEL_ACTOR_BOMBFIRE] = "bombfire",
+  [FN_LEVEL_ACTOR_WATER] = "water",
+  [FN_LEVEL_ACTOR_EXITDOOR] = "exitdoor",
+  [FN_LEVEL_ACTOR_NOTEBOOK] = "notebook",
+  [FN_LEVEL_ACTOR_SURVEILLANCESCREEN] = "surveillancescreen",
+  [FN_LEVEL_ACTOR_HOSTILESHOT_LEFT] = "hostileshot_left",
+  [FN_LEVEL_ACTOR_HOSTILESHOT_RIGHT] = "hostileshot_right",
+  [FN_LEVEL_ACTOR_SODA] = "soda",
+  [FN_LEVEL_ACTOR_SODA_FLYING] = "soda_flying",
+  [FN_LEVEL_ACTOR_UNSTABLEFLOOR] = "unstablefloor",
+  [FN_LEVEL_ACTOR_EXPANDINGFLOOR] = "expandingfloor",
+  [FN_LEVEL_ACTOR_CONVEYOR_LEFTMOVING_RIGHTEND] = "conveyor_leftmoving_rightend",
+  [FN_LEVEL_ACTOR_CONVEYOR_RIGHTMOVING_RIGHTEND] = "conveyor_rightmoving_rightend",
+  [FN_LEVEL_ACTOR_FAN_LEFT] = "fan_left",
+  [FN_LEVEL_ACTOR_FAN_RIGHT] = "fan_right",
+  [FN_LEVEL_ACTOR_BROKENWALL_BACKGROUND] = "brokenwall_background",
+  [FN_LEVEL_ACTOR_STONE_BACKGROUND] = "stone_background",
+  [FN_LEVEL_ACTOR_TELEPORTER1] = "teleporter1",
+  [FN_LEVEL_ACTOR_TELEPORTER2] = "teleporter2",
+  [FN_LEVEL_ACTOR_FENCE_BACKGROUND] = "fence_background",
+  [FN_LEVEL_ACTOR_STONEWINDOW_BACKGROUND] = "stonewindow_background",
+  [FN_LEVEL_ACTOR_WINDOWLEFT_BACKGROUND] = "windowleft_background",
+  [FN_LEVEL_ACTOR_WINDOWRIGHT_BACKGROUND] = "windowright_background",
+  [FN_LEVEL_ACTOR_SCREEN] = "screen",
+  [FN_LEVEL_ACTOR_BOX_GREY_EMPTY] = "box_grey_empty",
+  [FN_LEVEL_ACTOR_BOX_GREY_BOOTS] = "box_grey_boots",
+  [FN_LEVEL_ACTOR_BOOTS] = "boots",
+  [FN_LEVEL_ACTOR_BOX_GREY_CLAMPS] = "box_grey_clamps",
+  [FN_LEVEL_ACTOR_CLAMPS] = "clamps",
+  [FN_LEVEL_ACTOR_BOX_GREY_GUN] = "box_grey_gun",
+  [FN_LEVEL_ACTOR_GUN] = "gun",
+  [FN_LEVEL_ACTOR_BOX_GREY_BOMB] = "box_grey_bomb",
+  [FN_LEVEL_ACTOR_BOX_RED_SODA] = "box_red_soda",
+  [FN_LEVEL_ACTOR_BOX_RED_CHICKEN] = "box_red_chicken",
+  [FN_LEVEL_ACTOR_CHICKEN_SINGLE] = "chicken_single",
+  [FN_LEVEL_ACTOR_CHICKEN_DOUBLE] = "chicken_double",
+  [FN_LEVEL_ACTOR_BOX_BLUE_FOOTBALL] = "box_blue_football",
+  [FN_LEVEL_ACTOR_FOOTBALL] = "football",
+  [FN_LEVEL_ACTOR_FLAG] = "flag",
+  [FN_LEVEL_ACTOR_BOX_BLUE_JOYSTICK] = "box_blue_joystick",
+  [FN_LEVEL_ACTOR_JOYSTICK] = "joystick",
+  [FN_LEVEL_ACTOR_BOX_BLUE_DISK] = "box_blue_disk",
+  [FN_LEVEL_ACTOR_DISK] = "disk",
+  [FN_LEVEL_ACTOR_BOX_BLUE_BALLOON] = "box_blue_balloon",
+  [FN_LEVEL_ACTOR_BALLOON] = "balloon",
+  [FN_LEVEL_ACTOR_BOX_GREY_GLOVE] = "box_grey_glove",
+  [FN_LEVEL_ACTOR_GLOVE] = "glove",
+  [FN_LEVEL_ACTOR_BOX_GREY_FULL_LIFE] = "box_grey_full_life",
+  [FN_LEVEL_ACTOR_FULL_LIFE] = "full_life",
+  [FN_LEVEL_ACTOR_BOX_BLUE_FLAG] = "box_blue_flag",
+  [FN_LEVEL_ACTOR_BLUE_FLAG] = "blue_flag",
+  [FN_LEVEL_ACTOR_BOX_BLUE_RADIO] = "box_blue_radio",
+  [FN_LEVEL_ACTOR_RADIO] = "radio",
+  [FN_LEVEL_ACTOR_BOX_GREY_ACCESS_CARD] = "box_grey_access_card",
+  [FN_LEVEL_ACTOR_ACCESS_CARD] = "access_card",
+  [FN_LEVEL_ACTOR_BOX_GREY_LETTER_D] = "box_grey_letter_d",
+  [FN_LEVEL_ACTOR_LETTER_D] = "letter_d",
+  [FN_LEVEL_ACTOR_BOX_GREY_LETTER_U] = "box_grey_letter_u",
+  [FN_LEVEL_ACTOR_LETTER_U] = "letter_u",
+  [FN_LEVEL_ACTOR_BOX_GREY_LETTER_K] = "box_grey_letter_k",
+  [FN_LEVEL_ACTOR_LETTER_K] = "letter_k",
+  [FN_LEVEL_ACTOR_BOX_GREY_LETTER_E] = "box_grey_letter_e",
+  [FN_LEVEL_ACTOR_LETTER_E] = "letter_e",
+  [FN_LEVEL_ACTOR_ACCESS_CARD_SLOT] = "access_card_slot",
+  [FN_LEVEL_ACTOR_GLOVE_SLOT] = "glove_slot",
+  [FN_LEVEL_ACTOR_KEY_RED] = "key_red",
+  [FN_LEVEL_ACTOR_KEYHOLE_RED] = "keyhole_red",
+  [FN_LEVEL_ACTOR_DOOR_RED] = "door_red",
+  [FN_LEVEL_ACTOR_KEY_BLUE] = "key_blue",
+  [FN_LEVEL_ACTOR_KEYHOLE_BLUE] = "keyhole_blue",
+  [FN_LEVEL_ACTOR_DOOR_BLUE] = "door_blue",
+  [FN_LEVEL_ACTOR_KEY_PINK] = "key_pink",
+  [FN_LEVEL_ACTOR_KEYHOLE_PINK] = "keyhole_pink",
+  [FN_LEVEL_ACTOR_DOOR_PINK] = "door_pink",
+  [FN_LEVEL_ACTOR_KEY_GREEN] = "key_green",
+  [FN_LEVEL_ACTOR_KEYHOLE_GREEN] = "keyhole_green",
+  [FN_LEVEL_ACTOR_DOOR_GREEN] = "door_green",
+  [FN_LEVEL_ACTOR_SHOOTABLE_WALL] = "shootable_wall",
+  [FN_LEVEL_ACTOR_LIFT] = "lift",
+  [FN_LEVEL_ACTOR_ACME] = "acme",
+  [FN_LEVEL_ACTOR_FIRE_RIGHT] = "fire_right",
+  [FN_LEVEL_ACTOR_FIRE_LEFT] = "fire_left",
+  [FN_LEVEL_ACTOR_MILL] = "mill",
+  [FN_LEVEL_ACTOR_LASERBEAM] = "laserbeam",
+  [FN_LEVEL_ACTOR_ACCESS_CARD_DOOR] = "access_card_door",
+  [FN_LEVEL_ACTOR_SPIKES_UP] = "spikes_up",
+  [FN_LEVEL_ACTOR_SPIKES_DOWN] = "spikes_down",
+  [FN_LEVEL_ACTOR_SPIKE] = "spike",
+  [FN_LEVEL_ACTOR_SCORE_100] = "score_100",
+  [FN_LEVEL_ACTOR_SCORE_200] = "score_200",
+  [FN_LEVEL_ACTOR_SCORE_500] = "score_500",
+  [FN_LEVEL_ACTOR_SCORE_1000] = "score_1000",
+  [FN_LEVEL_ACTOR_SCORE_2000] = "score_2000",
+  [FN_LEVEL_ACTOR_SCORE_5000] = "score_5000",
+  [FN_LEVEL_ACTOR_SCORE_10000] = "score_10000",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_1_LEFT] = "score_bonus_1_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_1_RIGHT] = "score_bonus_1_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_2_LEFT] = "score_bonus_2_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_2_RIGHT] = "score_bonus_2_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_3_LEFT] = "score_bonus_3_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_3_RIGHT] = "score_bonus_3_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_4_LEFT] = "score_bonus_4_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_4_RIGHT] = "score_bonus_4_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_5_LEFT] = "score_bonus_5_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_5_RIGHT] = "score_bonus_5_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_6_LEFT] = "score_bonus_6_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_6_RIGHT] = "score_bonus_6_right",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_7_LEFT] = "score_bonus_7_left",
+  [FN_LEVEL_ACTOR_SCORE_BONUS_7_RIGHT] = "score_bonus_7_right",
+  [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND1] = "blue_light_background1",
+  [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND2] = "blue_light_background2",
+  [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND3] = "blue_light_background3",
+  [FN_LEVEL_ACTOR_BLUE_LIGHT_BACKGROUND4] = "blue_light_background4",
+  [FN_LEVEL_ACTOR_TEXT_ON_SCREEN_BACKGROUND] = "text_on_screen_background",
+  [FN_LEVEL_ACTOR_HIGH_VOLTAGE_FLASH_BACKGROUND] = "high_voltage_flash_background",
+  [FN_LEVEL_ACTOR_RED_FLASHLIGHT_BACKGROUND] = "red_flashlight_background",
+  [FN_LEVEL_ACTOR_BLUE_FLASHLIGHT_BACKGROUND] = "blue_flashlight_background",
+  [FN_LEVEL_ACTOR_KEYPANEL_BACKGROUND] = "keypanel_background",
+  [FN_LEVEL_ACTOR_RED_ROTATIONLIGHT_BACKGROUND] = "red_rotationlight_background",
+  [FN_LEVEL_ACTOR_UPARROW_BACKGROUND] = "uparrow_background",
+  [FN_LEVEL_ACTOR_GREEN_POISON_BACKGROUND] = "green_poison_background",
+  [FN_LEVEL_ACTOR_LAVA_BACKGROUND] = "lava_background",
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Call an actor function. If actor costs are profiled, the time
+ * it takes is added to the costs of the actor type.
+ */
+#define FN_LEVEL_ACTOR_CALL(func, actor, callback) \
+  do { \
+    if (fn_profile_actors_enabled) { \
+      fn_level_actor_type_e calltype = (actor)->type; \
+      Uint64 callstart = fn_profile_nsec(); \
+      func(actor); \
+      fn_profile_actor_add(calltype, callback, \
+          fn_profile_nsec() - callstart); \
+    } else { \
+      func(actor); \
+    } \
+  } while (0)
+
+/* --------------------------------------------------------------- */
+
+char * fn_level_actor_type_name(fn_level_actor_type_e type)
+{
+  if (type >= FN_LEVEL_ACTOR_NUM_TYPES ||
+      fn_level_actor_type_names[type] == NULL)
+  {
+    return "unknown";
+  }
+  return fn_level_actor_type_names[type];
+}
+
+/* --------------------------------------------------------------- */
+
 fn_level_actor_t * fn_level_actor_create(fn_level_t * level,
     fn_level_actor_type_e type,
     Uint16 x,
@@ -8029,9 +8851,14 @@ fn_level_actor_t * fn_level_actor_create(fn_level_t * level,
   actor->is_in_foreground = 0;
   actor->is_visible = 0;
   actor->acts_while_invisible = 0;
+  actor->sequence = 0;
+  actor->schedule = 0;
+  actor->region = 0;
+  actor->next_dormant = NULL;
+  actor->spawn = -1;
   func = fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_CREATE];
   if (func != NULL) {
-    func(actor);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_CREATE);
   }
   return actor;
 }
@@ -8083,7 +8910,7 @@ void fn_level_actor_hero_touch_start(fn_level_actor_t * actor)
   fn_level_actor_function_t func =
     fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_HERO_TOUCH_START];
   if (func != NULL) {
-    func(actor);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_TOUCH);
   }
 }
 
@@ -8094,7 +8921,7 @@ void fn_level_actor_hero_touch_end(fn_level_actor_t * actor)
   fn_level_actor_function_t func =
     fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_HERO_TOUCH_END];
   if (func != NULL) {
-    func(actor);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_TOUCH);
   }
 }
 
@@ -8151,7 +8978,7 @@ int fn_level_actor_act(fn_level_actor_t * actor)
     fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_ACT];
   if (func != NULL)
   {
-    func(actor);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_ACT);
   }
   return actor->is_alive;
 }
@@ -8163,15 +8990,16 @@ void fn_level_actor_blit(fn_level_actor_t * actor)
   fn_level_actor_function_t func =
     fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_BLIT];
   if (func != NULL) {
-    func(actor);
-    SDL_Surface * target = fn_level_get_surface(actor->level);
-    Uint8 pixelsize = fn_level_get_pixelsize(actor->level);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_BLIT);
     Uint8 draw_collision_bounds =
       fn_environment_get_draw_collision_bounds(
           fn_level_get_environment(actor->level));
     if (draw_collision_bounds) {
-      fn_collision_area_draw(target, pixelsize,
-          actor->position.x, actor->position.y, actor->position.w, actor->position.h);
+      fn_level_draw_bounds(actor->level,
+          actor->position.x, actor->position.y,
+          actor->position.w, actor->position.h,
+          actor->is_in_foreground ?
+          FN_LEVEL_LAYER_FOREGROUND : FN_LEVEL_LAYER_BACKGROUND);
     }
   }
 }
@@ -8183,7 +9011,7 @@ Uint8 fn_level_actor_shot(fn_level_actor_t * actor)
   fn_level_actor_function_t func =
     fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_SHOT];
   if (func != NULL) {
-    func(actor);
+    FN_LEVEL_ACTOR_CALL(func, actor, FN_PROFILE_CALLBACK_SHOT);
     return 1;
   }
   return 0;
@@ -8253,3 +9081,75 @@ Uint8 fn_level_actor_is_visible(fn_level_actor_t * actor)
 {
   return actor->is_visible;
 }
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_level_actor_can_serialize(fn_level_actor_t * actor)
+{
+  fn_level_actor_function_t func =
+    fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_SERIALIZE];
+  return (func != NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_level_actor_serialize(fn_level_actor_t * actor)
+{
+  fn_snapshot_t * snapshot = actor->level->snapshot;
+  fn_level_actor_function_t func =
+    fn_level_actor_functions[actor->type][FN_LEVEL_ACTOR_FUNCTION_SERIALIZE];
+  Uint16 type = actor->type;
+
+  if (func == NULL) {
+    return;
+  }
+  fn_snapshot_write_value(snapshot, type);
+  fn_snapshot_write_value(snapshot, actor->position);
+  fn_snapshot_write_value(snapshot, actor->is_alive);
+  fn_snapshot_write_value(snapshot, actor->touches_hero);
+  fn_snapshot_write_value(snapshot, actor->is_in_foreground);
+  fn_snapshot_write_value(snapshot, actor->is_visible);
+  fn_snapshot_write_value(snapshot, actor->acts_while_invisible);
+  fn_snapshot_write_value(snapshot, actor->sequence);
+  fn_snapshot_write_value(snapshot, actor->spawn);
+  func(actor);
+}
+
+/* --------------------------------------------------------------- */
+
+fn_level_actor_t * fn_level_actor_deserialize(fn_level_t * level)
+{
+  fn_snapshot_t * snapshot = level->snapshot;
+  fn_level_actor_function_t func = NULL;
+  fn_level_actor_t * actor = NULL;
+  Uint16 type = 0;
+
+  if (!fn_snapshot_read_value(snapshot, type) ||
+      type >= FN_LEVEL_ACTOR_NUM_TYPES)
+  {
+    return NULL;
+  }
+  func = fn_level_actor_functions[type][FN_LEVEL_ACTOR_FUNCTION_DESERIALIZE];
+  if (func == NULL) {
+    return NULL;
+  }
+
+  actor = malloc(sizeof(fn_level_actor_t));
+  actor->level = level;
+  actor->type = type;
+  actor->data = NULL;
+  fn_snapshot_read_value(snapshot, actor->position);
+  fn_snapshot_read_value(snapshot, actor->is_alive);
+  fn_snapshot_read_value(snapshot, actor->touches_hero);
+  fn_snapshot_read_value(snapshot, actor->is_in_foreground);
+  fn_snapshot_read_value(snapshot, actor->is_visible);
+  fn_snapshot_read_value(snapshot, actor->acts_while_invisible);
+  fn_snapshot_read_value(snapshot, actor->sequence);
+  fn_snapshot_read_value(snapshot, actor->spawn);
+  /* the level schedules the actor anew */
+  actor->schedule = 0;
+  actor->region = 0;
+  actor->next_dormant = NULL;
+  func(actor);
+  return actor;
+}
@@ -251,6 +251,31 @@ struct fn_level_actor_t {
    * Does the actor act even if outside the visible area?
    */
   Uint8 acts_while_invisible;
+
+  /**
+   * The order in which the actor was added to the level. The
+   * actors act and are drawn in this order.
+   */
+  Uint32 sequence;
+
+  /**
+   * Where the scheduler of the level keeps the actor, one of
+   * fn_level_schedule_e.
+   */
+  Uint8 schedule;
+
+  /**
+   * The region the actor sleeps in while it is dormant, and the
+   * next dormant actor of that region.
+   */
+  Uint16 region;
+  fn_level_actor_t * next_dormant;
+
+  /**
+   * The spawn record of the level the actor was created from,
+   * or -1 if it was created right away.
+   */
+  Sint16 spawn;
 };
 
 /* --------------------------------------------------------------- */
@@ -483,4 +508,47 @@ Uint8 fn_level_actor_is_visible(fn_level_actor_t * actor);
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Get the name of an actor type.
+ *
+ * @param  type  The actor type.
+ *
+ * @return The name of the actor type.
+ */
+char * fn_level_actor_type_name(fn_level_actor_type_e type);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Tells if an actor can be stored in a snapshot.
+ *
+ * @param  actor  The actor.
+ *
+ * @return 1 if the actor has a serialize function, otherwise 0.
+ */
+Uint8 fn_level_actor_can_serialize(fn_level_actor_t * actor);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Write the actor to the snapshot of its level.
+ *
+ * @param  actor  The actor.
+ */
+void fn_level_actor_serialize(fn_level_actor_t * actor);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read the next actor from the snapshot of a level.
+ *
+ * @param  level  The level.
+ *
+ * @return The newly created actor, or NULL if the snapshot
+ *         contains no valid actor at the read position.
+ */
+fn_level_actor_t * fn_level_actor_deserialize(fn_level_t * level);
+
+/* --------------------------------------------------------------- */
+
 #endif /* FN_LEVEL_ACTOR_H */
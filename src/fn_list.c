@@ -62,6 +62,25 @@ fn_list_t * fn_list_append(fn_list_t * list,
 
 /* --------------------------------------------------------------- */
 
+fn_list_t * fn_list_insert_after(fn_list_t * list,
+    fn_list_t * entry,
+    void * data)
+{
+  fn_list_t * newitem = malloc(sizeof(fn_list_t));
+  newitem->data = data;
+
+  if (entry != NULL) {
+    newitem->next = entry->next;
+    entry->next = newitem;
+  } else {
+    newitem->next = list;
+    list = newitem;
+  }
+  return list;
+}
+
+/* --------------------------------------------------------------- */
+
 fn_list_t * fn_list_first(fn_list_t * list)
 {
   return list;
@@ -125,21 +144,16 @@ fn_list_t * fn_list_remove_all(fn_list_t * list, void * data)
     if (current->data == data) {
       /* found an occurrence - remove it */
       fn_list_t * todelete = current;
+      current = current->next;
       if (prev != NULL) {
-        prev->next = current->next;
-        current = prev;
+        prev->next = current;
       } else {
-        list = current->next;
-        current = list;
+        list = current;
       }
       free(todelete); todelete = NULL;
-    }
-
-    prev = current;
-    if (prev != NULL) {
-      current = prev->next;
     } else {
-      current = NULL;
+      prev = current;
+      current = current->next;
     }
   }
 
@@ -57,6 +57,22 @@ fn_list_t * fn_list_append(fn_list_t * list,
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Insert an item after a list element.
+ *
+ * @param  list   The list.
+ * @param  entry  The element after which to insert the item, or
+ *                NULL to insert it at the beginning.
+ * @param  data   The data object to insert.
+ *
+ * @return The new list.
+ */
+fn_list_t * fn_list_insert_after(fn_list_t * list,
+    fn_list_t * entry,
+    void * data);
+
+/* --------------------------------------------------------------- */
+
 /**
  * Get the first iterator.
  *
@@ -137,7 +137,7 @@ char fn_menu_get_choice(fn_menu_t * menu,
   }
   *walker = '\0';
 
-  FnTexture * box = fn_msgbox(
+  FnTexture * box = fn_msgbox_cached(
       env,
       placeholder);
   free(placeholder);
@@ -153,8 +153,9 @@ char fn_menu_get_choice(fn_menu_t * menu,
         box_width,
         box_height,
         graphic_options);
+  fn_texture_set_category(target, FN_TEXTURE_CATEGORY_UI);
 
-  FnGeometry * targetrect;
+  FnRect targetrect;
 
   Uint8 pixelsize = fn_environment_get_pixelsize(env);
 
@@ -203,36 +204,30 @@ char fn_menu_get_choice(fn_menu_t * menu,
           iter != fn_list_last(menu->entries);
           iter = fn_list_next(iter))
       {
-        targetrect = fn_geometry_new(
-            FN_FONT_WIDTH * pixelsize * 3,
-            FN_FONT_HEIGHT * pixelsize * (i + textrows + 1),
-            FN_FONT_WIDTH * pixelsize * menu->width,
-            FN_FONT_HEIGHT * pixelsize
-            );
+        targetrect.x = FN_FONT_WIDTH * pixelsize * 3;
+        targetrect.y = FN_FONT_HEIGHT * pixelsize * (i + textrows + 1);
+        targetrect.width = FN_FONT_WIDTH * pixelsize * menu->width;
+        targetrect.height = FN_FONT_HEIGHT * pixelsize;
 
         entry = (fn_menuentry_t *)iter->data;
-        fn_text_print(
+        fn_text_print_cached(
             target,
-            targetrect,
+            &targetrect,
             env,
             entry->name
             );
         if (i == menu->currententry) {
-          fn_geometry_set_x(targetrect,
-              fn_geometry_get_x(targetrect) -
-              FN_FONT_WIDTH * pixelsize * 2);
-          pointrect.y = fn_geometry_get_y(targetrect) + destrect.y;
-          fn_texture_clone_to_texture(
+          targetrect.x -= FN_FONT_WIDTH * pixelsize * 2;
+          pointrect.y = targetrect.y + destrect.y;
+          fn_texture_clone_rect(
               fn_environment_get_tile(
                 env,
                 OBJ_POINT + animationframe),
               NULL,
               target,
-              targetrect);
+              &targetrect);
         }
         i++;
-
-        g_object_unref(targetrect);
       }
 
       fn_texture_blit_to_sdl_surface(target, NULL,
@@ -34,6 +34,7 @@
 #include "fn_msgbox.h"
 #include "fn_text.h"
 #include "fntexture.h"
+#include "fn_textcache.h"
 
 /* --------------------------------------------------------------- */
 
@@ -89,7 +90,7 @@ FnTexture * fn_msgbox(
   FnTexture * msgbox;
   Uint8 i, j;
   int tilenr;
-  FnGeometry * r = fn_geometry_new(0, 0, 0, 0);
+  FnRect r;
 
   fn_msgbox_get_text_information(
       text,
@@ -105,6 +106,7 @@ FnTexture * fn_msgbox(
       FN_FONT_HEIGHT * (rows + 2),
       graphic_options
       );
+  fn_texture_set_category(msgbox, FN_TEXTURE_CATEGORY_UI);
 
   for (i = 0; i <= rows; i++) {
     for (j = 0; j <= columns; j++) {
@@ -120,27 +122,25 @@ FnTexture * fn_msgbox(
       else if (i % 2 == 0  && j % 2 == 0)   tilenr = BORD_BLUE_MIDDLE;
       else continue;
 
-      fn_geometry_set_data(r,
-          j * pixelsize * FN_FONT_WIDTH,
-          i * pixelsize * FN_FONT_HEIGHT,
-          pixelsize * FN_FONT_WIDTH,
-          pixelsize * FN_FONT_HEIGHT);
-      fn_texture_clone_to_texture(
+      r.x = j * pixelsize * FN_FONT_WIDTH;
+      r.y = i * pixelsize * FN_FONT_HEIGHT;
+      r.width = pixelsize * FN_FONT_WIDTH;
+      r.height = pixelsize * FN_FONT_HEIGHT;
+      fn_texture_clone_rect(
           fn_environment_get_tile(env, tilenr),
           NULL,
           msgbox,
-          r);
+          &r);
     }
   }
 
-  fn_geometry_set_data(r,
-      pixelsize * FN_FONT_WIDTH,
-      pixelsize * FN_FONT_HEIGHT,
-      pixelsize * FN_FONT_WIDTH,
-      pixelsize * FN_FONT_HEIGHT);
+  r.x = pixelsize * FN_FONT_WIDTH;
+  r.y = pixelsize * FN_FONT_HEIGHT;
+  r.width = pixelsize * FN_FONT_WIDTH;
+  r.height = pixelsize * FN_FONT_HEIGHT;
 
-  fn_text_print(msgbox,
-      r,
+  fn_text_print_rect(msgbox,
+      &r,
       env,
       text);
   
@@ -148,3 +148,24 @@ FnTexture * fn_msgbox(
 }
 
 /* --------------------------------------------------------------- */
+
+FnTexture * fn_msgbox_cached(
+    fn_environment_t * env,
+    char * text)
+{
+  fn_textcache_t * tc = fn_environment_get_textcache(env);
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+
+  FnTexture * msgbox = fn_textcache_lookup(tc,
+      FN_TEXTCACHE_MSGBOX, text, pixelsize);
+  if (msgbox != NULL) {
+    g_object_ref(msgbox);
+    return msgbox;
+  }
+
+  msgbox = fn_msgbox(env, text);
+  fn_textcache_insert(tc, FN_TEXTCACHE_MSGBOX, text, pixelsize, msgbox);
+  return msgbox;
+}
+
+/* --------------------------------------------------------------- */
@@ -44,6 +44,22 @@ FnTexture * fn_msgbox(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Get a message box like fn_msgbox does, from the text cache of
+ * the environment if the same message was shown recently. The
+ * texture is shared with the cache, so it must not be drawn to.
+ *
+ * @param  env   The environment.
+ * @param  text  The message.
+ *
+ * @return A new reference to the message box.
+ */
+FnTexture * fn_msgbox_cached(
+    fn_environment_t * env,
+    char * text);
+
+/* --------------------------------------------------------------- */
+
 void fn_msgbox_get_text_information(
     char * text,
     Uint16 * columns,
@@ -27,6 +27,7 @@
  *******************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 /* --------------------------------------------------------------- */
@@ -36,12 +37,38 @@
 
 /* --------------------------------------------------------------- */
 
+/**
+ * The bits of a nibble spread over four bytes, the highest bit in
+ * the first byte, so that the planes of four pixels can be combined
+ * with one shift and one or each.
+ */
+static Uint32 fn_picture_spread[16];
+
+/* --------------------------------------------------------------- */
+
+static void fn_picture_init_spread(void)
+{
+  guint n = 0;
+  guint j = 0;
+
+  for (n = 0; n < 16; n++) {
+    guchar bytes[4];
+    for (j = 0; j < 4; j++) {
+      bytes[j] = (n >> (3 - j)) & 1;
+    }
+    /* copied, so the order in memory is that of the pixels */
+    memcpy(&(fn_picture_spread[n]), bytes, 4);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
 FnTexture * fn_picture_load(int fd, 
     fn_environment_t * env)
 {
     FnTexture * picture;
     guint i = 0;
-    guint j = 0;
+    guint k = 0;
 
     FnGraphicOptions * graphic_options =
       fn_environment_get_graphic_options(env);
@@ -51,73 +78,55 @@ FnTexture * fn_picture_load(int fd,
         FN_WINDOW_HEIGHT,
         graphic_options
         );
+    fn_texture_set_category(picture, FN_TEXTURE_CATEGORY_UI);
 
     guint num_loads = FN_PICTURE_WIDTH * FN_PICTURE_HEIGHT;
 
-    guchar * data = g_new0(guchar,
-        FN_PICTURE_WIDTH * FN_PICTURE_HEIGHT * 4 * 8);
-    guchar * data_pos = data;
-    guchar readbuf[num_loads];
-
-    /* read blue */
-    read(fd, readbuf, num_loads);
-    data_pos = data + 2;
-    for(i = 0; i < num_loads; i++) {
-      for (j = 0; j < 8; j++) {
-        guchar blue_pixel = ((readbuf[i] >> (7 -j)) & 1);
-        *data_pos += blue_pixel * 0x54 * 2;
-        data_pos += 4;
-      }
+    /* the planes are stored one after the other: blue, green, red
+     * and brighten */
+    guchar * planes = g_new0(guchar, num_loads * 4);
+    guchar * blue = planes;
+    guchar * green = planes + num_loads;
+    guchar * red = planes + 2 * num_loads;
+    guchar * bright = planes + 3 * num_loads;
+    guchar * indices = g_new(guchar, num_loads * 8);
+    Uint32 * iter = (Uint32 *)indices;
+    SDL_Color colors[16];
+
+    if (fn_picture_spread[1] == 0) {
+      fn_picture_init_spread();
     }
 
-    /* read green */
-    read(fd, readbuf, num_loads);
-    data_pos = data + 1;
-    for(i = 0; i < num_loads; i++) {
-      for (j = 0; j < 8; j++) {
-        guchar green_pixel = ((readbuf[i] >> (7 -j)) & 1);
-        *data_pos += green_pixel * 0x54 * 2;
-        data_pos += 4;
-      }
+    read(fd, planes, num_loads * 4);
+
+    /* the colour index of a pixel has the brighten bit on top,
+     * then red, green and blue */
+    for (i = 0; i < num_loads; i++) {
+      iter[0] =
+        fn_picture_spread[blue[i] >> 4] |
+        (fn_picture_spread[green[i] >> 4] << 1) |
+        (fn_picture_spread[red[i] >> 4] << 2) |
+        (fn_picture_spread[bright[i] >> 4] << 3);
+      iter[1] =
+        fn_picture_spread[blue[i] & 0x0F] |
+        (fn_picture_spread[green[i] & 0x0F] << 1) |
+        (fn_picture_spread[red[i] & 0x0F] << 2) |
+        (fn_picture_spread[bright[i] & 0x0F] << 3);
+      iter += 2;
     }
 
-    /* read red */
-    read(fd, readbuf, num_loads);
-    data_pos = data;
-    for(i = 0; i < num_loads; i++) {
-      for (j = 0; j < 8; j++) {
-        guchar red_pixel = ((readbuf[i] >> (7 -j)) & 1);
-        *data_pos += red_pixel * 0x54 * 2;
-        data_pos += 4;
-      }
+    for (k = 0; k < 16; k++) {
+      guchar brighten = (k & 8) ? 0x54 : 0;
+      colors[k].r = ((k & 4) ? 0xA8 : 0) + brighten;
+      colors[k].g = ((k & 2) ? 0xA8 : 0) + brighten;
+      colors[k].b = ((k & 1) ? 0xA8 : 0) + brighten;
+      colors[k].unused = 0;
     }
 
-    /* read brighten, and set pixels opaque */
-    read(fd, readbuf, num_loads);
-    data_pos = data;
-    for(i = 0; i < num_loads; i++) {
-      for (j = 0; j < 8; j++) {
-        guchar bright_pixel = ((readbuf[i] >> (7 -j)) & 1);
-
-        /* brighten red */
-        *data_pos += bright_pixel * 0x54;
-        data_pos++;
-
-        /* brighten blue */
-        *data_pos += bright_pixel * 0x54;
-        data_pos++;
-
-        /* brighten green */
-        *data_pos += bright_pixel * 0x54;
-        data_pos++;
-
-        /* set opaque */
-        *data_pos = 0xFF;
-        data_pos++;
-      }
-    }
+    fn_texture_set_indexed_data(picture, indices, colors, 16);
 
-    fn_texture_set_data(picture, data);
+    g_free(indices);
+    g_free(planes);
 
     return picture;
 }
@@ -71,21 +71,33 @@ int fn_picture_splash_show_with_message(
   int res;
   SDL_Event event;
   FnTexture * picture;
-
-  char * datapath = fn_environment_get_datapath(env);
-  path = malloc(strlen(datapath) + strlen(filename) + 1);
-  sprintf(path, "%s/%s", datapath, filename);
-  fd = open(path, O_RDONLY);
-
-  if (fd == -1) {
-    fn_error_printf(1024, "Could not open file %s for reading: %s",
-        path,strerror(errno));
+  fn_textcache_t * tc = fn_environment_get_textcache(env);
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+
+  /* the pictures are shown again after every game */
+  picture = fn_textcache_lookup(tc, FN_TEXTCACHE_PICTURE, filename,
+      pixelsize);
+  if (picture != NULL) {
+    g_object_ref(picture);
+  } else {
+    char * datapath = fn_environment_get_datapath(env);
+    path = malloc(strlen(datapath) + strlen(filename) + 2);
+    sprintf(path, "%s/%s", datapath, filename);
+    fd = open(path, O_RDONLY);
+
+    if (fd == -1) {
+      fn_error_printf(1024, "Could not open file %s for reading: %s",
+          path,strerror(errno));
+      free(path);
+      return 0;
+    }
     free(path);
-    return 0;
-  }
-  free(path);
 
-  picture = fn_picture_load(fd, env);
+    picture = fn_picture_load(fd, env);
+    close(fd);
+    fn_textcache_insert(tc, FN_TEXTCACHE_PICTURE, filename, pixelsize,
+        picture);
+  }
 
   SDL_Surface * screen = fn_environment_get_screen_sdl(env);
   fn_texture_blit_to_sdl_surface(picture, NULL, screen, NULL);
@@ -95,10 +107,9 @@ int fn_picture_splash_show_with_message(
     FnTexture * msgbox;
     SDL_Rect dstrect;
 
-    msgbox = fn_msgbox(env,
+    msgbox = fn_msgbox_cached(env,
         msg);
 
-    Uint8 pixelsize = fn_environment_get_pixelsize(env);
     dstrect.x = x * pixelsize;
     dstrect.y = y * pixelsize;
 
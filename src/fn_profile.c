@@ -0,0 +1,389 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Timing the phases of a frame
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_profile.h"
+#include "fn_text.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The maximum nesting depth of phases.
+ */
+#define FN_PROFILE_MAX_DEPTH 4
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_profile_enabled = 0;
+Uint8 fn_profile_actors_enabled = 0;
+
+/* --------------------------------------------------------------- */
+
+static char * fn_profile_names[FN_PROFILE_NUM_PHASES] = {
+  "events",
+  "hero",
+  "shots",
+  "actors",
+  "static_blit",
+  "actor_blit",
+  "hero_blit",
+  "raster",
+  "clone",
+  "present"
+};
+
+static char * fn_profile_labels[FN_PROFILE_NUM_PHASES] = {
+  "EVENTS",
+  "HERO",
+  "SHOTS",
+  "ACTORS",
+  "STATIC",
+  "ACT BLIT",
+  "HERO BLT",
+  "RASTER",
+  "CLONE",
+  "PRESENT"
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The ring of frame records. It is only written by the game
+ * thread; the write position is published after the record is
+ * complete, so a reader never sees a partially written frame.
+ */
+static fn_profile_frame_t fn_profile_frames[FN_PROFILE_FRAMES];
+
+/**
+ * The number of frames written so far.
+ */
+static volatile Uint32 fn_profile_head = 0;
+
+/**
+ * The frame currently being measured.
+ */
+static fn_profile_frame_t fn_profile_current;
+
+/**
+ * The phases currently being timed, innermost last.
+ */
+static fn_profile_phase_e fn_profile_stack[FN_PROFILE_MAX_DEPTH];
+static Uint64 fn_profile_start[FN_PROFILE_MAX_DEPTH];
+static Uint8 fn_profile_depth = 0;
+
+static Uint8 fn_profile_overlay = 0;
+static char * fn_profile_csvpath = NULL;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The costs of the functions of an actor type.
+ */
+typedef struct fn_profile_actor_costs_t {
+  Uint32 calls[FN_PROFILE_NUM_CALLBACKS];
+  Uint64 nsec[FN_PROFILE_NUM_CALLBACKS];
+  Uint64 total;
+} fn_profile_actor_costs_t;
+
+static fn_profile_actor_costs_t
+fn_profile_actor_costs[FN_LEVEL_ACTOR_NUM_TYPES];
+
+static char * fn_profile_callback_names[FN_PROFILE_NUM_CALLBACKS] = {
+  "create",
+  "act",
+  "blit",
+  "shot",
+  "touch"
+};
+
+/* --------------------------------------------------------------- */
+
+static Uint64 fn_profile_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (Uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_profile_exit(void)
+{
+  if (fn_profile_csvpath != NULL &&
+      !fn_profile_dump_csv(fn_profile_csvpath))
+  {
+    fprintf(stderr, "Could not write the profile to %s\n",
+        fn_profile_csvpath);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_init(void)
+{
+  fn_profile_csvpath = getenv("FREENUKUM_PROFILE_CSV");
+  if (fn_profile_csvpath != NULL) {
+    fn_profile_enabled = 1;
+    atexit(fn_profile_exit);
+  }
+  fn_profile_actors_enabled =
+    (getenv("FREENUKUM_PROFILE_ACTORS") != NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_begin(fn_profile_phase_e phase)
+{
+  if (fn_profile_depth == FN_PROFILE_MAX_DEPTH) {
+    return;
+  }
+  fn_profile_stack[fn_profile_depth] = phase;
+  fn_profile_start[fn_profile_depth] = fn_profile_usec();
+  fn_profile_depth++;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_end(fn_profile_phase_e phase)
+{
+  if (fn_profile_depth == 0 ||
+      fn_profile_stack[fn_profile_depth - 1] != phase)
+  {
+    /* timing was enabled in the middle of the phase */
+    return;
+  }
+  fn_profile_depth--;
+  Uint32 elapsed = fn_profile_usec() - fn_profile_start[fn_profile_depth];
+  fn_profile_current.usec[phase] += elapsed;
+  if (fn_profile_depth > 0) {
+    /* the outer phase only gets its own time; this wraps around
+     * until the outer phase ends and adds its whole duration */
+    fn_profile_current.usec[fn_profile_stack[fn_profile_depth - 1]] -=
+      elapsed;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_frame_done(void)
+{
+  fn_profile_frames[fn_profile_head % FN_PROFILE_FRAMES] =
+    fn_profile_current;
+  __sync_synchronize();
+  fn_profile_head++;
+  memset(&fn_profile_current, 0, sizeof(fn_profile_frame_t));
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_toggle_overlay(void)
+{
+  fn_profile_overlay = !fn_profile_overlay;
+  fn_profile_enabled = (fn_profile_overlay || fn_profile_csvpath != NULL);
+  if (!fn_profile_enabled) {
+    fn_profile_depth = 0;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_profile_overlay_shown(void)
+{
+  return fn_profile_overlay;
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_profile_compare(const void * a, const void * b)
+{
+  Uint32 x = *(const Uint32 *)a;
+  Uint32 y = *(const Uint32 *)b;
+  return (x > y) - (x < y);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_draw_overlay(FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env)
+{
+  Uint32 values[FN_PROFILE_OVERLAY_FRAMES];
+  char text[FN_PROFILE_NUM_PHASES * 32 + 32];
+  size_t len = 0;
+  Uint32 head = fn_profile_head;
+  Uint32 count = head;
+  Uint32 i = 0;
+  Uint32 phase = 0;
+
+  if (count > FN_PROFILE_OVERLAY_FRAMES) {
+    count = FN_PROFILE_OVERLAY_FRAMES;
+  }
+
+  len = snprintf(text, sizeof(text), "PHASE      AVG   P99\n");
+  for (phase = 0; phase < FN_PROFILE_NUM_PHASES; phase++) {
+    Uint64 sum = 0;
+    Uint32 avg = 0;
+    Uint32 p99 = 0;
+    for (i = 0; i < count; i++) {
+      values[i] = fn_profile_frames[
+        (head - count + i) % FN_PROFILE_FRAMES].usec[phase];
+      sum += values[i];
+    }
+    if (count > 0) {
+      qsort(values, count, sizeof(Uint32), fn_profile_compare);
+      avg = sum / count;
+      p99 = values[(99 * count + 99) / 100 - 1];
+    }
+    len += snprintf(text + len, sizeof(text) - len,
+        "%-8s %5u %5u\n", fn_profile_labels[phase], avg, p99);
+  }
+
+  fn_text_print_rect(target, r, env, text);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_profile_dump_csv(char * path)
+{
+  Uint32 head = fn_profile_head;
+  Uint32 first = 0;
+  Uint32 i = 0;
+  Uint32 phase = 0;
+
+  FILE * f = fopen(path, "w");
+  if (f == NULL) {
+    return 0;
+  }
+
+  if (head > FN_PROFILE_FRAMES) {
+    first = head - FN_PROFILE_FRAMES;
+  }
+
+  fprintf(f, "frame");
+  for (phase = 0; phase < FN_PROFILE_NUM_PHASES; phase++) {
+    fprintf(f, ",%s", fn_profile_names[phase]);
+  }
+  fprintf(f, "\n");
+
+  for (i = first; i < head; i++) {
+    fn_profile_frame_t * frame = &(fn_profile_frames[i % FN_PROFILE_FRAMES]);
+    fprintf(f, "%u", i);
+    for (phase = 0; phase < FN_PROFILE_NUM_PHASES; phase++) {
+      fprintf(f, ",%u", frame->usec[phase]);
+    }
+    fprintf(f, "\n");
+  }
+
+  return (fclose(f) == 0);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint64 fn_profile_nsec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (Uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_actor_add(fn_level_actor_type_e type,
+    fn_profile_callback_e callback,
+    Uint64 nsec)
+{
+  fn_profile_actor_costs_t * costs = &(fn_profile_actor_costs[type]);
+  costs->calls[callback]++;
+  costs->nsec[callback] += nsec;
+  costs->total += nsec;
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_profile_actor_compare(const void * a, const void * b)
+{
+  Uint64 x = fn_profile_actor_costs[*(const Uint16 *)a].total;
+  Uint64 y = fn_profile_actor_costs[*(const Uint16 *)b].total;
+  /* the most expensive first */
+  return (x < y) - (x > y);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_profile_actor_report(FILE * f, Uint8 levelnumber)
+{
+  Uint16 ranking[FN_LEVEL_ACTOR_NUM_TYPES];
+  Uint16 count = 0;
+  Uint16 type = 0;
+  Uint64 total = 0;
+  Uint16 i = 0;
+  Uint8 callback = 0;
+
+  for (type = 0; type < FN_LEVEL_ACTOR_NUM_TYPES; type++) {
+    if (fn_profile_actor_costs[type].total > 0) {
+      ranking[count] = type;
+      count++;
+      total += fn_profile_actor_costs[type].total;
+    }
+  }
+  qsort(ranking, count, sizeof(Uint16), fn_profile_actor_compare);
+
+  fprintf(f, "Actor costs in level %d, %.3f ms in total "
+      "(calls/microseconds):\n", levelnumber, total / 1000000.0);
+  fprintf(f, "%4s %-28s %10s %6s", "rank", "type", "total us", "share");
+  for (callback = 0; callback < FN_PROFILE_NUM_CALLBACKS; callback++) {
+    fprintf(f, " %16s", fn_profile_callback_names[callback]);
+  }
+  fprintf(f, "\n");
+
+  for (i = 0; i < count; i++) {
+    fn_profile_actor_costs_t * costs =
+      &(fn_profile_actor_costs[ranking[i]]);
+    fprintf(f, "%4u %-28s %10.1f %5.1f%%",
+        i + 1,
+        fn_level_actor_type_name(ranking[i]),
+        costs->total / 1000.0,
+        100.0 * costs->total / total);
+    for (callback = 0; callback < FN_PROFILE_NUM_CALLBACKS; callback++) {
+      fprintf(f, " %7u/%8.1f",
+          costs->calls[callback], costs->nsec[callback] / 1000.0);
+    }
+    fprintf(f, "\n");
+  }
+
+  memset(fn_profile_actor_costs, 0, sizeof(fn_profile_actor_costs));
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,245 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Timing the phases of a frame
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_PROFILE_H
+#define FN_PROFILE_H
+
+/* --------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_environment.h"
+#include "fntexture.h"
+#include "fngeometry.h"
+#include "fn_level_actor.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The number of frames kept in the ring of frame records.
+ */
+#define FN_PROFILE_FRAMES 4096
+
+/**
+ * The number of most recent frames summarized by the overlay.
+ */
+#define FN_PROFILE_OVERLAY_FRAMES 128
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The measured phases of a frame. Phases may be nested, the time
+ * of an inner phase is not counted for the outer one.
+ */
+typedef enum fn_profile_phase_e {
+  FN_PROFILE_EVENTS,
+  FN_PROFILE_HERO,
+  FN_PROFILE_SHOTS,
+  FN_PROFILE_ACTORS,
+  FN_PROFILE_STATIC_BLIT,
+  FN_PROFILE_ACTOR_BLIT,
+  FN_PROFILE_HERO_BLIT,
+  FN_PROFILE_RASTER,
+  FN_PROFILE_CLONE,
+  FN_PROFILE_PRESENT,
+  FN_PROFILE_NUM_PHASES
+} fn_profile_phase_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The actor functions whose costs are counted per actor type.
+ */
+typedef enum fn_profile_callback_e {
+  FN_PROFILE_CALLBACK_CREATE,
+  FN_PROFILE_CALLBACK_ACT,
+  FN_PROFILE_CALLBACK_BLIT,
+  FN_PROFILE_CALLBACK_SHOT,
+  FN_PROFILE_CALLBACK_TOUCH,
+  FN_PROFILE_NUM_CALLBACKS
+} fn_profile_callback_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The time spent in each phase during one frame.
+ */
+typedef struct fn_profile_frame_t {
+  /**
+   * The time in microseconds, indexed by fn_profile_phase_e.
+   */
+  Uint32 usec[FN_PROFILE_NUM_PHASES];
+} fn_profile_frame_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Set while the phases are timed. Use the macros below instead
+ * of reading it, so that disabled timers only cost a test.
+ */
+extern Uint8 fn_profile_enabled;
+
+/**
+ * Set while the costs of the actor functions are counted.
+ */
+extern Uint8 fn_profile_actors_enabled;
+
+/* --------------------------------------------------------------- */
+
+#define FN_PROFILE_BEGIN(phase) \
+  do { if (fn_profile_enabled) { fn_profile_begin(phase); } } while (0)
+
+#define FN_PROFILE_END(phase) \
+  do { if (fn_profile_enabled) { fn_profile_end(phase); } } while (0)
+
+#define FN_PROFILE_FRAME_DONE() \
+  do { if (fn_profile_enabled) { fn_profile_frame_done(); } } while (0)
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Initialize the profiler. If the environment variable
+ * FREENUKUM_PROFILE_CSV is set, timing is enabled from the start
+ * and the frame records are written to the file it names when
+ * the program exits.
+ *
+ * If FREENUKUM_PROFILE_ACTORS is set, the costs of the actor
+ * functions are counted per actor type.
+ *
+ * The profiler only measures the thread running the game.
+ */
+void fn_profile_init(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Start timing a phase.
+ *
+ * @param  phase  The phase.
+ */
+void fn_profile_begin(fn_profile_phase_e phase);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Stop timing a phase and add the time to the current frame.
+ *
+ * @param  phase  The phase, must be the most recently begun one.
+ */
+void fn_profile_end(fn_profile_phase_e phase);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Store the current frame in the ring of frame records and start
+ * a new one.
+ */
+void fn_profile_frame_done(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Show or hide the overlay. Timing is enabled while the overlay
+ * is shown.
+ */
+void fn_profile_toggle_overlay(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if the overlay is shown.
+ *
+ * @return 1 if the overlay is shown, otherwise 0.
+ */
+Uint8 fn_profile_overlay_shown(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Print the average and the 99th percentile of each phase over
+ * the last FN_PROFILE_OVERLAY_FRAMES frames.
+ *
+ * @param  target  The texture to print to.
+ * @param  r       The position of the text.
+ * @param  env     The environment holding the font.
+ */
+void fn_profile_draw_overlay(FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Write the frame records to a CSV file.
+ *
+ * @param  path  The file name.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+Uint8 fn_profile_dump_csv(char * path);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get a monotonic time for measuring short durations.
+ *
+ * @return The time in nanoseconds.
+ */
+Uint64 fn_profile_nsec(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Count a call of an actor function.
+ *
+ * @param  type      The actor type.
+ * @param  callback  The called function.
+ * @param  nsec      The time the call took in nanoseconds.
+ */
+void fn_profile_actor_add(fn_level_actor_type_e type,
+    fn_profile_callback_e callback,
+    Uint64 nsec);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Print the actor types ranked by the total time spent in their
+ * functions, together with the calls and the time per function,
+ * and start counting anew.
+ *
+ * @param  f            The file to print to.
+ * @param  levelnumber  The level the costs were counted in.
+ */
+void fn_profile_actor_report(FILE * f, Uint8 levelnumber);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_PROFILE_H */
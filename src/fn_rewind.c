@@ -0,0 +1,454 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Rewinding the game state
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_rewind.h"
+#include "fn_snapshot.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Unchanged bytes between two changed ranges which are shorter
+ * than this are stored with the changes, so that a run header
+ * is saved.
+ */
+#define FN_REWIND_MAX_GAP 8
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A tick stored inside the rewind buffer.
+ */
+typedef struct fn_rewind_entry_t {
+  /**
+   * The offset of the data inside the buffer.
+   */
+  size_t offset;
+
+  /**
+   * The number of bytes of the data.
+   */
+  size_t size;
+
+  /**
+   * 1 if the data is a full snapshot, 0 if it only contains
+   * the changes since the previous entry.
+   */
+  Uint8 keyframe;
+} fn_rewind_entry_t;
+
+/* --------------------------------------------------------------- */
+
+struct fn_rewind_t {
+  /**
+   * The memory for the stored states.
+   */
+  Uint8 * buffer;
+
+  /**
+   * The number of bytes inside buffer.
+   */
+  size_t capacity;
+
+  /**
+   * The position where the next entry is written.
+   */
+  size_t head;
+
+  /**
+   * The stored ticks, used as a ring.
+   */
+  fn_rewind_entry_t * entries;
+
+  /**
+   * The number of elements inside entries.
+   */
+  Uint16 num_entries;
+
+  /**
+   * The index of the oldest stored tick.
+   */
+  Uint16 first;
+
+  /**
+   * The number of stored ticks.
+   */
+  Uint16 count;
+
+  /**
+   * The number of ticks since the last keyframe.
+   */
+  Uint16 since_keyframe;
+
+  /**
+   * The snapshot of the most recently stored tick.
+   */
+  fn_snapshot_t * previous;
+
+  /**
+   * The snapshot of the current tick.
+   */
+  fn_snapshot_t * current;
+
+  /**
+   * The encoded changes of the current tick.
+   */
+  fn_snapshot_t * delta;
+
+  /**
+   * The number of recorded ticks.
+   */
+  Uint32 recorded;
+
+  /**
+   * The time spent recording in microseconds.
+   */
+  Uint64 total_usec;
+
+  /**
+   * The longest time spent recording a single tick.
+   */
+  Uint32 max_usec;
+};
+
+/* --------------------------------------------------------------- */
+
+static Uint64 fn_rewind_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (Uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/* --------------------------------------------------------------- */
+
+fn_rewind_t * fn_rewind_create(size_t capacity, Uint16 num_entries)
+{
+  fn_rewind_t * rewind = malloc(sizeof(fn_rewind_t));
+  memset(rewind, 0, sizeof(fn_rewind_t));
+  rewind->buffer = malloc(capacity);
+  rewind->capacity = capacity;
+  rewind->entries = malloc(sizeof(fn_rewind_entry_t) * num_entries);
+  rewind->num_entries = num_entries;
+  rewind->previous = fn_snapshot_create();
+  rewind->current = fn_snapshot_create();
+  rewind->delta = fn_snapshot_create();
+  return rewind;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_rewind_free(fn_rewind_t * rewind)
+{
+  fn_snapshot_free(rewind->previous);
+  fn_snapshot_free(rewind->current);
+  fn_snapshot_free(rewind->delta);
+  free(rewind->entries);
+  free(rewind->buffer);
+  free(rewind);
+}
+
+/* --------------------------------------------------------------- */
+
+static fn_rewind_entry_t * fn_rewind_entry(fn_rewind_t * rewind,
+    Uint16 i)
+{
+  return &(rewind->entries[(rewind->first + i) % rewind->num_entries]);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Drop the oldest stored tick, together with all following ticks
+ * that can not be restored without it.
+ */
+static void fn_rewind_drop_oldest(fn_rewind_t * rewind)
+{
+  do {
+    rewind->first = (rewind->first + 1) % rewind->num_entries;
+    rewind->count--;
+  } while (rewind->count > 0 && !fn_rewind_entry(rewind, 0)->keyframe);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Encode the changes between the previous and the current
+ * snapshot into the delta snapshot.
+ */
+static void fn_rewind_encode_delta(fn_rewind_t * rewind)
+{
+  Uint8 * old = rewind->previous->data;
+  Uint8 * new = rewind->current->data;
+  Uint32 newsize = rewind->current->size;
+  size_t common = rewind->previous->size;
+  size_t i = 0;
+  Uint32 offset = 0;
+  Uint16 len = 0;
+
+  if (newsize < common) {
+    common = newsize;
+  }
+
+  fn_snapshot_clear(rewind->delta);
+  fn_snapshot_write_value(rewind->delta, newsize);
+
+  while (i < common) {
+    if (old[i] == new[i]) {
+      i++;
+      continue;
+    }
+    size_t start = i;
+    size_t last = i;
+    while (i < common &&
+        i - last <= FN_REWIND_MAX_GAP &&
+        i - start < 0xFFFF)
+    {
+      if (old[i] != new[i]) {
+        last = i;
+      }
+      i++;
+    }
+    offset = start;
+    len = last - start + 1;
+    fn_snapshot_write_value(rewind->delta, offset);
+    fn_snapshot_write_value(rewind->delta, len);
+    fn_snapshot_write(rewind->delta, new + start, len);
+    i = last + 1;
+  }
+
+  while (i < newsize) {
+    offset = i;
+    len = (newsize - i > 0xFFFF) ? 0xFFFF : newsize - i;
+    fn_snapshot_write_value(rewind->delta, offset);
+    fn_snapshot_write_value(rewind->delta, len);
+    fn_snapshot_write(rewind->delta, new + i, len);
+    i += len;
+  }
+
+  offset = 0;
+  len = 0;
+  fn_snapshot_write_value(rewind->delta, offset);
+  fn_snapshot_write_value(rewind->delta, len);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Apply the changes stored in an entry to a snapshot.
+ */
+static void fn_rewind_apply_delta(fn_rewind_t * rewind,
+    fn_rewind_entry_t * entry,
+    fn_snapshot_t * snapshot)
+{
+  Uint8 * data = rewind->buffer + entry->offset;
+  Uint32 newsize = 0;
+  Uint32 offset = 0;
+  Uint16 len = 0;
+
+  memcpy(&newsize, data, sizeof(newsize));
+  data += sizeof(newsize);
+  fn_snapshot_resize(snapshot, newsize);
+
+  while (1) {
+    memcpy(&offset, data, sizeof(offset));
+    data += sizeof(offset);
+    memcpy(&len, data, sizeof(len));
+    data += sizeof(len);
+    if (len == 0) {
+      break;
+    }
+    memcpy(snapshot->data + offset, data, len);
+    data += len;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Store data as the newest entry.
+ *
+ * @return 1 if the data was stored, 0 if it is too big.
+ */
+static Uint8 fn_rewind_push(fn_rewind_t * rewind,
+    fn_snapshot_t * data,
+    Uint8 keyframe)
+{
+  fn_rewind_entry_t * entry = NULL;
+
+  if (data->size > rewind->capacity) {
+    return 0;
+  }
+
+  if (rewind->count == rewind->num_entries) {
+    fn_rewind_drop_oldest(rewind);
+  }
+
+  if (rewind->head + data->size > rewind->capacity) {
+    /* the entries behind the write position are the oldest ones */
+    while (rewind->count > 0 &&
+        fn_rewind_entry(rewind, 0)->offset >= rewind->head)
+    {
+      fn_rewind_drop_oldest(rewind);
+    }
+    rewind->head = 0;
+  }
+  while (rewind->count > 0) {
+    entry = fn_rewind_entry(rewind, 0);
+    if (entry->offset >= rewind->head + data->size ||
+        entry->offset + entry->size <= rewind->head)
+    {
+      break;
+    }
+    fn_rewind_drop_oldest(rewind);
+  }
+
+  if (rewind->count == 0 && !keyframe) {
+    /* a delta without its keyframe is useless */
+    return 0;
+  }
+
+  entry = fn_rewind_entry(rewind, rewind->count);
+  entry->offset = rewind->head;
+  entry->size = data->size;
+  entry->keyframe = keyframe;
+  memcpy(rewind->buffer + entry->offset, data->data, data->size);
+  rewind->head += data->size;
+  rewind->count++;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_rewind_record(fn_rewind_t * rewind,
+    fn_level_t * lv,
+    Uint8 levelnumber,
+    Uint8 sequence)
+{
+  Uint64 start = fn_rewind_usec();
+  Uint8 stored = 0;
+
+  fn_snapshot_save_level(rewind->current, lv, levelnumber, sequence);
+
+  if (rewind->count > 0 &&
+      rewind->since_keyframe + 1 < FN_REWIND_KEYFRAME_INTERVAL)
+  {
+    fn_rewind_encode_delta(rewind);
+    if (rewind->delta->size < rewind->current->size) {
+      stored = fn_rewind_push(rewind, rewind->delta, 0);
+      if (stored) {
+        rewind->since_keyframe++;
+      }
+    }
+  }
+  if (!stored) {
+    if (fn_rewind_push(rewind, rewind->current, 1)) {
+      rewind->since_keyframe = 0;
+    }
+  }
+
+  /* the current state is the base for the next tick */
+  fn_snapshot_t * swap = rewind->previous;
+  rewind->previous = rewind->current;
+  rewind->current = swap;
+
+  Uint32 usec = fn_rewind_usec() - start;
+  rewind->total_usec += usec;
+  rewind->recorded++;
+  if (usec > rewind->max_usec) {
+    rewind->max_usec = usec;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_rewind_step_back(fn_rewind_t * rewind, fn_level_t * lv)
+{
+  fn_rewind_entry_t * entry = NULL;
+  Uint16 keyframe = 0;
+  Uint16 i = 0;
+
+  if (rewind->count < 2) {
+    return 0;
+  }
+
+  /* forget the newest tick */
+  rewind->count--;
+  rewind->head = fn_rewind_entry(rewind, rewind->count)->offset;
+
+  /* rebuild the state of the tick before it */
+  keyframe = rewind->count - 1;
+  while (!fn_rewind_entry(rewind, keyframe)->keyframe) {
+    keyframe--;
+  }
+  entry = fn_rewind_entry(rewind, keyframe);
+  fn_snapshot_clear(rewind->previous);
+  fn_snapshot_write(rewind->previous,
+      rewind->buffer + entry->offset, entry->size);
+  for (i = keyframe + 1; i < rewind->count; i++) {
+    fn_rewind_apply_delta(rewind, fn_rewind_entry(rewind, i),
+        rewind->previous);
+  }
+  rewind->since_keyframe = rewind->count - 1 - keyframe;
+
+  return fn_snapshot_restore_level(rewind->previous, lv);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_rewind_print_stats(fn_rewind_t * rewind)
+{
+  size_t used = 0;
+  Uint16 i = 0;
+  Uint32 average = 0;
+
+  for (i = 0; i < rewind->count; i++) {
+    used += fn_rewind_entry(rewind, i)->size;
+  }
+  if (rewind->recorded > 0) {
+    average = rewind->total_usec / rewind->recorded;
+  }
+
+  printf("Rewind: %u ticks recorded, %u us average (%.2f%% of a tick), "
+      "%u us max, %u ticks in %lu of %lu bytes.\n",
+      rewind->recorded,
+      average,
+      average / (FN_REWIND_TICK_DURATION * 10.0),
+      rewind->max_usec,
+      rewind->count,
+      (unsigned long)used,
+      (unsigned long)rewind->capacity);
+}
+
+/* --------------------------------------------------------------- */
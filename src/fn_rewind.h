@@ -0,0 +1,140 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Rewinding the game state
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_REWIND_H
+#define FN_REWIND_H
+
+/* --------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+typedef struct fn_rewind_t fn_rewind_t;
+
+/* --------------------------------------------------------------- */
+
+#include "fn_level.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The duration of a game tick in milliseconds.
+ */
+#define FN_REWIND_TICK_DURATION 80
+
+/**
+ * The number of seconds that can be rewound.
+ */
+#define FN_REWIND_SECONDS 30
+
+/**
+ * The number of ticks stored in the rewind buffer.
+ */
+#define FN_REWIND_ENTRIES \
+  (FN_REWIND_SECONDS * 1000 / FN_REWIND_TICK_DURATION)
+
+/**
+ * Every this many ticks, the full state is stored instead of
+ * the changes since the previous tick.
+ */
+#define FN_REWIND_KEYFRAME_INTERVAL 25
+
+/**
+ * The number of bytes reserved for the stored states.
+ */
+#define FN_REWIND_CAPACITY (8 * 1024 * 1024)
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create a rewind buffer.
+ *
+ * The buffer keeps the state of the last ticks in a fixed amount
+ * of memory. Each tick stores only the bytes of the level snapshot
+ * that changed since the previous tick, a full snapshot (keyframe)
+ * is stored every FN_REWIND_KEYFRAME_INTERVAL ticks. When the
+ * buffer is full, the oldest ticks are dropped.
+ *
+ * @param  capacity     The number of bytes for the stored states.
+ * @param  num_entries  The maximum number of stored ticks.
+ *
+ * @return The newly created rewind buffer.
+ */
+fn_rewind_t * fn_rewind_create(size_t capacity, Uint16 num_entries);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a rewind buffer.
+ *
+ * @param  rewind  The rewind buffer.
+ */
+void fn_rewind_free(fn_rewind_t * rewind);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Store the state of a level after a game tick.
+ *
+ * @param  rewind       The rewind buffer.
+ * @param  lv           The level.
+ * @param  levelnumber  The number of the level.
+ * @param  sequence     The sequence number of the level.
+ */
+void fn_rewind_record(fn_rewind_t * rewind,
+    fn_level_t * lv,
+    Uint8 levelnumber,
+    Uint8 sequence);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Set a level back to the state it had one tick earlier.
+ *
+ * @param  rewind  The rewind buffer.
+ * @param  lv      The level.
+ *
+ * @return 1 if the level was set back, 0 if no earlier state
+ *         is stored.
+ */
+Uint8 fn_rewind_step_back(fn_rewind_t * rewind, fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Print the time spent recording and the memory in use.
+ *
+ * @param  rewind  The rewind buffer.
+ */
+void fn_rewind_print_stats(fn_rewind_t * rewind);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_REWIND_H */
@@ -0,0 +1,332 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Integer upscaling of the composed frame
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* --------------------------------------------------------------- */
+
+#include "fn_scale.h"
+
+/* --------------------------------------------------------------- */
+
+static char * fn_scale_filter_names[FN_SCALE_NUM_FILTERS] = {
+  "nearest",
+  "scale2x"
+};
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_scale_get(const Uint8 * p, Uint8 bpp)
+{
+  Uint32 v = 0;
+  switch (bpp) {
+    case 1:
+      v = *p;
+      break;
+    case 2:
+      v = *(const Uint16 *)p;
+      break;
+    case 3:
+      memcpy(&v, p, 3);
+      break;
+    default:
+      v = *(const Uint32 *)p;
+      break;
+  }
+  return v;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_scale_fill(Uint8 * p, Uint32 v, Uint8 bpp, Uint16 count)
+{
+  Uint16 i = 0;
+  switch (bpp) {
+    case 1:
+      memset(p, v, count);
+      break;
+    case 2:
+      for (i = 0; i < count; i++) {
+        ((Uint16 *)p)[i] = v;
+      }
+      break;
+    case 3:
+      for (i = 0; i < count; i++) {
+        memcpy(p + 3 * i, &v, 3);
+      }
+      break;
+    default:
+      for (i = 0; i < count; i++) {
+        ((Uint32 *)p)[i] = v;
+      }
+      break;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The pixel formats of a scaling. If the source is indexed and the
+ * target is not, lut holds the target pixel of every index,
+ * otherwise it is NULL and the pixels are copied.
+ */
+typedef struct fn_scale_format_t {
+  Uint8 sbpp;
+  Uint8 dbpp;
+  Uint32 * lut;
+} fn_scale_format_t;
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_scale_map(const fn_scale_format_t * fmt, Uint32 v)
+{
+  return (fmt->lut != NULL) ? fmt->lut[v] : v;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Widen a row of pixels by the scale factor.
+ */
+static void fn_scale_row_nearest(const Uint8 * src,
+    Uint8 * dst,
+    Uint16 width,
+    const fn_scale_format_t * fmt,
+    Uint8 factor)
+{
+  Uint16 x = 0;
+  Uint8 bpp = fmt->sbpp;
+
+#ifdef __SSE2__
+  /* the common case of doubling a 16 or 32 bit row */
+  if (fmt->lut != NULL) {
+    /* the palette is expanded below */
+  } else if (factor == 2 && bpp == 4) {
+    for (; x + 4 <= width; x += 4) {
+      __m128i p = _mm_loadu_si128((const __m128i *)(src + 4 * x));
+      _mm_storeu_si128((__m128i *)(dst + 8 * x),
+          _mm_unpacklo_epi32(p, p));
+      _mm_storeu_si128((__m128i *)(dst + 8 * x + 16),
+          _mm_unpackhi_epi32(p, p));
+    }
+  } else if (factor == 2 && bpp == 2) {
+    for (; x + 8 <= width; x += 8) {
+      __m128i p = _mm_loadu_si128((const __m128i *)(src + 2 * x));
+      _mm_storeu_si128((__m128i *)(dst + 4 * x),
+          _mm_unpacklo_epi16(p, p));
+      _mm_storeu_si128((__m128i *)(dst + 4 * x + 16),
+          _mm_unpackhi_epi16(p, p));
+    }
+  }
+#endif
+
+  for (; x < width; x++) {
+    fn_scale_fill(dst + x * fmt->dbpp * factor,
+        fn_scale_map(fmt, fn_scale_get(src + x * bpp, bpp)),
+        fmt->dbpp, factor);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_scale_nearest(SDL_Surface * src,
+    SDL_Surface * dst,
+    const fn_scale_format_t * fmt,
+    Uint8 factor)
+{
+  size_t rowbytes = (size_t)src->w * fmt->dbpp * factor;
+  Uint16 y = 0;
+  Uint8 i = 0;
+
+  for (y = 0; y < src->h; y++) {
+    Uint8 * row = (Uint8 *)dst->pixels + (size_t)y * factor * dst->pitch;
+    fn_scale_row_nearest(
+        (Uint8 *)src->pixels + (size_t)y * src->pitch,
+        row, src->w, fmt, factor);
+    /* the other rows of the block are copies of the first one */
+    for (i = 1; i < factor; i++) {
+      memcpy(row + (size_t)i * dst->pitch, row, rowbytes);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_scale_scale2x(SDL_Surface * src,
+    SDL_Surface * dst,
+    const fn_scale_format_t * fmt,
+    Uint8 factor)
+{
+  Uint8 bpp = fmt->sbpp;
+  Uint8 dbpp = fmt->dbpp;
+  Uint8 half = factor / 2;
+  Uint16 x = 0;
+  Uint16 y = 0;
+  Uint8 i = 0;
+
+  for (y = 0; y < src->h; y++) {
+    const Uint8 * row = (Uint8 *)src->pixels + (size_t)y * src->pitch;
+    const Uint8 * above = (y > 0) ? row - src->pitch : row;
+    const Uint8 * below = (y + 1 < src->h) ? row + src->pitch : row;
+    Uint8 * top = (Uint8 *)dst->pixels + (size_t)y * factor * dst->pitch;
+    Uint8 * bottom = top + (size_t)half * dst->pitch;
+
+    for (x = 0; x < src->w; x++) {
+      Uint16 left = (x > 0) ? x - 1 : x;
+      Uint16 right = (x + 1 < src->w) ? x + 1 : x;
+      Uint32 b = fn_scale_get(above + x * bpp, bpp);
+      Uint32 d = fn_scale_get(row + left * bpp, bpp);
+      Uint32 e = fn_scale_get(row + x * bpp, bpp);
+      Uint32 f = fn_scale_get(row + right * bpp, bpp);
+      Uint32 h = fn_scale_get(below + x * bpp, bpp);
+      Uint32 e0 = e, e1 = e, e2 = e, e3 = e;
+
+      if (b != h && d != f) {
+        e0 = (d == b) ? d : e;
+        e1 = (b == f) ? f : e;
+        e2 = (d == h) ? d : e;
+        e3 = (h == f) ? f : e;
+      }
+
+      /* the neighbours are compared before the palette is
+       * expanded, which is cheaper and just as exact */
+      size_t offset = (size_t)x * factor * dbpp;
+      fn_scale_fill(top + offset,
+          fn_scale_map(fmt, e0), dbpp, half);
+      fn_scale_fill(top + offset + half * dbpp,
+          fn_scale_map(fmt, e1), dbpp, half);
+      fn_scale_fill(bottom + offset,
+          fn_scale_map(fmt, e2), dbpp, half);
+      fn_scale_fill(bottom + offset + half * dbpp,
+          fn_scale_map(fmt, e3), dbpp, half);
+    }
+
+    /* widen the quadrants to blocks of half x half pixels */
+    for (i = 1; i < half; i++) {
+      memcpy(top + (size_t)i * dst->pitch, top,
+          (size_t)src->w * factor * dbpp);
+      memcpy(bottom + (size_t)i * dst->pitch, bottom,
+          (size_t)src->w * factor * dbpp);
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_scale_blit(SDL_Surface * src,
+    SDL_Surface * dst,
+    Uint8 factor,
+    fn_scale_filter_e filter)
+{
+  fn_scale_format_t fmt;
+  Uint32 lut[256];
+
+  if (factor <= 1) {
+    SDL_BlitSurface(src, NULL, dst, NULL);
+    return;
+  }
+
+  fmt.sbpp = src->format->BytesPerPixel;
+  fmt.dbpp = dst->format->BytesPerPixel;
+  fmt.lut = NULL;
+  if (fmt.sbpp == 1 && fmt.dbpp != 1 && src->format->palette != NULL) {
+    SDL_Palette * palette = src->format->palette;
+    int i = 0;
+    memset(lut, 0, sizeof(lut));
+    for (i = 0; i < palette->ncolors && i < 256; i++) {
+      lut[i] = SDL_MapRGB(dst->format,
+          palette->colors[i].r,
+          palette->colors[i].g,
+          palette->colors[i].b);
+    }
+    fmt.lut = lut;
+  }
+
+  if ((fmt.sbpp != fmt.dbpp && fmt.lut == NULL) ||
+      dst->w < src->w * factor || dst->h < src->h * factor)
+  {
+    fprintf(stderr, "Can not scale a %dx%d surface into %dx%d.\n",
+        src->w, src->h, dst->w, dst->h);
+    return;
+  }
+
+  if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) != 0) {
+    return;
+  }
+  if (SDL_MUSTLOCK(src) && SDL_LockSurface(src) != 0) {
+    if (SDL_MUSTLOCK(dst)) {
+      SDL_UnlockSurface(dst);
+    }
+    return;
+  }
+
+  if (filter == FN_SCALE_FILTER_SCALE2X && factor % 2 == 0) {
+    fn_scale_scale2x(src, dst, &fmt, factor);
+  } else {
+    fn_scale_nearest(src, dst, &fmt, factor);
+  }
+
+  if (SDL_MUSTLOCK(src)) {
+    SDL_UnlockSurface(src);
+  }
+  if (SDL_MUSTLOCK(dst)) {
+    SDL_UnlockSurface(dst);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+char * fn_scale_filter_name(fn_scale_filter_e filter)
+{
+  if (filter >= FN_SCALE_NUM_FILTERS) {
+    return "unknown";
+  }
+  return fn_scale_filter_names[filter];
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_scale_filter_from_name(const char * name,
+    fn_scale_filter_e * filter)
+{
+  Uint8 i = 0;
+  for (i = 0; i < FN_SCALE_NUM_FILTERS; i++) {
+    if (strcmp(name, fn_scale_filter_names[i]) == 0) {
+      *filter = i;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,102 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Integer upscaling of the composed frame
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_SCALE_H
+#define FN_SCALE_H
+
+/* --------------------------------------------------------------- */
+
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The filters for upscaling a frame.
+ */
+typedef enum fn_scale_filter_e {
+  /**
+   * Every pixel becomes a block of factor x factor pixels.
+   */
+  FN_SCALE_FILTER_NEAREST,
+  /**
+   * The Scale2x (EPX) filter, which smoothes diagonal edges. With
+   * factors larger than two each of its pixels becomes a block.
+   * Odd factors fall back to the nearest filter.
+   */
+  FN_SCALE_FILTER_SCALE2X,
+  FN_SCALE_NUM_FILTERS
+} fn_scale_filter_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Upscale a surface onto another one by an integer factor.
+ *
+ * Both surfaces must have the same pixel format, or the source
+ * must have 8 bits per pixel with a palette, which is expanded to
+ * the format of the target while scaling. The target must be at
+ * least factor times as large as the source. The target is locked
+ * while it is written.
+ *
+ * @param  src     The surface to scale.
+ * @param  dst     The target surface.
+ * @param  factor  The scale factor, at least 1.
+ * @param  filter  The filter to use.
+ */
+void fn_scale_blit(SDL_Surface * src,
+    SDL_Surface * dst,
+    Uint8 factor,
+    fn_scale_filter_e filter);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the name of a filter.
+ *
+ * @param  filter  The filter.
+ *
+ * @return The name.
+ */
+char * fn_scale_filter_name(fn_scale_filter_e filter);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Find a filter by its name.
+ *
+ * @param  name    The name.
+ * @param  filter  Set to the filter if it is found.
+ *
+ * @return 1 if the filter is known, otherwise 0.
+ */
+Uint8 fn_scale_filter_from_name(const char * name,
+    fn_scale_filter_e * filter);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_SCALE_H */
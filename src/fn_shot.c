@@ -93,22 +93,16 @@ Uint8 fn_shot_act(fn_shot_t * shot)
 void fn_shot_blit(fn_shot_t * shot)
 {
   if (shot->is_alive) {
-    SDL_Surface * target = fn_level_get_surface(shot->level);
-    SDL_Rect destrect;
-    fn_tilecache_t * tc = fn_level_get_tilecache(shot->level);
-    FnTexture * tile = fn_tilecache_get_tile(tc,
-        OBJ_SHOT+shot->counter);
-    Uint8 pixelsize = fn_level_get_pixelsize(shot->level);
-    destrect.x =
-      (shot->position.x + shot->position.w / 2 - FN_HALFTILE_WIDTH) *
-      pixelsize;
-    destrect.y = shot->position.y * pixelsize;
-    destrect.w = FN_TILE_WIDTH * pixelsize;
-    destrect.h = shot->position.h * pixelsize;
-    fn_texture_blit_to_sdl_surface(tile, NULL, target, &destrect);
+    fn_level_draw_tile(shot->level, OBJ_SHOT+shot->counter,
+        shot->position.x + shot->position.w / 2 - FN_HALFTILE_WIDTH,
+        shot->position.y,
+        FN_LEVEL_LAYER_FOREGROUND);
 
     if (shot->draw_collision_bounds) {
-      fn_collision_rect_draw(target, pixelsize, &(shot->position));
+      fn_level_draw_bounds(shot->level,
+          shot->position.x, shot->position.y,
+          shot->position.w, shot->position.h,
+          FN_LEVEL_LAYER_FOREGROUND);
     }
   }
 }
@@ -193,6 +187,8 @@ void fn_shot_push(fn_shot_t * shot, Sint16 offset)
 {
   if (shot->countdown == 2) {
     shot->position.x += offset;
+    /* far from the view, the actors may still be spawn records */
+    fn_level_spawn_around(shot->level, &(shot->position));
     fn_list_t * iter = NULL;
     for (iter = fn_list_first(shot->level->actors);
         iter != NULL && shot->countdown != 1;
@@ -0,0 +1,348 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Headless simulation of many levels in parallel
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_simulation.h"
+#include "fn_level.h"
+#include "fn_hero.h"
+#include "fn_demo.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The simulations shared by the threads of a run.
+ */
+typedef struct fn_simulation_pool_t {
+  /**
+   * The environment.
+   */
+  fn_environment_t * env;
+
+  /**
+   * The simulations.
+   */
+  fn_simulation_t * jobs;
+
+  /**
+   * The number of simulations.
+   */
+  size_t num_jobs;
+
+  /**
+   * The index of the next simulation to run.
+   */
+  size_t next;
+
+  /**
+   * Protects next.
+   */
+  SDL_mutex * mutex;
+} fn_simulation_pool_t;
+
+/* --------------------------------------------------------------- */
+
+static fn_level_t * fn_simulation_load_level(
+    fn_environment_t * env,
+    Uint8 levelnumber,
+    fn_hero_t * hero)
+{
+  fn_level_t * lv = NULL;
+  char levelfile[1024];
+  snprintf(levelfile, 1024, "%s/WORLDAL%X.DN%d",
+      fn_environment_get_datapath(env),
+      levelnumber,
+      fn_environment_get_episode(env));
+
+  int fd = open(levelfile, O_RDONLY);
+  if (fd == -1) {
+    fprintf(stderr, "Could not open file %s\n", levelfile);
+    return NULL;
+  }
+  /* the other threads load levels at the same time */
+  lv = fn_level_load_headless(fd, env, hero);
+  close(fd);
+
+  /* no key is held when we enter the level */
+  if (lv != NULL) {
+    fn_hero_set_motion(hero, FN_HERO_MOTION_NONE);
+    fn_hero_fire_stop(hero);
+  }
+  return lv;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Play a level until it ends, the recorded input is exhausted
+ * or the maximum number of ticks is reached.
+ *
+ * @param  lv        The level.
+ * @param  demo      The demo providing the input, or NULL.
+ * @param  fuzz      The state of the random input if demo is NULL.
+ * @param  maxticks  The maximum number of ticks if demo is NULL.
+ *
+ * @return The number of ticks played.
+ */
+static Uint32 fn_simulation_play(fn_level_t * lv,
+    fn_demo_t * demo,
+    Uint32 * fuzz,
+    Uint32 maxticks)
+{
+  fn_hero_t * hero = fn_level_get_hero(lv);
+  Uint32 ticks = 0;
+  Uint8 applied = 0;
+  Uint8 input = 0;
+  SDL_Rect view;
+
+  view.w = FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH;
+  view.h = FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT;
+
+  while (fn_level_keep_on_playing(lv)) {
+    if (demo != NULL) {
+      if (!fn_demo_tick(demo, &input)) {
+        break;
+      }
+    } else {
+      if (ticks == maxticks) {
+        break;
+      }
+      if (ticks % 8 == 0) {
+        /* hold a random combination of keys for a while */
+        *fuzz = *fuzz * 1103515245 + 12345;
+        input = (*fuzz >> 16) & (FNK_LEFT_ENABLED | FNK_RIGHT_ENABLED |
+            FNK_FIRE_ENABLED | FNK_JUMP_ENABLED | FNK_INTERACT_ENABLED);
+      }
+    }
+    fn_level_apply_input(lv, applied, input);
+    applied = input;
+
+    fn_level_center_view(lv, &view);
+    fn_level_update_visibility(lv, &view);
+    fn_level_act(lv);
+
+    /* nobody looks at the events, we only keep the queue empty */
+    fn_hero_take_events(hero);
+    ticks++;
+  }
+
+  return ticks;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_simulation_run_job(fn_environment_t * env,
+    fn_simulation_t * job)
+{
+  fn_hero_t * hero = fn_hero_create(env);
+  fn_level_t * lv = NULL;
+
+  fn_hero_reset(hero);
+
+  job->ticks_played = 0;
+  job->failed = 0;
+
+  if (job->demopath != NULL) {
+    fn_demo_t * demo = fn_demo_open_replay(job->demopath,
+        FN_DEMO_MODE_HEADLESS);
+    if (demo == NULL) {
+      job->failed = 1;
+      fn_hero_delete(hero);
+      return;
+    }
+
+    Uint8 levelnumber = fn_demo_read_level(demo);
+    int success = 1;
+    while (success && levelnumber != 0) {
+      lv = fn_simulation_load_level(env, levelnumber, hero);
+      if (lv == NULL) {
+        job->failed = 1;
+        break;
+      }
+      Uint32 seed = 0;
+      fn_demo_start_level(demo, levelnumber, hero, &seed);
+      fn_level_set_seed(lv, seed);
+
+      job->ticks_played += fn_simulation_play(lv, demo, NULL, 0);
+
+      if (!fn_demo_end_level(demo, lv)) {
+        job->failed = 1;
+      }
+      success = lv->levelpassed;
+      fn_level_free(lv);
+      levelnumber = fn_demo_read_level(demo);
+    }
+    fn_demo_free(demo);
+  } else {
+    Uint32 fuzz = job->seed;
+    lv = fn_simulation_load_level(env, job->levelnumber, hero);
+    if (lv == NULL) {
+      job->failed = 1;
+    } else {
+      fn_level_set_seed(lv, job->seed);
+      job->ticks_played = fn_simulation_play(lv, NULL, &fuzz, job->ticks);
+      fn_level_free(lv);
+    }
+  }
+
+  fn_hero_delete(hero);
+}
+
+/* --------------------------------------------------------------- */
+
+static int fn_simulation_thread(void * data)
+{
+  fn_simulation_pool_t * pool = data;
+
+  while (1) {
+    size_t index = 0;
+
+    SDL_LockMutex(pool->mutex);
+    index = pool->next;
+    if (pool->next < pool->num_jobs) {
+      pool->next++;
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    if (index >= pool->num_jobs) {
+      return 0;
+    }
+    fn_simulation_run_job(pool->env, &(pool->jobs[index]));
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+Uint32 fn_simulation_run(fn_environment_t * env,
+    fn_simulation_t * jobs,
+    size_t num_jobs,
+    Uint8 num_threads)
+{
+  fn_simulation_pool_t pool;
+  SDL_Thread ** threads = NULL;
+  Uint32 failed = 0;
+  size_t i = 0;
+
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+
+  pool.env = env;
+  pool.jobs = jobs;
+  pool.num_jobs = num_jobs;
+  pool.next = 0;
+  pool.mutex = SDL_CreateMutex();
+
+  threads = malloc(sizeof(SDL_Thread *) * num_threads);
+  for (i = 0; i < num_threads; i++) {
+    threads[i] = SDL_CreateThread(fn_simulation_thread, &pool);
+  }
+  for (i = 0; i < num_threads; i++) {
+    if (threads[i] != NULL) {
+      SDL_WaitThread(threads[i], NULL);
+    }
+  }
+  free(threads);
+  SDL_DestroyMutex(pool.mutex);
+
+  for (i = 0; i < num_jobs; i++) {
+    if (jobs[i].failed) {
+      failed++;
+    }
+  }
+  return failed;
+}
+
+/* --------------------------------------------------------------- */
+
+int fn_simulation_main(fn_environment_t * env,
+    int argc,
+    char ** argv)
+{
+  fn_simulation_t * jobs = NULL;
+  size_t num_jobs = 0;
+  Uint8 num_threads = 1;
+  Uint32 ticks = 0;
+  Uint32 failed = 0;
+  size_t i = 0;
+
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s --validate THREADS DEMOFILE...\n"
+        "       %s --fuzz THREADS RUNS TICKS\n", argv[0], argv[0]);
+    return 1;
+  }
+  num_threads = atoi(argv[2]);
+
+  if (strcmp(argv[1], "--validate") == 0) {
+    num_jobs = argc - 3;
+    jobs = malloc(sizeof(fn_simulation_t) * (num_jobs + 1));
+    for (i = 0; i < num_jobs; i++) {
+      memset(&(jobs[i]), 0, sizeof(fn_simulation_t));
+      jobs[i].demopath = argv[i + 3];
+    }
+  } else if (strcmp(argv[1], "--fuzz") == 0 && argc == 5) {
+    /* the levels in the order they are played, without the
+     * interlevel */
+    Uint8 const levels[] = { 1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    num_jobs = atoi(argv[3]);
+    jobs = malloc(sizeof(fn_simulation_t) * (num_jobs + 1));
+    for (i = 0; i < num_jobs; i++) {
+      memset(&(jobs[i]), 0, sizeof(fn_simulation_t));
+      jobs[i].levelnumber = levels[i % sizeof(levels)];
+      jobs[i].seed = i + 1;
+      jobs[i].ticks = atoi(argv[4]);
+    }
+  } else {
+    fprintf(stderr, "Unknown simulation arguments.\n");
+    return 1;
+  }
+
+  Uint32 start = SDL_GetTicks();
+  failed = fn_simulation_run(env, jobs, num_jobs, num_threads);
+  Uint32 duration = SDL_GetTicks() - start;
+
+  for (i = 0; i < num_jobs; i++) {
+    ticks += jobs[i].ticks_played;
+  }
+  printf("Simulated %u ticks in %u ms on %d threads "
+      "(%u ticks per second), %u of %lu runs failed.\n",
+      ticks, duration, num_threads,
+      duration > 0 ? (Uint32)((Uint64)ticks * 1000 / duration) : ticks,
+      failed, (unsigned long)num_jobs);
+
+  free(jobs);
+  return (failed == 0) ? 0 : 1;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,129 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Headless simulation of many levels in parallel
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_SIMULATION_H
+#define FN_SIMULATION_H
+
+/* --------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+typedef struct fn_simulation_t fn_simulation_t;
+
+/* --------------------------------------------------------------- */
+
+#include "fn_environment.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A single headless simulation run. Either a demo is replayed
+ * and its recorded state is validated, or a level is played with
+ * random input.
+ */
+struct fn_simulation_t {
+  /**
+   * The demo to replay, or NULL to play with random input.
+   */
+  char * demopath;
+
+  /**
+   * The level played with random input.
+   */
+  Uint8 levelnumber;
+
+  /**
+   * The seed for the level and the random input.
+   */
+  Uint32 seed;
+
+  /**
+   * The maximum number of ticks played with random input.
+   */
+  Uint32 ticks;
+
+  /**
+   * The number of ticks that were simulated.
+   */
+  Uint32 ticks_played;
+
+  /**
+   * Set if the level could not be loaded or the replayed
+   * demo did not match the recording.
+   */
+  Uint8 failed;
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Run simulations on several threads. Every simulation owns its
+ * level and hero, the environment is only read.
+ *
+ * @param  env          The environment with the loaded tiles.
+ * @param  jobs         The simulations to run.
+ * @param  num_jobs     The number of simulations.
+ * @param  num_threads  The number of threads to use.
+ *
+ * @return The number of failed simulations.
+ */
+Uint32 fn_simulation_run(fn_environment_t * env,
+    fn_simulation_t * jobs,
+    size_t num_jobs,
+    Uint8 num_threads);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Run the simulations requested on the command line and print
+ * the throughput. The arguments are either
+ *
+ *   --validate THREADS DEMOFILE...
+ *
+ * to replay and validate demos, or
+ *
+ *   --fuzz THREADS RUNS TICKS
+ *
+ * to play RUNS levels with random input for at most TICKS ticks.
+ *
+ * @param  env   The environment with the loaded tiles.
+ * @param  argc  The number of arguments.
+ * @param  argv  The arguments.
+ *
+ * @return The exit code for the program.
+ */
+int fn_simulation_main(fn_environment_t * env,
+    int argc,
+    char ** argv);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_SIMULATION_H */
@@ -0,0 +1,556 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Binary snapshots of the game state
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_snapshot.h"
+
+/* --------------------------------------------------------------- */
+
+static char const fn_snapshot_magic[4] = { 'F', 'N', 'S', 'S' };
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The size of the snapshot header: magic, version, episode,
+ * level number and sequence number.
+ */
+#define FN_SNAPSHOT_HEADER_SIZE 8
+
+/* --------------------------------------------------------------- */
+
+fn_snapshot_t * fn_snapshot_create(void)
+{
+  fn_snapshot_t * snapshot = malloc(sizeof(fn_snapshot_t));
+  snapshot->data = NULL;
+  snapshot->size = 0;
+  snapshot->capacity = 0;
+  snapshot->pos = 0;
+  snapshot->error = 0;
+  return snapshot;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_snapshot_free(fn_snapshot_t * snapshot)
+{
+  if (snapshot->data != NULL) {
+    free(snapshot->data); snapshot->data = NULL;
+  }
+  free(snapshot);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_snapshot_clear(fn_snapshot_t * snapshot)
+{
+  snapshot->size = 0;
+  snapshot->pos = 0;
+  snapshot->error = 0;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_snapshot_resize(fn_snapshot_t * snapshot, size_t size)
+{
+  if (size > snapshot->capacity) {
+    size_t capacity = snapshot->capacity;
+    if (capacity == 0) {
+      capacity = 64 * 1024;
+    }
+    while (size > capacity) {
+      capacity *= 2;
+    }
+    snapshot->data = realloc(snapshot->data, capacity);
+    snapshot->capacity = capacity;
+  }
+  snapshot->size = size;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_snapshot_write(fn_snapshot_t * snapshot,
+    const void * data,
+    size_t len)
+{
+  size_t pos = snapshot->size;
+  fn_snapshot_resize(snapshot, pos + len);
+  memcpy(snapshot->data + pos, data, len);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_snapshot_read(fn_snapshot_t * snapshot,
+    void * data,
+    size_t len)
+{
+  if (snapshot->pos + len > snapshot->size) {
+    snapshot->error = 1;
+    memset(data, 0, len);
+    return 0;
+  }
+  memcpy(data, snapshot->data + snapshot->pos, len);
+  snapshot->pos += len;
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the index under which an actor is stored in the snapshot.
+ *
+ * @param  lv     The level.
+ * @param  actor  The actor.
+ *
+ * @return The index, or -1 if the actor is not stored.
+ */
+static Sint16 fn_snapshot_actor_index(fn_level_t * lv,
+    fn_level_actor_t * actor)
+{
+  fn_list_t * iter = NULL;
+  Sint16 index = 0;
+
+  if (actor == NULL) {
+    return -1;
+  }
+
+  for (iter = fn_list_first(lv->actors);
+      iter != fn_list_last(lv->actors);
+      iter = fn_list_next(iter))
+  {
+    fn_level_actor_t * current = iter->data;
+    if (current == NULL || !fn_level_actor_can_serialize(current)) {
+      continue;
+    }
+    if (current == actor) {
+      return index;
+    }
+    index++;
+  }
+  return -1;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_snapshot_save_level(fn_snapshot_t * snapshot,
+    fn_level_t * lv,
+    Uint8 levelnumber,
+    Uint8 sequence)
+{
+  fn_list_t * iter = NULL;
+  fn_hero_t * hero = fn_level_get_hero(lv);
+  fn_environment_t * env = fn_level_get_environment(lv);
+  Uint8 header[FN_SNAPSHOT_HEADER_SIZE];
+  Uint16 num_actors = 0;
+  Uint16 num_spawns = 0;
+  Uint16 num_hurting = 0;
+  Uint8 num_shots = 0;
+  Uint32 animated_frames = lv->animated_frames;
+  Sint16 index = 0;
+
+  fn_snapshot_clear(snapshot);
+  lv->snapshot = snapshot;
+
+  memcpy(header, fn_snapshot_magic, sizeof(fn_snapshot_magic));
+  header[4] = FN_SNAPSHOT_VERSION;
+  header[5] = fn_environment_get_episode(env);
+  header[6] = levelnumber;
+  header[7] = sequence;
+  fn_snapshot_write(snapshot, header, FN_SNAPSHOT_HEADER_SIZE);
+
+  /* the level */
+  fn_snapshot_write(snapshot, lv->tiles, sizeof(lv->tiles));
+  fn_snapshot_write(snapshot, lv->solid, sizeof(lv->solid));
+  fn_snapshot_write_value(snapshot, lv->levelpassed);
+  fn_snapshot_write_value(snapshot, animated_frames);
+  fn_snapshot_write_value(snapshot, lv->seed);
+  fn_snapshot_write_value(snapshot, lv->ticks);
+  fn_snapshot_write_value(snapshot, lv->next_sequence);
+  num_spawns = lv->num_spawns;
+  fn_snapshot_write_value(snapshot, num_spawns);
+  fn_snapshot_write(snapshot, lv->spawns,
+      num_spawns * sizeof(fn_level_spawn_t));
+
+  /* the actors */
+  for (iter = fn_list_first(lv->actors);
+      iter != fn_list_last(lv->actors);
+      iter = fn_list_next(iter))
+  {
+    if (iter->data != NULL && fn_level_actor_can_serialize(iter->data)) {
+      num_actors++;
+    }
+  }
+  fn_snapshot_write_value(snapshot, num_actors);
+  for (iter = fn_list_first(lv->actors);
+      iter != fn_list_last(lv->actors);
+      iter = fn_list_next(iter))
+  {
+    if (iter->data != NULL && fn_level_actor_can_serialize(iter->data)) {
+      fn_level_actor_serialize(iter->data);
+    }
+  }
+  index = fn_snapshot_actor_index(lv, lv->interactor);
+  fn_snapshot_write_value(snapshot, index);
+
+  /* the shots */
+  for (iter = fn_list_first(lv->shots);
+      iter != fn_list_last(lv->shots);
+      iter = fn_list_next(iter))
+  {
+    if (iter->data != NULL) {
+      num_shots++;
+    }
+  }
+  fn_snapshot_write_value(snapshot, num_shots);
+  for (iter = fn_list_first(lv->shots);
+      iter != fn_list_last(lv->shots);
+      iter = fn_list_next(iter))
+  {
+    fn_shot_t * shot = iter->data;
+    if (shot != NULL) {
+      fn_snapshot_write_value(snapshot, shot->position);
+      fn_snapshot_write_value(snapshot, shot->is_alive);
+      fn_snapshot_write_value(snapshot, shot->direction);
+      fn_snapshot_write_value(snapshot, shot->counter);
+      fn_snapshot_write_value(snapshot, shot->countdown);
+    }
+  }
+
+  /* the hero */
+  fn_snapshot_write_value(snapshot, hero->direction);
+  fn_snapshot_write_value(snapshot, hero->motion);
+  fn_snapshot_write_value(snapshot, hero->flying);
+  fn_snapshot_write_value(snapshot, hero->shooting);
+  fn_snapshot_write_value(snapshot, hero->firepower);
+  fn_snapshot_write_value(snapshot, hero->counter);
+  fn_snapshot_write_value(snapshot, hero->tilenr);
+  fn_snapshot_write_value(snapshot, hero->animationframe);
+  fn_snapshot_write_value(snapshot, hero->num_animationframes);
+  fn_snapshot_write_value(snapshot, hero->inventory);
+  fn_snapshot_write_value(snapshot, hero->health);
+  fn_snapshot_write_value(snapshot, hero->position);
+  fn_snapshot_write_value(snapshot, hero->score);
+  fn_snapshot_write_value(snapshot, hero->hidden);
+  fn_snapshot_write_value(snapshot, hero->fetchedletter);
+  fn_snapshot_write_value(snapshot, hero->verticalspeed);
+  fn_snapshot_write_value(snapshot, hero->immunitycountdown);
+  fn_snapshot_write_value(snapshot, hero->immunityduration);
+  fn_snapshot_write_value(snapshot, hero->turned_around);
+  fn_snapshot_write_value(snapshot, hero->is_moving_horizontally);
+
+  for (iter = fn_list_first(hero->hurtingactors);
+      iter != fn_list_last(hero->hurtingactors);
+      iter = fn_list_next(iter))
+  {
+    num_hurting++;
+  }
+  fn_snapshot_write_value(snapshot, num_hurting);
+  for (iter = fn_list_first(hero->hurtingactors);
+      iter != fn_list_last(hero->hurtingactors);
+      iter = fn_list_next(iter))
+  {
+    index = fn_snapshot_actor_index(lv, iter->data);
+    fn_snapshot_write_value(snapshot, index);
+  }
+
+  lv->snapshot = NULL;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_snapshot_get_level(fn_snapshot_t * snapshot,
+    Uint8 * episode,
+    Uint8 * levelnumber,
+    Uint8 * sequence)
+{
+  if (snapshot->size < FN_SNAPSHOT_HEADER_SIZE ||
+      memcmp(snapshot->data, fn_snapshot_magic,
+        sizeof(fn_snapshot_magic)) != 0 ||
+      snapshot->data[4] != FN_SNAPSHOT_VERSION)
+  {
+    return 0;
+  }
+  *episode = snapshot->data[5];
+  *levelnumber = snapshot->data[6];
+  *sequence = snapshot->data[7];
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a list of actors and the list itself.
+ *
+ * @param  actors  The list of actors.
+ */
+static void fn_snapshot_free_actors(fn_list_t * actors)
+{
+  fn_list_t * iter = NULL;
+  for (iter = fn_list_first(actors);
+      iter != fn_list_last(actors);
+      iter = fn_list_next(iter))
+  {
+    if (iter->data != NULL) {
+      fn_level_actor_free(iter->data);
+      iter->data = NULL;
+    }
+  }
+  fn_list_free(actors);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a list of shots and the list itself.
+ *
+ * @param  shots  The list of shots.
+ */
+static void fn_snapshot_free_shots(fn_list_t * shots)
+{
+  fn_list_t * iter = NULL;
+  for (iter = fn_list_first(shots);
+      iter != fn_list_last(shots);
+      iter = fn_list_next(iter))
+  {
+    if (iter->data != NULL) {
+      fn_shot_free(iter->data);
+      iter->data = NULL;
+    }
+  }
+  fn_list_free(shots);
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_snapshot_restore_level(fn_snapshot_t * snapshot,
+    fn_level_t * lv)
+{
+  fn_hero_t * hero = fn_level_get_hero(lv);
+  fn_hero_t restored = *hero;
+  fn_level_actor_t ** actors = NULL;
+  fn_level_actor_t * interactor = NULL;
+  fn_list_t * actorlist = NULL;
+  fn_list_t * shotlist = NULL;
+  fn_level_spawn_t * spawns = NULL;
+  Uint16 (* tiles)[FN_LEVEL_WIDTH] = NULL;
+  Uint8 (* solid)[FN_LEVEL_WIDTH] = NULL;
+  Uint8 episode = 0;
+  Uint8 levelnumber = 0;
+  Uint8 sequence = 0;
+  Uint16 num_actors = 0;
+  Uint16 num_spawns = 0;
+  Uint16 num_hurting = 0;
+  Uint8 num_shots = 0;
+  int levelpassed = 0;
+  Uint32 animated_frames = 0;
+  Uint32 seed = 0;
+  Uint32 ticks = 0;
+  Uint32 next_sequence = 0;
+  Sint16 index = 0;
+  Uint16 i = 0;
+
+  if (!fn_snapshot_get_level(snapshot,
+        &episode, &levelnumber, &sequence))
+  {
+    return 0;
+  }
+  snapshot->pos = FN_SNAPSHOT_HEADER_SIZE;
+  snapshot->error = 0;
+  lv->snapshot = snapshot;
+
+  /* everything is read aside first, the level is only changed
+   * once the whole snapshot could be read */
+  tiles = malloc(sizeof(lv->tiles));
+  solid = malloc(sizeof(lv->solid));
+  spawns = malloc(lv->num_spawns * sizeof(fn_level_spawn_t) + 1);
+  if (tiles == NULL || solid == NULL || spawns == NULL) {
+    snapshot->error = 1;
+  }
+
+  /* the level */
+  if (!snapshot->error) {
+    fn_snapshot_read(snapshot, tiles, sizeof(lv->tiles));
+    fn_snapshot_read(snapshot, solid, sizeof(lv->solid));
+  }
+  fn_snapshot_read_value(snapshot, levelpassed);
+  fn_snapshot_read_value(snapshot, animated_frames);
+  fn_snapshot_read_value(snapshot, seed);
+  fn_snapshot_read_value(snapshot, ticks);
+  fn_snapshot_read_value(snapshot, next_sequence);
+  fn_snapshot_read_value(snapshot, num_spawns);
+  if (num_spawns == lv->num_spawns && !snapshot->error) {
+    fn_snapshot_read(snapshot, spawns,
+        num_spawns * sizeof(fn_level_spawn_t));
+  } else {
+    snapshot->error = 1;
+  }
+
+  /* the actors */
+  fn_snapshot_read_value(snapshot, num_actors);
+  actors = malloc(sizeof(fn_level_actor_t *) * (num_actors + 1));
+  for (i = 0; i < num_actors && !snapshot->error; i++) {
+    actors[i] = fn_level_actor_deserialize(lv);
+    if (actors[i] == NULL) {
+      snapshot->error = 1;
+      break;
+    }
+    actorlist = fn_list_append(actorlist, actors[i]);
+  }
+  num_actors = i;
+  fn_snapshot_read_value(snapshot, index);
+  if (index >= 0 && index < num_actors) {
+    interactor = actors[index];
+  }
+
+  /* the shots */
+  fn_snapshot_read_value(snapshot, num_shots);
+  for (i = 0; i < num_shots && !snapshot->error; i++) {
+    fn_shot_t * shot = fn_shot_create(lv, 0, 0,
+        fn_horizontal_direction_right);
+    fn_snapshot_read_value(snapshot, shot->position);
+    fn_snapshot_read_value(snapshot, shot->is_alive);
+    fn_snapshot_read_value(snapshot, shot->direction);
+    fn_snapshot_read_value(snapshot, shot->counter);
+    fn_snapshot_read_value(snapshot, shot->countdown);
+    fn_shot_set_draw_collision_bounds(shot,
+        fn_environment_get_draw_collision_bounds(lv->environment));
+    shotlist = fn_list_append(shotlist, shot);
+  }
+  num_shots = i;
+
+  /* the hero */
+  fn_snapshot_read_value(snapshot, restored.direction);
+  fn_snapshot_read_value(snapshot, restored.motion);
+  fn_snapshot_read_value(snapshot, restored.flying);
+  fn_snapshot_read_value(snapshot, restored.shooting);
+  fn_snapshot_read_value(snapshot, restored.firepower);
+  fn_snapshot_read_value(snapshot, restored.counter);
+  fn_snapshot_read_value(snapshot, restored.tilenr);
+  fn_snapshot_read_value(snapshot, restored.animationframe);
+  fn_snapshot_read_value(snapshot, restored.num_animationframes);
+  fn_snapshot_read_value(snapshot, restored.inventory);
+  fn_snapshot_read_value(snapshot, restored.health);
+  fn_snapshot_read_value(snapshot, restored.position);
+  fn_snapshot_read_value(snapshot, restored.score);
+  fn_snapshot_read_value(snapshot, restored.hidden);
+  fn_snapshot_read_value(snapshot, restored.fetchedletter);
+  fn_snapshot_read_value(snapshot, restored.verticalspeed);
+  fn_snapshot_read_value(snapshot, restored.immunitycountdown);
+  fn_snapshot_read_value(snapshot, restored.immunityduration);
+  fn_snapshot_read_value(snapshot, restored.turned_around);
+  fn_snapshot_read_value(snapshot, restored.is_moving_horizontally);
+
+  restored.hurtingactors = NULL;
+  fn_snapshot_read_value(snapshot, num_hurting);
+  for (i = 0; i < num_hurting && !snapshot->error; i++) {
+    fn_snapshot_read_value(snapshot, index);
+    if (index >= 0 && index < num_actors) {
+      restored.hurtingactors = fn_list_append(restored.hurtingactors,
+          actors[index]);
+    }
+  }
+
+  free(actors);
+  lv->snapshot = NULL;
+
+  if (snapshot->error) {
+    fn_list_free(restored.hurtingactors);
+    fn_snapshot_free_shots(shotlist);
+    fn_snapshot_free_actors(actorlist);
+    free(spawns);
+    free(solid);
+    free(tiles);
+    fprintf(stderr, "The snapshot is truncated or corrupt.\n");
+    return 0;
+  }
+
+  /* throw away the current state */
+  fn_list_free(hero->hurtingactors);
+  fn_snapshot_free_actors(lv->actors);
+  fn_snapshot_free_shots(lv->shots);
+
+  /* and take the restored one */
+  memcpy(lv->tiles, tiles, sizeof(lv->tiles));
+  memcpy(lv->solid, solid, sizeof(lv->solid));
+  memcpy(lv->spawns, spawns, num_spawns * sizeof(fn_level_spawn_t));
+  lv->levelpassed = levelpassed;
+  lv->animated_frames = animated_frames;
+  lv->seed = seed;
+  lv->ticks = ticks;
+  lv->next_sequence = next_sequence;
+  lv->actors = actorlist;
+  fn_level_schedule_reset(lv);
+  lv->interactor = interactor;
+  lv->shots = shotlist;
+  lv->num_shots = num_shots;
+  *hero = restored;
+
+  free(spawns);
+  free(solid);
+  free(tiles);
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+Uint8 fn_snapshot_store(fn_snapshot_t * snapshot, char * path)
+{
+  FILE * file = fopen(path, "wb");
+  if (file == NULL) {
+    return 0;
+  }
+  size_t written = fwrite(snapshot->data, 1, snapshot->size, file);
+  fclose(file);
+  return (written == snapshot->size);
+}
+
+/* --------------------------------------------------------------- */
+
+fn_snapshot_t * fn_snapshot_load(char * path)
+{
+  Uint8 buf[4096];
+  size_t len = 0;
+  FILE * file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  fn_snapshot_t * snapshot = fn_snapshot_create();
+  while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+    fn_snapshot_write(snapshot, buf, len);
+  }
+  fclose(file);
+
+  return snapshot;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,245 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Binary snapshots of the game state
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_SNAPSHOT_H
+#define FN_SNAPSHOT_H
+
+/* --------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+typedef struct fn_snapshot_t fn_snapshot_t;
+
+/* --------------------------------------------------------------- */
+
+#include "fn_level.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The snapshot format version. Increase this whenever the layout
+ * of the snapshot or of any serialized actor data changes.
+ */
+#define FN_SNAPSHOT_VERSION 4
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A growable memory buffer holding a snapshot.
+ */
+struct fn_snapshot_t {
+  /**
+   * The snapshot data.
+   */
+  Uint8 * data;
+
+  /**
+   * The number of bytes used inside data.
+   */
+  size_t size;
+
+  /**
+   * The number of bytes allocated for data.
+   */
+  size_t capacity;
+
+  /**
+   * The read position.
+   */
+  size_t pos;
+
+  /**
+   * Set if a read went beyond the end of the data.
+   */
+  Uint8 error;
+};
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Write a variable to a snapshot.
+ */
+#define fn_snapshot_write_value(snapshot, value) \
+  fn_snapshot_write((snapshot), &(value), sizeof(value))
+
+/**
+ * Read a variable from a snapshot.
+ */
+#define fn_snapshot_read_value(snapshot, value) \
+  fn_snapshot_read((snapshot), &(value), sizeof(value))
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create an empty snapshot.
+ *
+ * @return The newly created snapshot.
+ */
+fn_snapshot_t * fn_snapshot_create(void);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a snapshot.
+ *
+ * @param  snapshot  The snapshot.
+ */
+void fn_snapshot_free(fn_snapshot_t * snapshot);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Remove all data from a snapshot. The memory is kept so that
+ * writing a new snapshot of the same size needs no allocation.
+ *
+ * @param  snapshot  The snapshot.
+ */
+void fn_snapshot_clear(fn_snapshot_t * snapshot);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Append data to a snapshot.
+ *
+ * @param  snapshot  The snapshot.
+ * @param  data      The data to append.
+ * @param  len       The number of bytes to append.
+ */
+void fn_snapshot_write(fn_snapshot_t * snapshot,
+    const void * data,
+    size_t len);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Change the number of bytes used inside a snapshot. New bytes
+ * are not initialized.
+ *
+ * @param  snapshot  The snapshot.
+ * @param  size      The new size.
+ */
+void fn_snapshot_resize(fn_snapshot_t * snapshot, size_t size);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read data from the current read position of a snapshot.
+ *
+ * @param  snapshot  The snapshot.
+ * @param  data      Where to store the data.
+ * @param  len       The number of bytes to read.
+ *
+ * @return 1 on success, 0 if the snapshot contains less data.
+ */
+Uint8 fn_snapshot_read(fn_snapshot_t * snapshot,
+    void * data,
+    size_t len);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Store the complete state of a running level in a snapshot.
+ *
+ * This includes the tiles and solid flags of the level, all
+ * actors that provide a serialize function, the shots, the hero
+ * and the episode.
+ *
+ * @param  snapshot     The snapshot. Previous content is removed.
+ * @param  lv           The level.
+ * @param  levelnumber  The number of the level.
+ * @param  sequence     The number of the last regular level that
+ *                      was entered (differs from levelnumber when
+ *                      the hero is inside the interlevel).
+ */
+void fn_snapshot_save_level(fn_snapshot_t * snapshot,
+    fn_level_t * lv,
+    Uint8 levelnumber,
+    Uint8 sequence);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Read the level information from the header of a snapshot.
+ *
+ * @param  snapshot     The snapshot.
+ * @param  episode      Where to store the episode number.
+ * @param  levelnumber  Where to store the level number.
+ * @param  sequence     Where to store the sequence number.
+ *
+ * @return 1 if the snapshot is valid, 0 if not.
+ */
+Uint8 fn_snapshot_get_level(fn_snapshot_t * snapshot,
+    Uint8 * episode,
+    Uint8 * levelnumber,
+    Uint8 * sequence);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Restore the state of a level from a snapshot. The level must
+ * be the same one from which the snapshot was taken. No level
+ * file is read, all actors and shots of the level are replaced
+ * by the ones stored in the snapshot.
+ *
+ * @param  snapshot  The snapshot.
+ * @param  lv        The level.
+ *
+ * @return 1 on success, 0 if the snapshot is invalid.
+ */
+Uint8 fn_snapshot_restore_level(fn_snapshot_t * snapshot,
+    fn_level_t * lv);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Store a snapshot in a file.
+ *
+ * @param  snapshot  The snapshot.
+ * @param  path      The path of the file.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+Uint8 fn_snapshot_store(fn_snapshot_t * snapshot, char * path);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Load a snapshot from a file.
+ *
+ * @param  path  The path of the file.
+ *
+ * @return The snapshot, or NULL if the file could not be read.
+ */
+fn_snapshot_t * fn_snapshot_load(char * path);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_SNAPSHOT_H */
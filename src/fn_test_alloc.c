@@ -0,0 +1,314 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Test that drawing a frame does not allocate memory
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn.h"
+#include "fn_borders.h"
+#include "fn_text.h"
+#include "fn_level.h"
+#include "fn_hero.h"
+#include "fn_msgbox.h"
+#include "fn_object.h"
+#include "fn_error.h"
+#include "fn_error_cmdline.h"
+#include "fntexture.h"
+#include "fngeometry.h"
+#include "fnscreen.h"
+
+/* --------------------------------------------------------------- */
+
+#define FN_TEST_ALLOC_FRAMES 100
+
+#define FN_TEST_ALLOC_DIALOGS 100
+
+/**
+ * The level frames run before counting, until the hero has landed
+ * and the actors around the view were created.
+ */
+#define FN_TEST_ALLOC_WARMUP 50
+
+/* --------------------------------------------------------------- */
+
+/*
+ * The allocator of the C library is replaced by counting wrappers.
+ * This relies on the __libc_* entry points of the GNU C library;
+ * glib and SDL both end up in malloc, so every allocation of a
+ * frame is seen here.
+ */
+extern void * __libc_malloc(size_t size);
+extern void * __libc_calloc(size_t nmemb, size_t size);
+extern void * __libc_realloc(void * ptr, size_t size);
+extern void __libc_free(void * ptr);
+
+static volatile unsigned long fn_test_alloc_count = 0;
+
+void * malloc(size_t size)
+{
+  fn_test_alloc_count++;
+  return __libc_malloc(size);
+}
+
+void * calloc(size_t nmemb, size_t size)
+{
+  fn_test_alloc_count++;
+  return __libc_calloc(nmemb, size);
+}
+
+void * realloc(void * ptr, size_t size)
+{
+  fn_test_alloc_count++;
+  return __libc_realloc(ptr, size);
+}
+
+void free(void * ptr)
+{
+  __libc_free(ptr);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Draw what the game draws every frame: tiles blitted onto a
+ * texture, a text, and the level window cloned to the screen
+ * through both the rectangle and the geometry functions.
+ */
+static void fn_test_alloc_frame(fn_environment_t * env,
+    FnTexture * level,
+    FnTexture * hud,
+    FnGeometry * srcrect,
+    FnGeometry * dstrect)
+{
+  int tiles[4] = { OBJ_HEALTH, OBJ_NONHEALTH, OBJ_HEALTH, -1 };
+  FnRect textrect = { FN_HALFTILE_WIDTH, FN_HALFTILE_HEIGHT, 0, 0 };
+  FnRect hudrect = { 30 * FN_FONT_WIDTH, 7 * FN_FONT_HEIGHT, 0, 0 };
+  FnScreen * screen = fn_environment_get_screen(env);
+
+  fn_borders_blit_array(env, hud, tiles, 4, 1, 0);
+  fn_text_print_rect(level, &textrect, env, "FRAME\n00001234");
+  fn_text_print(level, srcrect, env, "SCORE");
+  fn_texture_clone_to_texture(hud, NULL, level, srcrect);
+  fn_screen_clone_texture(screen, dstrect, level, srcrect);
+  fn_screen_clone_texture_rect(screen, &hudrect, hud, NULL);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Show what fn_infobox_show shows, and a second message box over
+ * it, without waiting for a key.
+ */
+static void fn_test_alloc_dialog(fn_environment_t * env)
+{
+  FnScreen * screen = fn_environment_get_screen(env);
+  FnRect outer = { 2 * FN_TILE_WIDTH, 2 * FN_TILE_HEIGHT, 0, 0 };
+  FnRect inner = { 4 * FN_TILE_WIDTH, 4 * FN_TILE_HEIGHT, 0, 0 };
+  FnTexture * msgbox = NULL;
+
+  fn_screen_snapshot_push(screen);
+  msgbox = fn_msgbox_cached(env, "Outer dialog\n");
+  fn_screen_clone_texture_rect(screen, &outer, msgbox, NULL);
+  g_object_unref(msgbox);
+
+  fn_screen_snapshot_push(screen);
+  msgbox = fn_msgbox_cached(env, "Inner dialog\n");
+  fn_screen_clone_texture_rect(screen, &inner, msgbox, NULL);
+  g_object_unref(msgbox);
+
+  fn_screen_snapshot_pop(screen);
+  fn_screen_snapshot_pop(screen);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Run one frame of the game: the level acts, is blitted with its
+ * actors and the view is cloned to the screen and presented.
+ */
+static void fn_test_alloc_level_frame(fn_environment_t * env,
+    fn_level_t * lv,
+    FnTexture * level,
+    FnGeometry * srcrect,
+    FnGeometry * dstrect)
+{
+  FnScreen * screen = fn_environment_get_screen(env);
+  SDL_Rect view;
+
+  view.x = fn_geometry_get_x(srcrect);
+  view.y = fn_geometry_get_y(srcrect);
+  view.w = fn_geometry_get_width(srcrect);
+  view.h = fn_geometry_get_height(srcrect);
+  fn_level_update_visibility(lv, &view);
+  fn_level_act(lv);
+  fn_hero_take_events(fn_level_get_hero(lv));
+
+  fn_level_blit_to_texture(lv, level, srcrect, srcrect, NULL, NULL);
+  fn_screen_clone_texture(screen, dstrect, level, srcrect);
+  fn_screen_update(screen);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Load the first level of the episode.
+ */
+static fn_level_t * fn_test_alloc_load_level(fn_environment_t * env)
+{
+  char path[1024];
+  fn_level_t * lv = NULL;
+
+  snprintf(path, sizeof(path), "%s/WORLDAL1.DN%d",
+      fn_environment_get_datapath(env),
+      fn_environment_get_episode(env));
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    fprintf(stderr, "Could not open file %s\n", path);
+    return NULL;
+  }
+  lv = fn_level_load(fd, env);
+  close(fd);
+  return lv;
+}
+
+/* --------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+  unsigned long allocations = 0;
+  int i = 0;
+
+  fn_error_set_handler(fn_error_print_commandline);
+
+  /* the slice allocator would hide allocations from us */
+  setenv("G_SLICE", "always-malloc", 1);
+  setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+  fn_environment_t * env = fn_environment_create();
+  if (!fn_environment_check_for_episodes(env) ||
+      !fn_environment_load_tilecache(env))
+  {
+    fprintf(stderr, "Could not load the game data.\n");
+    return 1;
+  }
+
+  FnGraphicOptions * graphic_options =
+    fn_environment_get_graphic_options(env);
+  FnTexture * level = fn_texture_new_with_options(
+      FN_TILE_WIDTH * FN_LEVEL_WIDTH,
+      FN_TILE_HEIGHT * FN_LEVEL_HEIGHT,
+      graphic_options);
+  FnTexture * hud = fn_texture_new_with_options(
+      FN_FONT_WIDTH * FN_NUM_MAXLIFE,
+      FN_TILE_HEIGHT,
+      graphic_options);
+  FnGeometry * srcrect = fn_geometry_new(0, 0,
+      FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH,
+      FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT);
+  FnGeometry * dstrect = fn_geometry_new(FN_TILE_WIDTH, FN_TILE_HEIGHT,
+      FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH,
+      FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT);
+
+  /* the first frame may set up the blit maps of the surfaces */
+  fn_test_alloc_frame(env, level, hud, srcrect, dstrect);
+
+  allocations = fn_test_alloc_count;
+  for (i = 0; i < FN_TEST_ALLOC_FRAMES; i++) {
+    fn_test_alloc_frame(env, level, hud, srcrect, dstrect);
+  }
+  allocations = fn_test_alloc_count - allocations;
+
+  if (allocations != 0) {
+    printf("FAIL: %lu allocations in %d frames of blits.\n",
+        allocations, FN_TEST_ALLOC_FRAMES);
+    return 1;
+  }
+
+  /* the first dialogs create the snapshot buffers and fill the
+   * text cache */
+  fn_test_alloc_dialog(env);
+
+  allocations = fn_test_alloc_count;
+  for (i = 0; i < FN_TEST_ALLOC_DIALOGS; i++) {
+    fn_test_alloc_dialog(env);
+  }
+  allocations = fn_test_alloc_count - allocations;
+
+  if (allocations != 0) {
+    printf("FAIL: %lu allocations in %d nested dialogs.\n",
+        allocations, FN_TEST_ALLOC_DIALOGS);
+    return 1;
+  }
+
+  /* a game frame, with the view centered on the hero */
+  fn_level_t * lv = fn_test_alloc_load_level(env);
+  if (lv == NULL) {
+    return 1;
+  }
+  SDL_Rect view;
+  view.w = fn_geometry_get_width(srcrect);
+  view.h = fn_geometry_get_height(srcrect);
+  fn_level_center_view(lv, &view);
+  fn_geometry_set_x(srcrect, view.x);
+  fn_geometry_set_y(srcrect, view.y);
+
+  for (i = 0; i < FN_TEST_ALLOC_WARMUP; i++) {
+    fn_test_alloc_level_frame(env, lv, level, srcrect, dstrect);
+  }
+
+  allocations = fn_test_alloc_count;
+  for (i = 0; i < FN_TEST_ALLOC_FRAMES; i++) {
+    fn_test_alloc_level_frame(env, lv, level, srcrect, dstrect);
+  }
+  allocations = fn_test_alloc_count - allocations;
+
+  fn_level_free(lv);
+  g_object_unref(dstrect);
+  g_object_unref(srcrect);
+  g_object_unref(hud);
+  g_object_unref(level);
+  fn_environment_delete(env);
+
+  if (allocations != 0) {
+    printf("FAIL: %lu allocations in %d game frames.\n",
+        allocations, FN_TEST_ALLOC_FRAMES);
+    return 1;
+  }
+  printf("PASS: no allocations in %d frames of blits, "
+      "%d nested dialogs and %d game frames.\n",
+      FN_TEST_ALLOC_FRAMES, FN_TEST_ALLOC_DIALOGS,
+      FN_TEST_ALLOC_FRAMES);
+  return 0;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,200 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Test the colour keyed blits against SDL
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_blit.h"
+
+/* --------------------------------------------------------------- */
+
+#define FN_TEST_BLIT_KEY 0x00FF00FF
+
+#define FN_TEST_BLIT_RUNS 500
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_test_blit_seed = 1;
+
+static Uint32 fn_test_blit_random(Uint32 max)
+{
+  fn_test_blit_seed = fn_test_blit_seed * 1103515245 + 12345;
+  return (fn_test_blit_seed >> 8) % max;
+}
+
+/* --------------------------------------------------------------- */
+
+static SDL_Surface * fn_test_blit_surface(int w, int h)
+{
+  return SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, 32,
+      0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Fill a surface with random pixels, including the unused byte.
+ * If keyed, about a third of the pixels are the colour key.
+ */
+static void fn_test_blit_fill(SDL_Surface * s, Uint8 keyed)
+{
+  int x = 0;
+  int y = 0;
+  for (y = 0; y < s->h; y++) {
+    Uint32 * row = (Uint32 *)((Uint8 *)s->pixels + y * s->pitch);
+    for (x = 0; x < s->w; x++) {
+      if (keyed && fn_test_blit_random(3) == 0) {
+        row[x] = FN_TEST_BLIT_KEY;
+      } else {
+        row[x] = (fn_test_blit_random(0x10000) << 16) |
+          fn_test_blit_random(0x10000);
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_test_blit_equal(SDL_Surface * a, SDL_Surface * b)
+{
+  int y = 0;
+  for (y = 0; y < a->h; y++) {
+    if (memcmp((Uint8 *)a->pixels + y * a->pitch,
+          (Uint8 *)b->pixels + y * b->pitch,
+          a->w * 4) != 0)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit a random part of a random source to a random position with
+ * a random clip rectangle, once with SDL and once with
+ * fn_blit_keyed, and compare the targets and the rectangles.
+ */
+static Uint8 fn_test_blit_run(int run)
+{
+  int sw = 1 + fn_test_blit_random(80);
+  int sh = 1 + fn_test_blit_random(40);
+  int dw = 1 + fn_test_blit_random(80);
+  int dh = 1 + fn_test_blit_random(40);
+  SDL_Surface * src = fn_test_blit_surface(sw, sh);
+  SDL_Surface * expected = fn_test_blit_surface(dw, dh);
+  SDL_Surface * actual = fn_test_blit_surface(dw, dh);
+  SDL_Rect srcrect;
+  SDL_Rect clip;
+  SDL_Rect r1;
+  SDL_Rect r2;
+  Uint8 usesrcrect = fn_test_blit_random(2);
+  Uint8 usedstrect = (fn_test_blit_random(4) != 0);
+  Uint8 success = 1;
+
+  fn_test_blit_fill(src, 1);
+  fn_test_blit_fill(expected, 0);
+  SDL_BlitSurface(expected, NULL, actual, NULL);
+  SDL_SetColorKey(src, SDL_SRCCOLORKEY, FN_TEST_BLIT_KEY);
+
+  srcrect.x = fn_test_blit_random(sw + 8) - 4;
+  srcrect.y = fn_test_blit_random(sh + 8) - 4;
+  srcrect.w = fn_test_blit_random(sw + 8);
+  srcrect.h = fn_test_blit_random(sh + 8);
+
+  clip.x = fn_test_blit_random(dw);
+  clip.y = fn_test_blit_random(dh);
+  clip.w = fn_test_blit_random(dw + 1);
+  clip.h = fn_test_blit_random(dh + 1);
+  if (fn_test_blit_random(2)) {
+    SDL_SetClipRect(expected, &clip);
+    SDL_SetClipRect(actual, &clip);
+  }
+
+  r1.x = fn_test_blit_random(dw + sw) - sw;
+  r1.y = fn_test_blit_random(dh + sh) - sh;
+  r1.w = 0;
+  r1.h = 0;
+  r2 = r1;
+
+  SDL_BlitSurface(src, usesrcrect ? &srcrect : NULL,
+      expected, usedstrect ? &r1 : NULL);
+  if (!fn_blit_keyed(src, usesrcrect ? &srcrect : NULL,
+        actual, usedstrect ? &r2 : NULL))
+  {
+    printf("FAIL: run %d was not handled.\n", run);
+    success = 0;
+  } else if (!fn_test_blit_equal(expected, actual)) {
+    printf("FAIL: run %d differs in the pixels.\n", run);
+    success = 0;
+  } else if (memcmp(&r1, &r2, sizeof(SDL_Rect)) != 0) {
+    printf("FAIL: run %d differs in the rectangle.\n", run);
+    success = 0;
+  }
+
+  SDL_FreeSurface(actual);
+  SDL_FreeSurface(expected);
+  SDL_FreeSurface(src);
+  return success;
+}
+
+/* --------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+  int impl = 0;
+  int failed = 0;
+  int run = 0;
+
+  for (impl = 0; impl < FN_BLIT_NUM_IMPLS; impl++) {
+    if (!fn_blit_set_impl(impl)) {
+      printf("SKIP: %s is not available.\n", fn_blit_impl_name(impl));
+      continue;
+    }
+    fn_test_blit_seed = 1;
+    for (run = 0; run < FN_TEST_BLIT_RUNS; run++) {
+      if (!fn_test_blit_run(run)) {
+        printf("FAIL: %s.\n", fn_blit_impl_name(impl));
+        failed++;
+        break;
+      }
+    }
+    if (run == FN_TEST_BLIT_RUNS) {
+      printf("PASS: %s.\n", fn_blit_impl_name(impl));
+    }
+  }
+
+  return (failed == 0) ? 0 : 1;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,210 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Test the blits of classified textures against SDL
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ *
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn.h"
+#include "fntexture.h"
+#include "fngraphicoptions.h"
+
+/* --------------------------------------------------------------- */
+
+#define FN_TEST_CLASSIFY_MAX_SCALE 3
+
+#define FN_TEST_CLASSIFY_BACKGROUND 0x00808080
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create the pixel data of a tile with transparent, black and
+ * coloured pixels. Black maps to the default colour key 0.
+ */
+static void fn_test_classify_data(guchar * data)
+{
+  int x = 0;
+  int y = 0;
+  for (y = 0; y < FN_TILE_HEIGHT; y++) {
+    for (x = 0; x < FN_TILE_WIDTH; x++) {
+      guchar * p = data + (y * FN_TILE_WIDTH + x) * 4;
+      switch ((x + y * 3) % 4) {
+        case 0:
+          /* transparent */
+          p[0] = 0xFF; p[1] = 0x00; p[2] = 0xFF; p[3] = 0;
+          break;
+        case 1:
+          /* opaque black */
+          p[0] = 0x00; p[1] = 0x00; p[2] = 0x00; p[3] = 1;
+          break;
+        default:
+          p[0] = x * 16; p[1] = y * 16; p[2] = 0xAA; p[3] = 1;
+          break;
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Write the pixel data to a keyed surface the same way
+ * fn_texture_set_data does.
+ */
+static void fn_test_classify_fill(SDL_Surface * s, guchar * data,
+    guint scale)
+{
+  int x = 0;
+  int y = 0;
+  SDL_Rect r;
+  r.w = scale;
+  r.h = scale;
+  for (y = 0; y < FN_TILE_HEIGHT; y++) {
+    for (x = 0; x < FN_TILE_WIDTH; x++) {
+      guchar * p = data + (y * FN_TILE_WIDTH + x) * 4;
+      r.x = x * scale;
+      r.y = y * scale;
+      SDL_FillRect(s, &r, (p[3] == 0) ? 0 :
+          SDL_MapRGB(s->format, p[0], p[1], p[2]));
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_test_classify_equal(SDL_Surface * a, SDL_Surface * b)
+{
+  int y = 0;
+  for (y = 0; y < a->h; y++) {
+    if (memcmp((Uint8 *)a->pixels + y * a->pitch,
+          (Uint8 *)b->pixels + y * b->pitch,
+          a->w * a->format->BytesPerPixel) != 0)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit a tile which contains black pixels at a few positions, some
+ * of them clipped, once as a classified texture and once with SDL
+ * from a surface with the same pixels, and compare the targets.
+ */
+static Uint8 fn_test_classify_run(guint scale, guchar * data)
+{
+  FnGraphicOptions * options = g_object_new(FN_TYPE_GRAPHIC_OPTIONS,
+      "bpp", 32,
+      "scale", scale,
+      NULL);
+  FnTexture * texture = fn_texture_new_with_options(
+      FN_TILE_WIDTH, FN_TILE_HEIGHT, options);
+  int w = FN_TILE_WIDTH * scale;
+  int h = FN_TILE_HEIGHT * scale;
+  SDL_Surface * src = SDL_CreateRGBSurface(SDL_SWSURFACE,
+      w, h, 32, 0, 0, 0, 0);
+  SDL_Surface * expected = SDL_CreateRGBSurface(SDL_SWSURFACE,
+      w * 2, h * 2, 32, 0, 0, 0, 0);
+  SDL_Surface * actual = SDL_CreateRGBSurface(SDL_SWSURFACE,
+      w * 2, h * 2, 32, 0, 0, 0, 0);
+  SDL_Rect positions[] = {
+    { 0, 0, 0, 0 },
+    { w / 2, h / 3, 0, 0 },
+    { -w / 3, h + h / 2, 0, 0 },
+    { w + w / 2, -h / 4, 0, 0 }
+  };
+  SDL_Rect r1;
+  SDL_Rect r2;
+  Uint8 success = 1;
+  size_t i = 0;
+
+  fn_texture_set_data(texture, data);
+  if (fn_texture_get_opacity(texture) != FN_TEXTURE_OPACITY_MIXED) {
+    printf("FAIL: scale %u is not classified as mixed.\n", scale);
+    success = 0;
+  }
+
+  SDL_SetColorKey(src, SDL_SRCCOLORKEY, 0);
+  fn_test_classify_fill(src, data, scale);
+
+  SDL_FillRect(expected, NULL, FN_TEST_CLASSIFY_BACKGROUND);
+  SDL_FillRect(actual, NULL, FN_TEST_CLASSIFY_BACKGROUND);
+
+  for (i = 0; i < sizeof(positions) / sizeof(SDL_Rect); i++) {
+    r1 = positions[i];
+    r2 = positions[i];
+    SDL_BlitSurface(src, NULL, expected, &r1);
+    fn_texture_blit_to_sdl_surface(texture, NULL, actual, &r2);
+    if (memcmp(&r1, &r2, sizeof(SDL_Rect)) != 0) {
+      printf("FAIL: scale %u differs in rectangle %u.\n",
+          scale, (unsigned)i);
+      success = 0;
+    }
+  }
+  if (!fn_test_classify_equal(expected, actual)) {
+    printf("FAIL: scale %u differs in the pixels.\n", scale);
+    success = 0;
+  }
+
+  SDL_FreeSurface(actual);
+  SDL_FreeSurface(expected);
+  SDL_FreeSurface(src);
+  g_object_unref(texture);
+  g_object_unref(options);
+  return success;
+}
+
+/* --------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+  guchar data[FN_TILE_WIDTH * FN_TILE_HEIGHT * 4];
+  guint scale = 0;
+  int failed = 0;
+
+  g_type_init();
+  fn_texture_set_fast_blits(TRUE);
+  fn_test_classify_data(data);
+
+  for (scale = 1; scale <= FN_TEST_CLASSIFY_MAX_SCALE; scale++) {
+    if (fn_test_classify_run(scale, data)) {
+      printf("PASS: scale %u.\n", scale);
+    } else {
+      failed++;
+    }
+  }
+
+  return (failed == 0) ? 0 : 1;
+}
+
+/* --------------------------------------------------------------- */
@@ -0,0 +1,169 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Test rendering a level frame in bands against one thread
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ *
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn.h"
+#include "fn_level.h"
+#include "fn_hero.h"
+#include "fn_drawlist.h"
+#include "fn_error.h"
+#include "fn_error_cmdline.h"
+
+/* --------------------------------------------------------------- */
+
+#define FN_TEST_DRAWLIST_FRAMES 50
+
+#define FN_TEST_DRAWLIST_THREADS 4
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Load the first level of the episode.
+ */
+static fn_level_t * fn_test_drawlist_load_level(fn_environment_t * env)
+{
+  char path[1024];
+  fn_level_t * lv = NULL;
+
+  snprintf(path, sizeof(path), "%s/WORLDAL1.DN%d",
+      fn_environment_get_datapath(env),
+      fn_environment_get_episode(env));
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    fprintf(stderr, "Could not open file %s\n", path);
+    return NULL;
+  }
+  lv = fn_level_load(fd, env);
+  close(fd);
+  return lv;
+}
+
+/* --------------------------------------------------------------- */
+
+static Uint8 fn_test_drawlist_equal(SDL_Surface * a, SDL_Surface * b)
+{
+  int y = 0;
+  for (y = 0; y < a->h; y++) {
+    if (memcmp((Uint8 *)a->pixels + y * a->pitch,
+          (Uint8 *)b->pixels + y * b->pitch,
+          a->w * a->format->BytesPerPixel) != 0)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* --------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+  int i = 0;
+  int failed = 0;
+
+  fn_error_set_handler(fn_error_print_commandline);
+  setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+  fn_environment_t * env = fn_environment_create();
+  if (!fn_environment_check_for_episodes(env) ||
+      !fn_environment_load_tilecache(env))
+  {
+    fprintf(stderr, "Could not load the game data.\n");
+    return 1;
+  }
+
+  fn_drawlist_set_threads(FN_TEST_DRAWLIST_THREADS);
+  if (fn_drawlist_get_threads() < 2) {
+    printf("SKIP: no threads to render in bands.\n");
+    fn_environment_delete(env);
+    return 0;
+  }
+
+  fn_level_t * lv = fn_test_drawlist_load_level(env);
+  if (lv == NULL) {
+    return 1;
+  }
+  fn_level_set_seed(lv, 1);
+
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+  SDL_Rect view;
+  view.w = FN_LEVELWINDOW_WIDTH * FN_TILE_WIDTH;
+  view.h = FN_LEVELWINDOW_HEIGHT * FN_TILE_HEIGHT;
+
+  SDL_Surface * expected = SDL_CreateRGBSurface(SDL_SWSURFACE,
+      view.w * pixelsize, view.h * pixelsize, 32, 0, 0, 0, 0);
+  SDL_Surface * actual = SDL_CreateRGBSurface(SDL_SWSURFACE,
+      view.w * pixelsize, view.h * pixelsize, 32, 0, 0, 0, 0);
+
+  for (i = 0; i < FN_TEST_DRAWLIST_FRAMES && failed == 0; i++) {
+    SDL_Rect srcrect;
+
+    fn_level_center_view(lv, &view);
+    fn_level_update_visibility(lv, &view);
+    fn_level_act(lv);
+    fn_hero_take_events(fn_level_get_hero(lv));
+
+    srcrect.x = view.x * pixelsize;
+    srcrect.y = view.y * pixelsize;
+    srcrect.w = view.w * pixelsize;
+    srcrect.h = view.h * pixelsize;
+
+    /* the same frame, once in bands and once in one thread */
+    fn_drawlist_set_threads(FN_TEST_DRAWLIST_THREADS);
+    fn_level_blit_to_surface(lv, actual, NULL, &srcrect, NULL, NULL);
+    fn_drawlist_set_threads(1);
+    fn_level_blit_to_surface(lv, expected, NULL, &srcrect, NULL, NULL);
+
+    if (!fn_test_drawlist_equal(expected, actual)) {
+      printf("FAIL: frame %d differs with %d threads.\n",
+          i, FN_TEST_DRAWLIST_THREADS);
+      failed++;
+    }
+  }
+
+  SDL_FreeSurface(actual);
+  SDL_FreeSurface(expected);
+  fn_level_free(lv);
+  fn_environment_delete(env);
+
+  if (failed == 0) {
+    printf("PASS: %d frames are the same with %d threads.\n",
+        FN_TEST_DRAWLIST_FRAMES, FN_TEST_DRAWLIST_THREADS);
+  }
+  return (failed == 0) ? 0 : 1;
+}
+
+/* --------------------------------------------------------------- */
@@ -68,6 +68,18 @@ int main(int argc, char ** argv)
 
   printlist(list);
 
+  list = fn_list_insert_after(list, NULL, (void *)4);
+  list = fn_list_insert_after(list, NULL, (void *)4);
+
+  printlist(list);
+
+  list = fn_list_remove_all(list, (void *)4);
+  list = fn_list_insert_after(list, fn_list_first(list), (void *)5);
+
+  printlist(list);
+
+  fn_list_free(list);
+
   return 0;
 }
 
@@ -34,12 +34,13 @@
 #include "fn_tilecache.h"
 #include "fn_object.h"
 #include "fntexture.h"
+#include "fn_textcache.h"
 
 /* --------------------------------------------------------------- */
 
-void fn_text_printletter(
+void fn_text_printletter_rect(
     FnTexture * target,
-    FnGeometry * r,
+    const FnRect * r,
     fn_environment_t * env,
     char c)
 {
@@ -49,7 +50,7 @@ void fn_text_printletter(
     tilenr = c - ' ' + FONT_ASCII_UPPERCASE;
   else
     tilenr = c - 'a' + FONT_ASCII_LOWERCASE;
-  fn_texture_clone_to_texture(
+  fn_texture_clone_rect(
       fn_environment_get_tile(env, tilenr),
       NULL,
       target,
@@ -58,45 +59,162 @@ void fn_text_printletter(
 
 /* --------------------------------------------------------------- */
 
-void fn_text_print(
+void fn_text_printletter(
     FnTexture * target,
     FnGeometry * r,
     fn_environment_t * env,
-    char * text)
+    char c)
 {
-  FnGeometry * dstrect;
+  FnRect dstrect = { 0, 0, 0, 0 };
+
+  if (r != NULL) {
+    fn_geometry_get_rect(r, &dstrect);
+  }
+  fn_text_printletter_rect(target, &dstrect, env, c);
+}
+
+/* --------------------------------------------------------------- */
 
-  char * walker;
-  char * end;
+void fn_text_print_rect(
+    FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env,
+    const char * text)
+{
+  FnRect dstrect = { 0, 0, 0, 0 };
+  const char * walker;
 
   if (r != NULL) {
-    dstrect = fn_geometry_clone(r);
-  } else {
-    dstrect = fn_geometry_new(0, 0, 0, 0);
+    dstrect = *r;
   }
+  gint x = dstrect.x;
   Uint8 pixelsize = fn_environment_get_pixelsize(env);
 
-  fn_geometry_set_width(dstrect, pixelsize * FN_FONT_WIDTH);
-  fn_geometry_set_height(dstrect, pixelsize * FN_FONT_HEIGHT);
-
-  end = text + strlen(text);
+  dstrect.width = pixelsize * FN_FONT_WIDTH;
+  dstrect.height = pixelsize * FN_FONT_HEIGHT;
 
-  for (walker = text; walker < end; walker++) {
+  for (walker = text; *walker != '\0'; walker++) {
     if (*walker == '\n') {
-      fn_geometry_set_x(dstrect, fn_geometry_get_x(r));
-      gint y = fn_geometry_get_y(dstrect);
-      fn_geometry_set_y(dstrect, y + pixelsize * FN_FONT_HEIGHT);
+      dstrect.x = x;
+      dstrect.y += pixelsize * FN_FONT_HEIGHT;
     } else {
-      fn_text_printletter(
+      fn_text_printletter_rect(
           target,
-          dstrect,
+          &dstrect,
           env,
           *walker);
-      gint x = fn_geometry_get_x(dstrect);
-      fn_geometry_set_x(dstrect, x + pixelsize * FN_FONT_WIDTH);
+      dstrect.x += pixelsize * FN_FONT_WIDTH;
     }
   }
-  g_object_unref(dstrect);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_text_print(
+    FnTexture * target,
+    FnGeometry * r,
+    fn_environment_t * env,
+    char * text)
+{
+  FnRect dstrect = { 0, 0, 0, 0 };
+
+  if (r != NULL) {
+    fn_geometry_get_rect(r, &dstrect);
+  }
+  fn_text_print_rect(target, &dstrect, env, text);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Count the columns and rows a text takes.
+ *
+ * @param  text     The text.
+ * @param  columns  Returns the length of the longest line.
+ * @param  rows     Returns the number of lines.
+ */
+static void fn_text_get_size(
+    const char * text,
+    guint * columns,
+    guint * rows)
+{
+  const char * walker;
+  guint column = 0;
+
+  *columns = 0;
+  *rows = (*text != '\0') ? 1 : 0;
+  for (walker = text; *walker != '\0'; walker++) {
+    if (*walker == '\n') {
+      column = 0;
+      (*rows)++;
+    } else {
+      column++;
+      if (column > *columns) {
+        *columns = column;
+      }
+    }
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_text_print_cached(
+    FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env,
+    const char * text)
+{
+  FnRect dstrect = { 0, 0, 0, 0 };
+  fn_textcache_t * tc = fn_environment_get_textcache(env);
+  Uint8 pixelsize = fn_environment_get_pixelsize(env);
+  guint columns = 0;
+  guint rows = 0;
+
+  FnTexture * rendered = fn_textcache_lookup(tc,
+      FN_TEXTCACHE_TEXT, text, pixelsize);
+
+  if (rendered == NULL) {
+    fn_text_get_size(text, &columns, &rows);
+    if (columns == 0) {
+      return;
+    }
+    rendered = fn_texture_new_with_options(
+        FN_FONT_WIDTH * columns,
+        FN_FONT_HEIGHT * rows,
+        fn_environment_get_graphic_options(env));
+    fn_texture_set_category(rendered, FN_TEXTURE_CATEGORY_UI);
+    fn_text_print_rect(rendered, NULL, env, text);
+    fn_textcache_insert(tc, FN_TEXTCACHE_TEXT, text, pixelsize, rendered);
+    g_object_unref(rendered);
+  }
+
+  if (r != NULL) {
+    dstrect = *r;
+  }
+  fn_texture_clone_rect(rendered, NULL, target, &dstrect);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_text_print_number(
+    FnScreen * screen,
+    const FnRect * r,
+    fn_environment_t * env,
+    Uint64 number,
+    Uint8 digits)
+{
+  FnRect dstrect = { 0, r->y, FN_FONT_WIDTH, FN_FONT_HEIGHT };
+  int i = 0;
+
+  /* from the lowest digit to the highest */
+  for (i = digits - 1; i >= 0; i--) {
+    dstrect.x = r->x + i * FN_FONT_WIDTH;
+    fn_screen_clone_texture_rect(screen, &dstrect,
+        fn_environment_get_tile(env,
+          FONT_ASCII_UPPERCASE + '0' - ' ' + (number % 10)),
+        NULL);
+    number /= 10;
+  }
 }
 
 /* --------------------------------------------------------------- */
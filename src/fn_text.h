@@ -39,6 +39,23 @@
 #include "fn_environment.h"
 #include "fntexture.h"
 #include "fngeometry.h"
+#include "fnscreen.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Print a letter.
+ *
+ * @param  target  The texture to print to.
+ * @param  r       The position of the letter.
+ * @param  env     The environment holding the font.
+ * @param  c       The letter.
+ */
+void fn_text_printletter_rect(
+    FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env,
+    char c);
 
 /* --------------------------------------------------------------- */
 
@@ -50,6 +67,24 @@ void fn_text_printletter(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Print a text. A newline continues at the horizontal position
+ * the text started at.
+ *
+ * @param  target  The texture to print to.
+ * @param  r       The position of the text, or NULL for the upper
+ *                 left corner.
+ * @param  env     The environment holding the font.
+ * @param  text    The text.
+ */
+void fn_text_print_rect(
+    FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env,
+    const char * text);
+
+/* --------------------------------------------------------------- */
+
 void fn_text_print(
     FnTexture * target,
     FnGeometry * r,
@@ -58,4 +93,45 @@ void fn_text_print(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Print a text like fn_text_print_rect, but through the text cache
+ * of the environment. The first time a text is printed it is
+ * rendered into a texture of its own, which is blitted in one go
+ * when the same text is printed again. Use this for texts which
+ * are printed over and over.
+ *
+ * @param  target  The texture to print to.
+ * @param  r       The position of the text, or NULL for the upper
+ *                 left corner.
+ * @param  env     The environment holding the font.
+ * @param  text    The text.
+ */
+void fn_text_print_cached(
+    FnTexture * target,
+    const FnRect * r,
+    fn_environment_t * env,
+    const char * text);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Print a number with leading zeroes directly onto the screen,
+ * without formatting it into a text first.
+ *
+ * @param  screen  The screen to print to.
+ * @param  r       The position of the first digit.
+ * @param  env     The environment holding the font.
+ * @param  number  The number.
+ * @param  digits  The number of digits to print. If the number has
+ *                 more digits, only the lowest ones are printed.
+ */
+void fn_text_print_number(
+    FnScreen * screen,
+    const FnRect * r,
+    fn_environment_t * env,
+    Uint64 number,
+    Uint8 digits);
+
+/* --------------------------------------------------------------- */
+
 #endif /* FN_TEXT_H */
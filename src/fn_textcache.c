@@ -0,0 +1,288 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Cache of rendered texts and message boxes
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fn_textcache.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A cached texture.
+ */
+typedef struct fn_textcache_entry_t {
+  /**
+   * The text, or NULL if the entry is unused.
+   */
+  char * text;
+
+  /**
+   * The hash of the text, compared before the text itself.
+   */
+  Uint32 hash;
+
+  /**
+   * The kind of the texture and the pixelsize it was rendered with.
+   */
+  Uint8 kind;
+  Uint8 pixelsize;
+
+  /**
+   * The value of the use counter when the entry was last used.
+   */
+  Uint32 used;
+
+  /**
+   * The pixel memory of the texture.
+   */
+  size_t bytes;
+
+  /**
+   * The texture.
+   */
+  FnTexture * texture;
+} fn_textcache_entry_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The number of entries in the cache. The pictures take the last
+ * FN_TEXTCACHE_PICTURES of them.
+ */
+#define FN_TEXTCACHE_ENTRIES (FN_TEXTCACHE_SIZE + FN_TEXTCACHE_PICTURES)
+
+/* --------------------------------------------------------------- */
+
+struct fn_textcache_t {
+  fn_textcache_entry_t entries[FN_TEXTCACHE_ENTRIES];
+
+  /**
+   * The pixel memory of all cached textures, and how much they may
+   * use together, or 0 for no limit.
+   */
+  size_t bytes;
+  size_t maxbytes;
+
+  /**
+   * Counts the lookups and insertions.
+   */
+  Uint32 uses;
+};
+
+/* --------------------------------------------------------------- */
+
+static Uint32 fn_textcache_hash(const char * text)
+{
+  /* FNV-1a */
+  Uint32 hash = 2166136261u;
+  const char * walker = text;
+  while (*walker != '\0') {
+    hash ^= (Uint8)*walker;
+    hash *= 16777619u;
+    walker++;
+  }
+  return hash;
+}
+
+/* --------------------------------------------------------------- */
+
+static void fn_textcache_drop(fn_textcache_t * tc,
+    fn_textcache_entry_t * entry)
+{
+  if (entry->text != NULL) {
+    free(entry->text); entry->text = NULL;
+    g_object_unref(entry->texture); entry->texture = NULL;
+    tc->bytes -= entry->bytes;
+    entry->bytes = 0;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Find the first entry and the number of entries a kind of
+ * texture is kept in.
+ */
+static void fn_textcache_range(fn_textcache_kind_e kind,
+    size_t * first,
+    size_t * count)
+{
+  if (kind == FN_TEXTCACHE_PICTURE) {
+    *first = FN_TEXTCACHE_SIZE;
+    *count = FN_TEXTCACHE_PICTURES;
+  } else {
+    *first = 0;
+    *count = FN_TEXTCACHE_SIZE;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Find the least recently used entry that holds a texture among
+ * some entries.
+ */
+static fn_textcache_entry_t * fn_textcache_oldest(fn_textcache_t * tc,
+    size_t first,
+    size_t count)
+{
+  fn_textcache_entry_t * oldest = NULL;
+  size_t i = 0;
+
+  for (i = first; i < first + count; i++) {
+    fn_textcache_entry_t * entry = &(tc->entries[i]);
+    if (entry->text != NULL &&
+        (oldest == NULL ||
+         tc->uses - entry->used > tc->uses - oldest->used))
+    {
+      oldest = entry;
+    }
+  }
+  return oldest;
+}
+
+/* --------------------------------------------------------------- */
+
+fn_textcache_t * fn_textcache_create(size_t maxbytes)
+{
+  fn_textcache_t * tc = malloc(sizeof(fn_textcache_t));
+  memset(tc, 0, sizeof(fn_textcache_t));
+  tc->maxbytes = maxbytes;
+  return tc;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_textcache_free(fn_textcache_t * tc)
+{
+  fn_textcache_clear(tc);
+  free(tc);
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_textcache_clear(fn_textcache_t * tc)
+{
+  size_t i = 0;
+  for (i = 0; i < FN_TEXTCACHE_ENTRIES; i++) {
+    fn_textcache_drop(tc, &(tc->entries[i]));
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+FnTexture * fn_textcache_lookup(fn_textcache_t * tc,
+    fn_textcache_kind_e kind,
+    const char * text,
+    Uint8 pixelsize)
+{
+  Uint32 hash = fn_textcache_hash(text);
+  size_t first = 0;
+  size_t count = 0;
+  size_t i = 0;
+
+  fn_textcache_range(kind, &first, &count);
+  for (i = first; i < first + count; i++) {
+    fn_textcache_entry_t * entry = &(tc->entries[i]);
+    if (entry->text != NULL &&
+        entry->hash == hash &&
+        entry->kind == kind &&
+        entry->pixelsize == pixelsize &&
+        strcmp(entry->text, text) == 0)
+    {
+      tc->uses++;
+      entry->used = tc->uses;
+      return entry->texture;
+    }
+  }
+  return NULL;
+}
+
+/* --------------------------------------------------------------- */
+
+void fn_textcache_insert(fn_textcache_t * tc,
+    fn_textcache_kind_e kind,
+    const char * text,
+    Uint8 pixelsize,
+    FnTexture * texture)
+{
+  fn_textcache_entry_t * entry = NULL;
+  size_t bytes = fn_texture_get_memory(texture);
+  size_t first = 0;
+  size_t count = 0;
+  size_t i = 0;
+
+  if (tc->maxbytes != 0 && bytes > tc->maxbytes) {
+    return;
+  }
+
+  char * copy = strdup(text);
+  if (copy == NULL) {
+    return;
+  }
+
+  /* make room for the texture, from the textures of its own kind
+   * first */
+  fn_textcache_range(kind, &first, &count);
+  while (tc->maxbytes != 0 && tc->bytes + bytes > tc->maxbytes) {
+    entry = fn_textcache_oldest(tc, first, count);
+    if (entry == NULL) {
+      entry = fn_textcache_oldest(tc, 0, FN_TEXTCACHE_ENTRIES);
+    }
+    fn_textcache_drop(tc, entry);
+  }
+
+  /* an unused entry, or else the least recently used one */
+  entry = NULL;
+  for (i = first; i < first + count; i++) {
+    if (tc->entries[i].text == NULL) {
+      entry = &(tc->entries[i]);
+      break;
+    }
+  }
+  if (entry == NULL) {
+    entry = fn_textcache_oldest(tc, first, count);
+    fn_textcache_drop(tc, entry);
+  }
+
+  tc->uses++;
+  tc->bytes += bytes;
+  entry->text = copy;
+  entry->hash = fn_textcache_hash(text);
+  entry->kind = kind;
+  entry->pixelsize = pixelsize;
+  entry->used = tc->uses;
+  entry->bytes = bytes;
+  entry->texture = texture;
+  g_object_ref(texture);
+}
+
+/* --------------------------------------------------------------- */
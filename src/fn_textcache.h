@@ -0,0 +1,164 @@
+/*******************************************************************
+ *
+ * Project: FreeNukum 2D Jump'n Run
+ * File:    Cache of rendered texts and message boxes
+ *
+ * *****************************************************************
+ *
+ * Copyright 2009 Wolfgang Silbermayr
+ *
+ * *****************************************************************
+ *
+ * This file is part of Freenukum.
+ * 
+ * Freenukum is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Freenukum is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *******************************************************************/
+
+#ifndef FN_TEXTCACHE_H
+#define FN_TEXTCACHE_H
+
+/* --------------------------------------------------------------- */
+
+#include <SDL.h>
+
+/* --------------------------------------------------------------- */
+
+#include "fntexture.h"
+
+/* --------------------------------------------------------------- */
+
+/**
+ * The number of texts and message boxes kept in the cache. When
+ * they fill it, the least recently used one is dropped.
+ */
+#define FN_TEXTCACHE_SIZE 32
+
+/**
+ * The number of pictures kept in the cache apart from the texts,
+ * so that many texts do not push the pictures out.
+ */
+#define FN_TEXTCACHE_PICTURES 16
+
+/**
+ * The pixel memory the textures in the cache of the environment
+ * may use together, which is mostly taken by the pictures.
+ */
+#define FN_TEXTCACHE_BYTES (8 * 1024 * 1024)
+
+/* --------------------------------------------------------------- */
+
+/**
+ * What a cached texture shows.
+ */
+typedef enum fn_textcache_kind_e {
+  /**
+   * A text as printed by fn_text_print_rect.
+   */
+  FN_TEXTCACHE_TEXT,
+
+  /**
+   * A message box as created by fn_msgbox.
+   */
+  FN_TEXTCACHE_MSGBOX,
+
+  /**
+   * A picture as loaded by fn_picture_load. The text is its file
+   * name without the data path, which contains the episode number,
+   * so the pictures of each episode are kept separately.
+   */
+  FN_TEXTCACHE_PICTURE
+} fn_textcache_kind_e;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * A cache of textures, keyed by the text they show, what kind of
+ * texture it is, and the pixelsize it was rendered with.
+ */
+typedef struct fn_textcache_t fn_textcache_t;
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create an empty text cache. When a new texture would exceed the
+ * pixel memory the textures may use together, the least recently
+ * used ones are dropped.
+ *
+ * @param  maxbytes  The pixel memory the textures may use
+ *                   together, or 0 for no limit.
+ *
+ * @return The text cache.
+ */
+fn_textcache_t * fn_textcache_create(size_t maxbytes);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Free a text cache and drop the textures in it.
+ *
+ * @param  tc  The text cache.
+ */
+void fn_textcache_free(fn_textcache_t * tc);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Drop all textures from the cache, for example because the font
+ * or the graphic options they were rendered with changed.
+ *
+ * @param  tc  The text cache.
+ */
+void fn_textcache_clear(fn_textcache_t * tc);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Look up a texture.
+ *
+ * @param  tc         The text cache.
+ * @param  kind       The kind of the texture.
+ * @param  text       The text the texture shows.
+ * @param  pixelsize  The pixelsize it was rendered with.
+ *
+ * @return The texture, owned by the cache, or NULL if it is not
+ *         in the cache. It must not be drawn to.
+ */
+FnTexture * fn_textcache_lookup(fn_textcache_t * tc,
+    fn_textcache_kind_e kind,
+    const char * text,
+    Uint8 pixelsize);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Put a texture into the cache. The cache takes its own reference
+ * on the texture. A texture larger than the pixel memory of the
+ * whole cache is not cached.
+ *
+ * @param  tc         The text cache.
+ * @param  kind       The kind of the texture.
+ * @param  text       The text the texture shows.
+ * @param  pixelsize  The pixelsize it was rendered with.
+ * @param  texture    The texture.
+ */
+void fn_textcache_insert(fn_textcache_t * tc,
+    fn_textcache_kind_e kind,
+    const char * text,
+    Uint8 pixelsize,
+    FnTexture * texture);
+
+/* --------------------------------------------------------------- */
+
+#endif /* FN_TEXTCACHE_H */
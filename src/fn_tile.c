@@ -59,6 +59,7 @@ FnTexture * fn_tile_load(
       width,
       height,
       graphic_options);
+  fn_texture_set_category(tile, FN_TEXTURE_CATEGORY_TILE);
 
   guchar * data = g_new(guchar, width * height * 4);
 
@@ -427,3 +427,25 @@ fn_geometry_clone(FnGeometry * geometry)
 }
 
 /* =============================================================== */
+
+void
+fn_geometry_get_rect(FnGeometry * geometry, FnRect * rect)
+{
+  g_return_if_fail(FN_IS_GEOMETRY(geometry));
+  FnGeometryPrivate * priv = geometry->priv;
+  rect->x = priv->x;
+  rect->y = priv->y;
+  rect->width = priv->width;
+  rect->height = priv->height;
+}
+
+/* --------------------------------------------------------------- */
+
+void
+fn_geometry_set_rect(FnGeometry * geometry, const FnRect * rect)
+{
+  fn_geometry_set_data(geometry,
+      rect->x, rect->y, rect->width, rect->height);
+}
+
+/* =============================================================== */
@@ -39,6 +39,20 @@ G_BEGIN_DECLS
 
 /* =============================================================== */
 
+/**
+ * A plain rectangle which is passed by value or lives on the
+ * stack. The blit and text functions use it on their hot paths,
+ * FnGeometry is only a reference counted wrapper around it.
+ */
+typedef struct _FnRect {
+  gint x;
+  gint y;
+  guint width;
+  guint height;
+} FnRect;
+
+/* =============================================================== */
+
 typedef struct _FnGeometryPrivate FnGeometryPrivate;
 
 /* =============================================================== */
@@ -158,6 +172,28 @@ fn_geometry_clone(FnGeometry * geometry);
 
 /* =============================================================== */
 
+/**
+ * Copy the data of a geometry into a rectangle.
+ *
+ * @param  geometry  The geometry.
+ * @param  rect      The rectangle to fill.
+ */
+void
+fn_geometry_get_rect(FnGeometry * geometry, FnRect * rect);
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Set the data of a geometry from a rectangle.
+ *
+ * @param  geometry  The geometry.
+ * @param  rect      The rectangle to copy.
+ */
+void
+fn_geometry_set_rect(FnGeometry * geometry, const FnRect * rect);
+
+/* =============================================================== */
+
 G_END_DECLS
 
 /* =============================================================== */
@@ -40,6 +40,7 @@ struct _FnGraphicOptionsPrivate
   guint scale;
   guint sdl_flags;
   guint transparent;
+  gboolean indexed;
 };
 
 /* =============================================================== */
@@ -48,7 +49,8 @@ enum {
   PROP_BPP = 1,
   PROP_SCALE,
   PROP_SDL_FLAGS,
-  PROP_TRANSPARENT
+  PROP_TRANSPARENT,
+  PROP_INDEXED
 };
 
 /* =============================================================== */
@@ -58,6 +60,7 @@ enum {
 #define FN_GRAPHIC_OPTIONS_DEFAULT_SDL_FLAGS \
   (SDL_HWSURFACE | SDL_HWACCEL | SDL_ANYFORMAT)
 #define FN_GRAPHIC_OPTIONS_DEFAULT_TRANSPARENT 0
+#define FN_GRAPHIC_OPTIONS_DEFAULT_INDEXED FALSE
 
 /* =============================================================== */
 
@@ -124,6 +127,7 @@ fn_graphic_options_class_init(FnGraphicOptionsClass * c)
   GParamSpec * scale_param;
   GParamSpec * sdl_flags_param;
   GParamSpec * transparent_param;
+  GParamSpec * indexed_param;
   
   g_object_class = G_OBJECT_CLASS(c);
 
@@ -196,6 +200,19 @@ fn_graphic_options_class_init(FnGraphicOptionsClass * c)
       g_object_class,
       PROP_TRANSPARENT,
       transparent_param);
+
+  indexed_param = g_param_spec_boolean(
+      "indexed",
+      "Indexed",
+      "Create 8 bit textures with the EGA palette",
+      FN_GRAPHIC_OPTIONS_DEFAULT_INDEXED,
+      G_PARAM_STATIC_STRINGS |
+      G_PARAM_READWRITE
+      );
+  g_object_class_install_property(
+      g_object_class,
+      PROP_INDEXED,
+      indexed_param);
 }
 
 /* =============================================================== */
@@ -224,8 +241,24 @@ fn_graphic_options_set_property(
 {
   FnGraphicOptions * options;
   options = FN_GRAPHIC_OPTIONS(object);
+  FnGraphicOptionsPrivate * priv = options->priv;
 
   switch(prop_id) {
+    case PROP_BPP:
+      priv->bpp = g_value_get_uint(value);
+      break;
+    case PROP_SCALE:
+      priv->scale = g_value_get_uint(value);
+      break;
+    case PROP_SDL_FLAGS:
+      priv->sdl_flags = g_value_get_uint(value);
+      break;
+    case PROP_TRANSPARENT:
+      priv->transparent = g_value_get_uint(value);
+      break;
+    case PROP_INDEXED:
+      priv->indexed = g_value_get_boolean(value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
   }
@@ -242,8 +275,24 @@ fn_graphic_options_get_property(
 {
   FnGraphicOptions * options;
   options = FN_GRAPHIC_OPTIONS(object);
+  FnGraphicOptionsPrivate * priv = options->priv;
 
   switch(prop_id) {
+    case PROP_BPP:
+      g_value_set_uint(value, priv->bpp);
+      break;
+    case PROP_SCALE:
+      g_value_set_uint(value, priv->scale);
+      break;
+    case PROP_SDL_FLAGS:
+      g_value_set_uint(value, priv->sdl_flags);
+      break;
+    case PROP_TRANSPARENT:
+      g_value_set_uint(value, priv->transparent);
+      break;
+    case PROP_INDEXED:
+      g_value_set_boolean(value, priv->indexed);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
   }
@@ -287,3 +336,55 @@ fn_graphic_options_finalize(GObject * gobject)
 
 /* =============================================================== */
 
+FnGraphicOptions *
+fn_graphic_options_new_with_defaults()
+{
+  return g_object_new(FN_TYPE_GRAPHIC_OPTIONS, NULL);
+}
+
+/* =============================================================== */
+
+guint
+fn_graphic_options_get_scale(FnGraphicOptions * options)
+{
+  g_return_val_if_fail(FN_IS_GRAPHIC_OPTIONS(options), 1);
+  return options->priv->scale;
+}
+
+/* =============================================================== */
+
+guint
+fn_graphic_options_get_sdl_flags(FnGraphicOptions * options)
+{
+  g_return_val_if_fail(FN_IS_GRAPHIC_OPTIONS(options), 0);
+  return options->priv->sdl_flags;
+}
+
+/* =============================================================== */
+
+guint
+fn_graphic_options_get_bpp(FnGraphicOptions * options)
+{
+  g_return_val_if_fail(FN_IS_GRAPHIC_OPTIONS(options), 0);
+  return options->priv->bpp;
+}
+
+/* =============================================================== */
+
+guint
+fn_graphic_options_get_transparent(FnGraphicOptions * options)
+{
+  g_return_val_if_fail(FN_IS_GRAPHIC_OPTIONS(options), 0);
+  return options->priv->transparent;
+}
+
+/* =============================================================== */
+
+gboolean
+fn_graphic_options_get_indexed(FnGraphicOptions * options)
+{
+  g_return_val_if_fail(FN_IS_GRAPHIC_OPTIONS(options), FALSE);
+  return options->priv->indexed;
+}
+
+/* =============================================================== */
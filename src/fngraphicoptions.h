@@ -105,6 +105,20 @@ fn_graphic_options_get_transparent(FnGraphicOptions * options);
 
 /* =============================================================== */
 
+/**
+ * Check if textures are created with 8 bits per pixel. Their
+ * pixels are indices into the shared EGA palette, and the index
+ * FN_TEXTURE_INDEX_TRANSPARENT is the colour key.
+ *
+ * @param  options  The graphic options.
+ *
+ * @return TRUE if textures are indexed.
+ */
+gboolean
+fn_graphic_options_get_indexed(FnGraphicOptions * options);
+
+/* =============================================================== */
+
 G_END_DECLS
 
 /* =============================================================== */
@@ -26,6 +26,7 @@
  *
  *******************************************************************/
 
+#include <stdlib.h>
 #include <SDL.h>
 
 /* =============================================================== */
@@ -236,8 +237,24 @@ fn_graphics_get_screen(FnGraphics * graphics)
   FnGraphicsPrivate * priv = graphics->priv;
 
   if (priv->screen == NULL) {
-    priv->screen =
-      fn_screen_new_with_defaults();
+    /* FREENUKUM_NATIVE=SCALE composes at 320x200 and scales the
+     * frame once when it is shown, FREENUKUM_SCALE_FILTER selects
+     * the filter for that. */
+    char * native = getenv("FREENUKUM_NATIVE");
+    char * filtername = getenv("FREENUKUM_SCALE_FILTER");
+    if (native != NULL && atoi(native) > 0) {
+      fn_scale_filter_e filter = FN_SCALE_FILTER_NEAREST;
+      if (filtername != NULL &&
+          !fn_scale_filter_from_name(filtername, &filter))
+      {
+        g_printerr("Unknown scale filter %s.\n", filtername);
+      }
+      priv->screen =
+        fn_screen_new_native(atoi(native), filter);
+    } else {
+      priv->screen =
+        fn_screen_new_with_defaults();
+    }
   }
 
   return g_object_ref(priv->screen);
@@ -32,18 +32,28 @@
 /* =============================================================== */
 
 #include "fnscreen.h"
+#include "fn_scale.h"
 
 /* =============================================================== */
 
 struct _FnScreenPrivate
 {
   SDL_Surface * surface;
+  SDL_Surface * framebuffer;
+  fn_scale_filter_e filter;
+  gboolean native;
+  gboolean indexed;
   guint width;
   guint height;
   guint scale;
   guint bpp;
   guint sdl_flags;
-  GQueue * snapshot_stack;
+  SDL_Surface * snapshots[FN_SCREEN_MAX_SNAPSHOTS];
+  SDL_Surface ** deep_snapshots;
+  guint max_deep_snapshots;
+  guint num_snapshots;
+  SDL_Rect dirty[FN_SCREEN_MAX_DIRTY];
+  guint num_dirty;
 };
 
 /* =============================================================== */
@@ -53,7 +63,8 @@ enum {
   PROP_HEIGHT,
   PROP_SCALE,
   PROP_BPP,
-  PROP_SDL_FLAGS
+  PROP_SDL_FLAGS,
+  PROP_NATIVE
 };
 
 /* =============================================================== */
@@ -64,6 +75,7 @@ enum {
 #define FN_SCREEN_DEFAULT_BPP    0
 #define FN_SCREEN_DEFAULT_SDL_FLAGS \
   (SDL_HWSURFACE | SDL_HWACCEL | SDL_ANYFORMAT)
+#define FN_SCREEN_DEFAULT_NATIVE FALSE
 
 /* =============================================================== */
 
@@ -128,6 +140,7 @@ fn_screen_class_init(FnScreenClass * c)
   GParamSpec * scale_param;
   GParamSpec * bpp_param;
   GParamSpec * sdl_flags_param;
+  GParamSpec * native_param;
 
   g_object_class = G_OBJECT_CLASS(c);
 
@@ -227,6 +240,22 @@ fn_screen_class_init(FnScreenClass * c)
       g_object_class,
       PROP_SDL_FLAGS,
       sdl_flags_param);
+
+
+  native_param = g_param_spec_boolean(
+      "native",
+      "Native",
+      "Compose at the unscaled size and scale once when updating",
+      FN_SCREEN_DEFAULT_NATIVE,
+      G_PARAM_CONSTRUCT_ONLY |
+      G_PARAM_STATIC_STRINGS |
+      G_PARAM_READWRITE
+      );
+
+  g_object_class_install_property(
+      g_object_class,
+      PROP_NATIVE,
+      native_param);
 }
 
 /* =============================================================== */
@@ -252,8 +281,27 @@ fn_screen_set_property(
 {
   FnScreen * screen;
   screen = FN_SCREEN(object);
+  FnScreenPrivate * priv = screen->priv;
 
   switch(prop_id) {
+    case PROP_WIDTH:
+      priv->width = g_value_get_uint(value);
+      break;
+    case PROP_HEIGHT:
+      priv->height = g_value_get_uint(value);
+      break;
+    case PROP_SCALE:
+      priv->scale = g_value_get_uint(value);
+      break;
+    case PROP_BPP:
+      priv->bpp = g_value_get_uint(value);
+      break;
+    case PROP_SDL_FLAGS:
+      priv->sdl_flags = g_value_get_uint(value);
+      break;
+    case PROP_NATIVE:
+      priv->native = g_value_get_boolean(value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
   }
@@ -270,8 +318,27 @@ fn_screen_get_property(
 {
   FnScreen * screen;
   screen = FN_SCREEN(object);
+  FnScreenPrivate * priv = screen->priv;
 
   switch(prop_id) {
+    case PROP_WIDTH:
+      g_value_set_uint(value, priv->width);
+      break;
+    case PROP_HEIGHT:
+      g_value_set_uint(value, priv->height);
+      break;
+    case PROP_SCALE:
+      g_value_set_uint(value, priv->scale);
+      break;
+    case PROP_BPP:
+      g_value_set_uint(value, priv->bpp);
+      break;
+    case PROP_SDL_FLAGS:
+      g_value_set_uint(value, priv->sdl_flags);
+      break;
+    case PROP_NATIVE:
+      g_value_set_boolean(value, priv->native);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
   }
@@ -279,6 +346,140 @@ fn_screen_get_property(
 
 /* --------------------------------------------------------------- */
 
+/**
+ * Create the unscaled surface everything is composed to in native
+ * mode. It has the format of the window, so that scaling it is a
+ * plain copy of the pixels, or it is indexed and the palette is
+ * expanded while scaling.
+ */
+static void
+fn_screen_create_framebuffer(FnScreenPrivate * priv)
+{
+  SDL_Surface * old = priv->framebuffer;
+  SDL_PixelFormat * format = priv->surface->format;
+
+  if (priv->indexed) {
+    priv->framebuffer =
+      SDL_CreateRGBSurface(
+          SDL_SWSURFACE,
+          priv->width,
+          priv->height,
+          8,
+          0,
+          0,
+          0,
+          0);
+    fn_texture_apply_palette(priv->framebuffer);
+  } else {
+    priv->framebuffer =
+      SDL_CreateRGBSurface(
+          SDL_SWSURFACE,
+          priv->width,
+          priv->height,
+          format->BitsPerPixel,
+          format->Rmask,
+          format->Gmask,
+          format->Bmask,
+          format->Amask);
+  }
+
+  if (old != NULL) {
+    /* keep what has been drawn so far */
+    SDL_BlitSurface(old, NULL, priv->framebuffer, NULL);
+    SDL_FreeSurface(old);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the surface the textures are composed to.
+ */
+static SDL_Surface *
+fn_screen_get_target(FnScreenPrivate * priv)
+{
+  return priv->native ? priv->framebuffer : priv->surface;
+}
+
+/* --------------------------------------------------------------- */
+
+static void
+fn_screen_destroy_snapshot(SDL_Surface * snapshot)
+{
+  if (snapshot != NULL) {
+    fn_texture_account(FN_TEXTURE_CATEGORY_SNAPSHOT,
+        -(gssize)(snapshot->pitch * snapshot->h));
+    SDL_FreeSurface(snapshot);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+static void
+fn_screen_free_snapshot(FnScreenPrivate * priv, guint i)
+{
+  fn_screen_destroy_snapshot(priv->snapshots[i]);
+  priv->snapshots[i] = NULL;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Create a snapshot buffer with the size and format of the screen.
+ */
+static SDL_Surface *
+fn_screen_create_snapshot(FnScreenPrivate * priv)
+{
+  SDL_Surface * target = fn_screen_get_target(priv);
+  SDL_Surface * snapshot =
+    SDL_CreateRGBSurface(
+        target->flags,
+        target->w,
+        target->h,
+        target->format->BitsPerPixel,
+        target->format->Rmask,
+        target->format->Gmask,
+        target->format->Bmask,
+        target->format->Amask);
+  if (snapshot == NULL) {
+    return NULL;
+  }
+  if (target->format->BitsPerPixel == 8) {
+    fn_texture_apply_palette(snapshot);
+  }
+  fn_texture_account(FN_TEXTURE_CATEGORY_SNAPSHOT,
+      snapshot->pitch * snapshot->h);
+  return snapshot;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Get the snapshot buffer of a nesting level, creating it if there
+ * is none yet or if the screen has changed its size or format
+ * since it was created.
+ */
+static SDL_Surface *
+fn_screen_get_snapshot(FnScreenPrivate * priv, guint i)
+{
+  SDL_Surface * target = fn_screen_get_target(priv);
+  SDL_Surface * snapshot = priv->snapshots[i];
+
+  if (snapshot != NULL &&
+      snapshot->w == target->w &&
+      snapshot->h == target->h &&
+      snapshot->format->BitsPerPixel == target->format->BitsPerPixel)
+  {
+    return snapshot;
+  }
+
+  fn_screen_free_snapshot(priv, i);
+  priv->snapshots[i] = fn_screen_create_snapshot(priv);
+  return priv->snapshots[i];
+}
+
+/* --------------------------------------------------------------- */
+
 static GObject *
 fn_screen_constructor(
     GType                   gtype,
@@ -304,7 +505,16 @@ fn_screen_constructor(
         priv->sdl_flags
         );
 
-  priv->snapshot_stack = g_queue_new();
+  priv->framebuffer = NULL;
+  priv->indexed = FALSE;
+  priv->filter = FN_SCALE_FILTER_NEAREST;
+  if (priv->native) {
+    fn_screen_create_framebuffer(priv);
+  }
+
+  priv->deep_snapshots = NULL;
+  priv->max_deep_snapshots = 0;
+  priv->num_snapshots = 0;
 
   return obj;
 }
@@ -317,10 +527,18 @@ fn_screen_dispose(GObject * gobject)
   g_return_if_fail(FN_IS_SCREEN(gobject));
   FnScreen * screen = FN_SCREEN(gobject);
   FnScreenPrivate * priv = screen->priv;
-  if (priv->snapshot_stack != NULL) {
-    g_queue_free(priv->snapshot_stack);
-    priv->snapshot_stack = NULL;
+  guint i;
+  for (i = 0; i < FN_SCREEN_MAX_SNAPSHOTS; i++) {
+    fn_screen_free_snapshot(priv, i);
   }
+  for (i = FN_SCREEN_MAX_SNAPSHOTS; i < priv->num_snapshots; i++) {
+    fn_screen_destroy_snapshot(
+        priv->deep_snapshots[i - FN_SCREEN_MAX_SNAPSHOTS]);
+  }
+  g_free(priv->deep_snapshots);
+  priv->deep_snapshots = NULL;
+  priv->max_deep_snapshots = 0;
+  priv->num_snapshots = 0;
 }
 
 /* --------------------------------------------------------------- */
@@ -331,6 +549,9 @@ fn_screen_finalize(GObject * gobject)
   g_return_if_fail(FN_IS_SCREEN(gobject));
   FnScreen * screen = FN_SCREEN(gobject);
   FnScreenPrivate * priv = screen->priv;
+  if (priv->framebuffer != NULL) {
+    SDL_FreeSurface(priv->framebuffer); priv->framebuffer = NULL;
+  }
   if (priv->surface != NULL) {
     SDL_FreeSurface(priv->surface); priv->surface = NULL;
   }
@@ -352,59 +573,82 @@ fn_screen_new_with_options(FnGraphicOptions * options)
 
 /* =============================================================== */
 
+FnScreen *
+fn_screen_new_native(guint scale, fn_scale_filter_e filter)
+{
+  FnScreen * screen = g_object_new(
+      FN_TYPE_SCREEN,
+      "scale", scale,
+      "native", TRUE,
+      NULL);
+  screen->priv->filter = filter;
+  return screen;
+}
+
+/* =============================================================== */
+
 void
-fn_screen_clone_texture(
-    FnScreen * screen, FnGeometry * screengeometry,
-    FnTexture * source, FnGeometry * sourcegeometry)
+fn_screen_clone_texture_rect(
+    FnScreen * screen, const FnRect * screenrect,
+    FnTexture * source, const FnRect * sourcerect)
 {
   g_return_if_fail(FN_IS_SCREEN(screen));
   g_return_if_fail(FN_IS_TEXTURE(source));
-  g_return_if_fail(
-      screengeometry == NULL || FN_IS_GEOMETRY(screengeometry));
-  g_return_if_fail(
-      sourcegeometry == NULL || FN_IS_GEOMETRY(sourcegeometry));
 
-  SDL_Rect * sourcerect = NULL;
-  SDL_Rect * targetrect = NULL;
+  SDL_Rect srcrect;
+  SDL_Rect dstrect;
 
   FnScreenPrivate * priv = screen->priv;
 
-  if (sourcegeometry != NULL) {
-    sourcerect = g_malloc0(sizeof(SDL_Rect));
-    fn_geometry_get_data(sourcegeometry,
-        (gint  *) &(sourcerect->x),
-        (gint  *) &(sourcerect->y),
-        (guint *) &(sourcerect->w),
-        (guint *) &(sourcerect->h));
-    sourcerect->x *= priv->scale;
-    sourcerect->y *= priv->scale;
-    sourcerect->w *= priv->scale;
-    sourcerect->h *= priv->scale;
+  /* in native mode the textures are not scaled either */
+  guint scale = priv->native ? 1 : priv->scale;
+
+  if (sourcerect != NULL) {
+    srcrect.x = sourcerect->x * scale;
+    srcrect.y = sourcerect->y * scale;
+    srcrect.w = sourcerect->width * scale;
+    srcrect.h = sourcerect->height * scale;
   }
 
-  if (screengeometry != NULL) {
-    targetrect = g_malloc0(sizeof(SDL_Rect));
-    fn_geometry_get_data(screengeometry,
-        (gint  *) &(targetrect->x),
-        (gint  *) &(targetrect->y),
-        (guint *) &(targetrect->w),
-        (guint *) &(targetrect->h));
-    targetrect->x *= priv->scale;
-    targetrect->y *= priv->scale;
-    targetrect->w *= priv->scale;
-    targetrect->h *= priv->scale;
+  if (screenrect != NULL) {
+    dstrect.x = screenrect->x * scale;
+    dstrect.y = screenrect->y * scale;
+    dstrect.w = screenrect->width * scale;
+    dstrect.h = screenrect->height * scale;
   }
 
   fn_texture_blit_to_sdl_surface(
-      source,sourcerect,
-      screen->priv->surface, targetrect);
+      source, sourcerect != NULL ? &srcrect : NULL,
+      fn_screen_get_target(priv), screenrect != NULL ? &dstrect : NULL);
+}
 
-  if (sourcerect != NULL) {
-    g_free(sourcerect);
+/* =============================================================== */
+
+void
+fn_screen_clone_texture(
+    FnScreen * screen, FnGeometry * screengeometry,
+    FnTexture * source, FnGeometry * sourcegeometry)
+{
+  g_return_if_fail(FN_IS_SCREEN(screen));
+  g_return_if_fail(FN_IS_TEXTURE(source));
+  g_return_if_fail(
+      screengeometry == NULL || FN_IS_GEOMETRY(screengeometry));
+  g_return_if_fail(
+      sourcegeometry == NULL || FN_IS_GEOMETRY(sourcegeometry));
+
+  FnRect screenrect;
+  FnRect sourcerect;
+
+  if (screengeometry != NULL) {
+    fn_geometry_get_rect(screengeometry, &screenrect);
   }
-  if (targetrect != NULL) {
-    g_free(targetrect);
+  if (sourcegeometry != NULL) {
+    fn_geometry_get_rect(sourcegeometry, &sourcerect);
   }
+
+  fn_screen_clone_texture_rect(
+      screen, screengeometry != NULL ? &screenrect : NULL,
+      source, sourcegeometry != NULL ? &sourcerect : NULL);
 }
 
 /* =============================================================== */
@@ -431,29 +675,212 @@ fn_screen_update(FnScreen * screen)
 
   FnScreenPrivate * priv = screen->priv;
 
+  if (priv->native) {
+    fn_scale_blit(priv->framebuffer, priv->surface,
+        priv->scale, priv->filter);
+  }
   SDL_UpdateRect(priv->surface, 0, 0, 0, 0);
+  priv->num_dirty = 0;
 }
 
 /* =============================================================== */
 
 void
-fn_screen_snapshot_push(FnScreen * screen)
+fn_screen_mark_dirty(FnScreen * screen, const FnRect * rect)
 {
   g_return_if_fail(FN_IS_SCREEN(screen));
+  g_return_if_fail(rect != NULL);
+
   FnScreenPrivate * priv = screen->priv;
+  gint x1 = rect->x * (gint)priv->scale;
+  gint y1 = rect->y * (gint)priv->scale;
+  gint x2 = x1 + rect->width * (gint)priv->scale;
+  gint y2 = y1 + rect->height * (gint)priv->scale;
+
+  /* SDL_UpdateRects does not clip */
+  if (x1 < 0) {
+    x1 = 0;
+  }
+  if (y1 < 0) {
+    y1 = 0;
+  }
+  if (x2 > priv->surface->w) {
+    x2 = priv->surface->w;
+  }
+  if (y2 > priv->surface->h) {
+    y2 = priv->surface->h;
+  }
+  if (x2 <= x1 || y2 <= y1) {
+    return;
+  }
 
-  SDL_Surface * snapshot =
-    SDL_CreateRGBSurface(
-        priv->surface->flags,
-        priv->surface->w,
-        priv->surface->h,
-        priv->surface->format->BitsPerPixel,
-        priv->surface->format->Rmask,
-        priv->surface->format->Gmask,
-        priv->surface->format->Bmask,
-        priv->surface->format->Amask);
-  SDL_BlitSurface(priv->surface, NULL, snapshot, NULL);
-  g_queue_push_head(priv->snapshot_stack, snapshot);
+  if (priv->num_dirty == FN_SCREEN_MAX_DIRTY) {
+    /* too many pieces, so the next update shows everything */
+    priv->dirty[0].x = 0;
+    priv->dirty[0].y = 0;
+    priv->dirty[0].w = priv->surface->w;
+    priv->dirty[0].h = priv->surface->h;
+    priv->num_dirty = 1;
+    return;
+  }
+  if (priv->num_dirty == 1 &&
+      priv->dirty[0].w == priv->surface->w &&
+      priv->dirty[0].h == priv->surface->h)
+  {
+    /* already covered */
+    return;
+  }
+
+  SDL_Rect * r = &(priv->dirty[priv->num_dirty]);
+  r->x = x1;
+  r->y = y1;
+  r->w = x2 - x1;
+  r->h = y2 - y1;
+  priv->num_dirty++;
+}
+
+/* =============================================================== */
+
+void
+fn_screen_update_dirty(FnScreen * screen)
+{
+  g_return_if_fail(FN_IS_SCREEN(screen));
+
+  FnScreenPrivate * priv = screen->priv;
+
+  if (priv->num_dirty == 0) {
+    return;
+  }
+  if (priv->native) {
+    fn_scale_blit(priv->framebuffer, priv->surface,
+        priv->scale, priv->filter);
+  }
+  SDL_UpdateRects(priv->surface, priv->num_dirty, priv->dirty);
+  priv->num_dirty = 0;
+}
+
+/* =============================================================== */
+
+gboolean
+fn_screen_set_scale(FnScreen * screen, guint scale)
+{
+  g_return_val_if_fail(FN_IS_SCREEN(screen), FALSE);
+  FnScreenPrivate * priv = screen->priv;
+
+  if (!priv->native) {
+    /* the textures would have to be loaded again */
+    return FALSE;
+  }
+  if (scale == 0) {
+    return FALSE;
+  }
+  if (scale == priv->scale) {
+    return TRUE;
+  }
+
+  SDL_Surface * surface =
+    SDL_SetVideoMode(
+        priv->width * scale,
+        priv->height * scale,
+        priv->bpp,
+        priv->sdl_flags);
+  if (surface == NULL) {
+    return FALSE;
+  }
+  priv->surface = surface;
+  priv->scale = scale;
+  /* the marked areas belong to the old size */
+  priv->num_dirty = 0;
+
+  /* the format of the window may have changed with the mode */
+  if (!priv->indexed &&
+      priv->framebuffer->format->BitsPerPixel !=
+      surface->format->BitsPerPixel)
+  {
+    fn_screen_create_framebuffer(priv);
+  }
+  return TRUE;
+}
+
+/* =============================================================== */
+
+guint
+fn_screen_get_scale(FnScreen * screen)
+{
+  g_return_val_if_fail(FN_IS_SCREEN(screen), 0);
+  return screen->priv->scale;
+}
+
+/* =============================================================== */
+
+void
+fn_screen_set_filter(FnScreen * screen, fn_scale_filter_e filter)
+{
+  g_return_if_fail(FN_IS_SCREEN(screen));
+  screen->priv->filter = filter;
+}
+
+/* =============================================================== */
+
+fn_scale_filter_e
+fn_screen_get_filter(FnScreen * screen)
+{
+  g_return_val_if_fail(FN_IS_SCREEN(screen), FN_SCALE_FILTER_NEAREST);
+  return screen->priv->filter;
+}
+
+/* =============================================================== */
+
+gboolean
+fn_screen_is_native(FnScreen * screen)
+{
+  g_return_val_if_fail(FN_IS_SCREEN(screen), FALSE);
+  return screen->priv->native;
+}
+
+/* =============================================================== */
+
+void
+fn_screen_set_indexed(FnScreen * screen, gboolean indexed)
+{
+  g_return_if_fail(FN_IS_SCREEN(screen));
+  FnScreenPrivate * priv = screen->priv;
+
+  if (!priv->native || priv->indexed == indexed) {
+    return;
+  }
+  priv->indexed = indexed;
+  fn_screen_create_framebuffer(priv);
+}
+
+/* =============================================================== */
+
+void
+fn_screen_snapshot_push(FnScreen * screen)
+{
+  g_return_if_fail(FN_IS_SCREEN(screen));
+  FnScreenPrivate * priv = screen->priv;
+  SDL_Surface * snapshot = NULL;
+
+  if (priv->num_snapshots < FN_SCREEN_MAX_SNAPSHOTS) {
+    snapshot = fn_screen_get_snapshot(priv, priv->num_snapshots);
+  } else {
+    /* deeper snapshots get a buffer of their own, which is freed
+     * again by the pop */
+    guint deep = priv->num_snapshots - FN_SCREEN_MAX_SNAPSHOTS;
+    if (deep == priv->max_deep_snapshots) {
+      priv->max_deep_snapshots = (deep == 0) ? 4 : deep * 2;
+      priv->deep_snapshots = g_renew(SDL_Surface *,
+          priv->deep_snapshots, priv->max_deep_snapshots);
+    }
+    snapshot = fn_screen_create_snapshot(priv);
+    priv->deep_snapshots[deep] = snapshot;
+  }
+  if (snapshot != NULL) {
+    SDL_BlitSurface(fn_screen_get_target(priv), NULL, snapshot, NULL);
+  }
+  /* counted anyway, so that the pops still match */
+  priv->num_snapshots++;
 }
 
 /* =============================================================== */
@@ -464,10 +891,21 @@ fn_screen_snapshot_pop(FnScreen * screen)
   g_return_if_fail(FN_IS_SCREEN(screen));
   FnScreenPrivate * priv = screen->priv;
 
-  if (!g_queue_is_empty(priv->snapshot_stack)) {
-    SDL_Surface * snapshot = g_queue_pop_head(priv->snapshot_stack);
-    SDL_BlitSurface(snapshot, NULL, priv->surface, NULL);
-    SDL_FreeSurface(snapshot); snapshot = NULL;
+  if (priv->num_snapshots == 0) {
+    return;
+  }
+  priv->num_snapshots--;
+  if (priv->num_snapshots >= FN_SCREEN_MAX_SNAPSHOTS) {
+    SDL_Surface * snapshot =
+      priv->deep_snapshots[priv->num_snapshots - FN_SCREEN_MAX_SNAPSHOTS];
+    if (snapshot != NULL) {
+      SDL_BlitSurface(snapshot, NULL, fn_screen_get_target(priv), NULL);
+      fn_screen_destroy_snapshot(snapshot);
+    }
+  } else if (priv->snapshots[priv->num_snapshots] != NULL) {
+    /* the buffer is kept for the next push */
+    SDL_BlitSurface(priv->snapshots[priv->num_snapshots], NULL,
+        fn_screen_get_target(priv), NULL);
   }
 }
 
@@ -479,7 +917,7 @@ fn_screen_get_width(FnScreen * screen)
   g_return_val_if_fail(FN_IS_SCREEN(screen), 0);
   FnScreenPrivate * priv = screen->priv;
 
-  return priv->surface->w;
+  return fn_screen_get_target(priv)->w;
 }
 
 /* =============================================================== */
@@ -490,7 +928,7 @@ fn_screen_get_height(FnScreen * screen)
   g_return_val_if_fail(FN_IS_SCREEN(screen), 0);
   FnScreenPrivate * priv = screen->priv;
 
-  return priv->surface->h;
+  return fn_screen_get_target(priv)->h;
 }
 
 /* =============================================================== */
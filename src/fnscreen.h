@@ -38,6 +38,7 @@
 #include "fntexture.h"
 #include "fngeometry.h"
 #include "fnactor.h"
+#include "fn_scale.h"
 
 /* =============================================================== */
 
@@ -45,6 +46,21 @@ G_BEGIN_DECLS
 
 /* =============================================================== */
 
+/**
+ * The number of areas marked as changed that are kept before the
+ * next update shows the whole screen instead.
+ */
+#define FN_SCREEN_MAX_DIRTY 16
+
+/**
+ * The nesting of screen snapshots up to which the buffers are kept
+ * once created, so that showing a dialog again does not allocate.
+ * Deeper snapshots allocate a buffer on each push.
+ */
+#define FN_SCREEN_MAX_SNAPSHOTS 4
+
+/* =============================================================== */
+
 typedef struct _FnScreenPrivate FnScreenPrivate;
 
 /* =============================================================== */
@@ -87,6 +103,39 @@ FnScreen * fn_screen_new_with_defaults();
 
 /* =============================================================== */
 
+/**
+ * Create a screen that composes everything at the unscaled size
+ * of 320x200 pixels. The frame is scaled to the window once in
+ * fn_screen_update, so the textures drawn to the screen must be
+ * unscaled as well.
+ *
+ * @param  scale   The size of one pixel in the window.
+ * @param  filter  The filter used for scaling.
+ *
+ * @return The screen.
+ */
+FnScreen * fn_screen_new_native(guint scale, fn_scale_filter_e filter);
+
+/* =============================================================== */
+
+/**
+ * Blit a texture to the screen. The rectangles are given in
+ * unscaled coordinates.
+ *
+ * @param  screen      The screen.
+ * @param  screenrect  The position on the screen, or NULL for the
+ *                     upper left corner.
+ * @param  source      The texture.
+ * @param  sourcerect  The area of the texture, or NULL for the
+ *                     whole texture.
+ */
+void
+fn_screen_clone_texture_rect(
+    FnScreen * screen, const FnRect * screenrect,
+    FnTexture * source, const FnRect * sourcerect);
+
+/* =============================================================== */
+
 void
 fn_screen_clone_texture(
     FnScreen * screen, FnGeometry * screengeometry,
@@ -99,16 +148,114 @@ fn_screen_toggle_fullscreen(FnScreen * screen);
 
 /* =============================================================== */
 
+/**
+ * Show what has been drawn to the screen. In native mode the frame
+ * is scaled to the window first.
+ *
+ * @param  screen  The screen.
+ */
 void
 fn_screen_update(FnScreen * screen);
 
 /* =============================================================== */
 
+/**
+ * Remember that an area of the screen has changed, so that the
+ * next call of fn_screen_update_dirty shows it.
+ *
+ * @param  screen  The screen.
+ * @param  rect    The changed area, in the same unscaled units as
+ *                 the rectangles of fn_screen_clone_texture_rect.
+ */
+void
+fn_screen_mark_dirty(FnScreen * screen, const FnRect * rect);
+
+/* =============================================================== */
+
+/**
+ * Show only the areas marked as changed since the last update.
+ * In native mode the frame is still scaled as a whole, but only
+ * the changed areas are sent to the display.
+ *
+ * @param  screen  The screen.
+ */
+void
+fn_screen_update_dirty(FnScreen * screen);
+
+/* =============================================================== */
+
+/**
+ * Change the size of the window. Only native screens can do this,
+ * because the textures do not depend on the scale.
+ *
+ * @param  screen  The screen.
+ * @param  scale   The new size of one pixel in the window.
+ *
+ * @return TRUE if the scale was changed.
+ */
+gboolean
+fn_screen_set_scale(FnScreen * screen, guint scale);
+
+/* =============================================================== */
+
+guint
+fn_screen_get_scale(FnScreen * screen);
+
+/* =============================================================== */
+
+/**
+ * Set the filter used for scaling a native screen.
+ *
+ * @param  screen  The screen.
+ * @param  filter  The filter.
+ */
+void
+fn_screen_set_filter(FnScreen * screen, fn_scale_filter_e filter);
+
+/* =============================================================== */
+
+fn_scale_filter_e
+fn_screen_get_filter(FnScreen * screen);
+
+/* =============================================================== */
+
+gboolean
+fn_screen_is_native(FnScreen * screen);
+
+/* =============================================================== */
+
+/**
+ * Compose a native screen with 8 bits per pixel, to match indexed
+ * textures. The EGA palette is expanded once in fn_screen_update.
+ * Screens which are not native ignore this.
+ *
+ * @param  screen   The screen.
+ * @param  indexed  TRUE to compose with 8 bits per pixel.
+ */
+void
+fn_screen_set_indexed(FnScreen * screen, gboolean indexed);
+
+/* =============================================================== */
+
+/**
+ * Save the content of the screen, for example before a dialog is
+ * drawn over it. The snapshot buffers are reused, so only the first
+ * snapshot at each nesting level up to FN_SCREEN_MAX_SNAPSHOTS
+ * allocates memory.
+ *
+ * @param  screen  The screen.
+ */
 void
 fn_screen_snapshot_push(FnScreen * screen);
 
 /* =============================================================== */
 
+/**
+ * Restore the content of the screen saved by the matching call of
+ * fn_screen_snapshot_push.
+ *
+ * @param  screen  The screen.
+ */
 void
 fn_screen_snapshot_pop(FnScreen * screen);
 
@@ -26,6 +26,7 @@
  *
  *******************************************************************/
 
+#include <string.h>
 #include <SDL.h>
 
 /* =============================================================== */
@@ -33,6 +34,17 @@
 #include "fn.h"
 #include "fntexture.h"
 #include "fngraphicoptions.h"
+#include "fn_blit.h"
+
+/* =============================================================== */
+
+/**
+ * A run of opaque pixels in a row of a texture, in unscaled pixels.
+ */
+typedef struct {
+  guint16 x;
+  guint16 width;
+} FnTextureSpan;
 
 /* =============================================================== */
 
@@ -41,7 +53,100 @@ struct _FnTexturePrivate
   guint width;
   guint height;
   SDL_Surface * surface;
+  guint sdl_flags;
+  gboolean indexed;
   FnGraphicOptions * graphic_options;
+  FnTextureCategory category;
+  gsize bytes;
+  FnTextureOpacity opacity;
+  guint16 * rowspans;
+  FnTextureSpan * spans;
+};
+
+/* =============================================================== */
+
+/**
+ * If unset, classified textures are blitted by SDL like all others,
+ * which lets the benchmarks compare both ways.
+ */
+static gboolean fn_texture_fast_blits = TRUE;
+
+/**
+ * The draw list recording the blits onto its target, if any.
+ */
+static fn_drawlist_t * fn_texture_draw_list = NULL;
+
+/* =============================================================== */
+
+/**
+ * The memory used by all textures. Textures are also created by
+ * levels loaded on simulation threads, so it is locked.
+ */
+static struct {
+  guint live;
+  gsize bytes[FN_TEXTURE_NUM_CATEGORIES];
+  gsize total;
+  gsize peak;
+  gsize budget;
+  gboolean over_budget;
+} fn_texture_registry;
+
+G_LOCK_DEFINE_STATIC(fn_texture_registry);
+
+/**
+ * The most surfaces and bytes kept for reuse. The level texture
+ * alone takes about 12 MB at 32 bits, so it fits once.
+ */
+#define FN_TEXTURE_POOL_SIZE  16
+#define FN_TEXTURE_POOL_BYTES (32 * 1024 * 1024)
+
+/**
+ * The surfaces of finalized textures, oldest first, with the options
+ * they were created with. It is locked together with the registry.
+ */
+static struct {
+  struct {
+    SDL_Surface * surface;
+    guint sdl_flags;
+    gboolean indexed;
+  } entries[FN_TEXTURE_POOL_SIZE];
+  guint num;
+  gsize bytes;
+} fn_texture_pool;
+
+/**
+ * The 16 colours of the EGA palette, indexed by intensity, red,
+ * green and blue bit. Dark yellow is shown as brown.
+ */
+static SDL_Color fn_texture_palette[FN_TEXTURE_PALETTE_SIZE] = {
+  { 0x00, 0x00, 0x00, 0 },
+  { 0x00, 0x00, 0xA8, 0 },
+  { 0x00, 0xA8, 0x00, 0 },
+  { 0x00, 0xA8, 0xA8, 0 },
+  { 0xA8, 0x00, 0x00, 0 },
+  { 0xA8, 0x00, 0xA8, 0 },
+  { 0xA8, 0x54, 0x00, 0 },
+  { 0xA8, 0xA8, 0xA8, 0 },
+  { 0x54, 0x54, 0x54, 0 },
+  { 0x54, 0x54, 0xFC, 0 },
+  { 0x54, 0xFC, 0x54, 0 },
+  { 0x54, 0xFC, 0xFC, 0 },
+  { 0xFC, 0x54, 0x54, 0 },
+  { 0xFC, 0x54, 0xFC, 0 },
+  { 0xFC, 0xFC, 0x54, 0 },
+  { 0xFC, 0xFC, 0xFC, 0 }
+};
+
+/* --------------------------------------------------------------- */
+
+static const gchar * fn_texture_category_names[FN_TEXTURE_NUM_CATEGORIES] = {
+  "other",
+  "tile",
+  "level",
+  "backdrop",
+  "ui",
+  "snapshot",
+  "pool"
 };
 
 /* =============================================================== */
@@ -200,6 +305,122 @@ FnTexture * fn_texture_new_with_options(
 
 /* =============================================================== */
 
+/* must be called with the registry locked */
+static void
+fn_texture_registry_change(
+    FnTextureCategory category,
+    gssize bytes)
+{
+  fn_texture_registry.bytes[category] += bytes;
+  fn_texture_registry.total += bytes;
+  if (fn_texture_registry.total > fn_texture_registry.peak) {
+    fn_texture_registry.peak = fn_texture_registry.total;
+  }
+  if (fn_texture_registry.budget != 0 &&
+      fn_texture_registry.total > fn_texture_registry.budget)
+  {
+    if (!fn_texture_registry.over_budget) {
+      g_printerr("Texture memory of %lu bytes exceeds "
+          "the budget of %lu bytes (%s: %lu bytes).\n",
+          (unsigned long)fn_texture_registry.total,
+          (unsigned long)fn_texture_registry.budget,
+          fn_texture_category_names[category],
+          (unsigned long)fn_texture_registry.bytes[category]);
+      fn_texture_registry.over_budget = TRUE;
+    }
+  } else {
+    fn_texture_registry.over_budget = FALSE;
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Remove a surface from the pool. The registry must be locked.
+ */
+static SDL_Surface *
+fn_texture_pool_remove(guint i)
+{
+  SDL_Surface * surface = fn_texture_pool.entries[i].surface;
+  gsize bytes = surface->pitch * surface->h;
+
+  fn_texture_pool.num--;
+  memmove(&(fn_texture_pool.entries[i]),
+      &(fn_texture_pool.entries[i + 1]),
+      (fn_texture_pool.num - i) * sizeof(fn_texture_pool.entries[0]));
+  fn_texture_pool.bytes -= bytes;
+  fn_texture_registry_change(FN_TEXTURE_CATEGORY_POOL, -(gssize)bytes);
+  return surface;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Take a surface of the given size and format from the pool.
+ *
+ * @return The surface, or NULL if there is none.
+ */
+static SDL_Surface *
+fn_texture_pool_take(guint width, guint height, guint bpp,
+    guint sdl_flags, gboolean indexed)
+{
+  SDL_Surface * surface = NULL;
+  gint i;
+
+  G_LOCK(fn_texture_registry);
+  /* the most recently returned first, it is most likely cached */
+  for (i = (gint)fn_texture_pool.num - 1; i >= 0; i--) {
+    SDL_Surface * candidate = fn_texture_pool.entries[i].surface;
+    if (candidate->w == (int)width &&
+        candidate->h == (int)height &&
+        candidate->format->BitsPerPixel == bpp &&
+        fn_texture_pool.entries[i].sdl_flags == sdl_flags &&
+        fn_texture_pool.entries[i].indexed == indexed)
+    {
+      surface = fn_texture_pool_remove(i);
+      break;
+    }
+  }
+  G_UNLOCK(fn_texture_registry);
+  return surface;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Give the surface of a finalized texture to the pool, or free it
+ * if it does not fit. A surface which is still referenced, like
+ * the source of a blit recorded in a draw list, is only released,
+ * so it is not reused before the recorded blit is rendered.
+ */
+static void
+fn_texture_pool_give(SDL_Surface * surface, guint sdl_flags,
+    gboolean indexed)
+{
+  gsize bytes = surface->pitch * surface->h;
+
+  if (surface->refcount != 1 || bytes > FN_TEXTURE_POOL_BYTES) {
+    SDL_FreeSurface(surface);
+    return;
+  }
+
+  G_LOCK(fn_texture_registry);
+  while (fn_texture_pool.num == FN_TEXTURE_POOL_SIZE ||
+      fn_texture_pool.bytes + bytes > FN_TEXTURE_POOL_BYTES)
+  {
+    SDL_FreeSurface(fn_texture_pool_remove(0));
+  }
+  fn_texture_pool.entries[fn_texture_pool.num].surface = surface;
+  fn_texture_pool.entries[fn_texture_pool.num].sdl_flags = sdl_flags;
+  fn_texture_pool.entries[fn_texture_pool.num].indexed = indexed;
+  fn_texture_pool.num++;
+  fn_texture_pool.bytes += bytes;
+  fn_texture_registry_change(FN_TEXTURE_CATEGORY_POOL, bytes);
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
 static void
 fn_texture_init(FnTexture * texture)
 {
@@ -300,17 +521,35 @@ fn_texture_constructor(
     fn_graphic_options_get_bpp(priv->graphic_options);
   guint transparent =
     fn_graphic_options_get_transparent(priv->graphic_options);
+  gboolean indexed =
+    fn_graphic_options_get_indexed(priv->graphic_options);
+
+  if (indexed) {
+    /* a quarter of the memory and blit bandwidth of 32 bits */
+    bpp = 8;
+    transparent = FN_TEXTURE_INDEX_TRANSPARENT;
+  }
 
   SDL_Surface * surface =
-    SDL_CreateRGBSurface(
-        sdl_flags,
-        priv->width * scale,
-        priv->height * scale,
-        bpp,
-        0,
-        0,
-        0,
-        0);
+    fn_texture_pool_take(priv->width * scale, priv->height * scale,
+        bpp, sdl_flags, indexed);
+
+  if (surface == NULL) {
+    surface =
+      SDL_CreateRGBSurface(
+          sdl_flags,
+          priv->width * scale,
+          priv->height * scale,
+          bpp,
+          0,
+          0,
+          0,
+          0);
+
+    if (indexed) {
+      fn_texture_apply_palette(surface);
+    }
+  }
 
   SDL_SetColorKey(surface, SDL_SRCCOLORKEY, transparent);
 
@@ -320,6 +559,18 @@ fn_texture_constructor(
       transparent);
 
   texture->priv->surface = surface;
+  texture->priv->sdl_flags = sdl_flags;
+  texture->priv->indexed = indexed;
+  texture->priv->opacity = FN_TEXTURE_OPACITY_UNKNOWN;
+  texture->priv->rowspans = NULL;
+  texture->priv->spans = NULL;
+  texture->priv->category = FN_TEXTURE_CATEGORY_OTHER;
+  texture->priv->bytes = surface->pitch * surface->h;
+
+  G_LOCK(fn_texture_registry);
+  fn_texture_registry.live++;
+  fn_texture_registry_change(priv->category, priv->bytes);
+  G_UNLOCK(fn_texture_registry);
 
   return obj;
 }
@@ -338,13 +589,147 @@ fn_texture_finalize(GObject * gobject)
 {
   FnTexture * texture = FN_TEXTURE(gobject);
 
-  SDL_FreeSurface(texture->priv->surface);
+  G_LOCK(fn_texture_registry);
+  fn_texture_registry.live--;
+  fn_texture_registry_change(texture->priv->category,
+      -(gssize)texture->priv->bytes);
+  G_UNLOCK(fn_texture_registry);
+
+  g_free(texture->priv->rowspans);
+  g_free(texture->priv->spans);
+  fn_texture_pool_give(texture->priv->surface,
+      texture->priv->sdl_flags, texture->priv->indexed);
 
   G_OBJECT_CLASS(fn_texture_parent_class)->finalize(gobject);
 }
 
 /* =============================================================== */
 
+/**
+ * Forget the opacity of a texture after something was drawn to it.
+ */
+static void
+fn_texture_invalidate_opacity(FnTexturePrivate * priv)
+{
+  priv->opacity = FN_TEXTURE_OPACITY_UNKNOWN;
+  g_free(priv->rowspans); priv->rowspans = NULL;
+  g_free(priv->spans); priv->spans = NULL;
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Check if the keyed blit draws a pixel of a surface. It compares
+ * the pixel with the colour key the same way fn_blit_copy and SDL
+ * do, so black pixels which are the key are not drawn either.
+ */
+static gboolean
+fn_texture_pixel_drawn(SDL_Surface * surface, gint x, gint y)
+{
+  SDL_PixelFormat * fmt = surface->format;
+  Uint8 * p = (Uint8 *)surface->pixels + y * surface->pitch +
+    x * fmt->BytesPerPixel;
+  Uint32 rgbmask = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+  Uint32 pixel = 0;
+
+  if (!(surface->flags & SDL_SRCCOLORKEY)) {
+    return TRUE;
+  }
+
+  switch (fmt->BytesPerPixel) {
+    case 1:
+      return (*p != fmt->colorkey);
+    case 2:
+      return (*(Uint16 *)p != fmt->colorkey);
+    case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+      pixel = (p[0] << 16) | (p[1] << 8) | p[2];
+#else
+      pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+#endif
+      return ((pixel & rgbmask) != (fmt->colorkey & rgbmask));
+    default:
+      pixel = *(Uint32 *)p;
+      return ((pixel & rgbmask) != (fmt->colorkey & rgbmask));
+  }
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Classify a texture by the pixels the keyed blit draws from its
+ * surface and remember the drawn spans of each row if it is mixed.
+ * All scaled pixels of one texture pixel are the same, so only the
+ * first of them is checked.
+ */
+static void
+fn_texture_classify(FnTexturePrivate * priv)
+{
+  SDL_Surface * surface = priv->surface;
+  guint scale = fn_graphic_options_get_scale(priv->graphic_options);
+  guint x = 0;
+  guint y = 0;
+  guint numspans = 0;
+  guint numopaque = 0;
+  gboolean drawn = FALSE;
+  gboolean previous = FALSE;
+
+  fn_texture_invalidate_opacity(priv);
+
+  if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+    return;
+  }
+
+  for (y = 0; y < priv->height; y++) {
+    previous = FALSE;
+    for (x = 0; x < priv->width; x++) {
+      drawn = fn_texture_pixel_drawn(surface, x * scale, y * scale);
+      if (drawn) {
+        numopaque++;
+        if (!previous) {
+          numspans++;
+        }
+      }
+      previous = drawn;
+    }
+  }
+
+  if (numopaque == 0) {
+    priv->opacity = FN_TEXTURE_OPACITY_TRANSPARENT;
+  } else if (numopaque == priv->width * priv->height) {
+    priv->opacity = FN_TEXTURE_OPACITY_OPAQUE;
+  } else {
+    priv->opacity = FN_TEXTURE_OPACITY_MIXED;
+    priv->rowspans = g_new(guint16, priv->height + 1);
+    priv->spans = g_new(FnTextureSpan, numspans);
+
+    numspans = 0;
+    for (y = 0; y < priv->height; y++) {
+      priv->rowspans[y] = numspans;
+      previous = FALSE;
+      for (x = 0; x < priv->width; x++) {
+        drawn = fn_texture_pixel_drawn(surface, x * scale, y * scale);
+        if (drawn) {
+          if (!previous) {
+            priv->spans[numspans].x = x;
+            priv->spans[numspans].width = 0;
+            numspans++;
+          }
+          priv->spans[numspans - 1].width++;
+        }
+        previous = drawn;
+      }
+    }
+    priv->rowspans[priv->height] = numspans;
+  }
+
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+}
+
+/* --------------------------------------------------------------- */
+
 void
 fn_texture_set_data(
     FnTexture * texture,
@@ -354,8 +739,14 @@ fn_texture_set_data(
   FnTexturePrivate * priv = texture->priv;
   Uint32 transparent =
     fn_graphic_options_get_transparent(priv->graphic_options);
+  gboolean indexed =
+    fn_graphic_options_get_indexed(priv->graphic_options);
   SDL_Surface * surface = priv->surface;
 
+  if (indexed) {
+    transparent = FN_TEXTURE_INDEX_TRANSPARENT;
+  }
+
   guint i = 0;
   guint j = 0;
   guchar * iter = data;
@@ -383,6 +774,8 @@ fn_texture_set_data(
 
       if (opaque == 0) {
         color = transparent;
+      } else if (indexed) {
+        color = fn_texture_palette_index(red, green, blue);
       } else {
         color = SDL_MapRGB(fmt, red, green, blue);
       }
@@ -397,10 +790,252 @@ fn_texture_set_data(
   }
 
   priv->surface = surface;
+
+  fn_texture_classify(priv);
+}
+
+/* --------------------------------------------------------------- */
+
+void
+fn_texture_set_indexed_data(
+    FnTexture * texture,
+    const guchar * indices,
+    const SDL_Color * colors,
+    guint numcolors)
+{
+  g_return_if_fail(FN_IS_TEXTURE(texture));
+  g_return_if_fail(numcolors <= 256);
+  FnTexturePrivate * priv = texture->priv;
+  SDL_Surface * surface = priv->surface;
+  gboolean indexed =
+    fn_graphic_options_get_indexed(priv->graphic_options);
+  guint scale =
+    fn_graphic_options_get_scale(priv->graphic_options);
+  guint bytes = surface->format->BytesPerPixel;
+  guint rowbytes = priv->width * scale * bytes;
+  Uint32 pixels[256];
+  guint x = 0;
+  guint y = 0;
+  guint k = 0;
+
+  for (k = 0; k < numcolors; k++) {
+    if (indexed) {
+      pixels[k] = fn_texture_palette_index(
+          colors[k].r, colors[k].g, colors[k].b);
+    } else {
+      pixels[k] = SDL_MapRGB(surface->format,
+          colors[k].r, colors[k].g, colors[k].b);
+    }
+  }
+
+  fn_texture_invalidate_opacity(priv);
+
+  if (bytes == 3) {
+    /* rare enough to leave the byte order to SDL */
+    SDL_Rect r = { 0, 0, scale, scale };
+    for (y = 0; y < priv->height; y++) {
+      for (x = 0; x < priv->width; x++) {
+        r.x = x * scale;
+        r.y = y * scale;
+        SDL_FillRect(surface, &r,
+            pixels[indices[y * priv->width + x]]);
+      }
+    }
+    fn_texture_classify(priv);
+    return;
+  }
+
+  if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+    return;
+  }
+  for (y = 0; y < priv->height; y++) {
+    const guchar * src = indices + y * priv->width;
+    Uint8 * row = (Uint8 *)surface->pixels + y * scale * surface->pitch;
+
+    /* write the first of the scaled rows pixel by pixel */
+    switch (bytes) {
+      case 1:
+        for (x = 0; x < priv->width; x++) {
+          memset(row + x * scale, pixels[src[x]], scale);
+        }
+        break;
+      case 2:
+        for (x = 0; x < priv->width; x++) {
+          Uint16 * dst = (Uint16 *)row + x * scale;
+          for (k = 0; k < scale; k++) {
+            dst[k] = pixels[src[x]];
+          }
+        }
+        break;
+      default:
+        for (x = 0; x < priv->width; x++) {
+          Uint32 * dst = (Uint32 *)row + x * scale;
+          for (k = 0; k < scale; k++) {
+            dst[k] = pixels[src[x]];
+          }
+        }
+        break;
+    }
+
+    /* and copy it to the others */
+    for (k = 1; k < scale; k++) {
+      memcpy(row + k * surface->pitch, row, rowbytes);
+    }
+  }
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+
+  /* colours which map to the key are not drawn */
+  fn_texture_classify(priv);
 }
 
 /* =============================================================== */
 
+/**
+ * Check if the pixels of a surface can be copied to another one
+ * without conversion.
+ */
+static gboolean
+fn_texture_same_format(SDL_Surface * src, SDL_Surface * dst)
+{
+  SDL_PixelFormat * sf = src->format;
+  SDL_PixelFormat * df = dst->format;
+
+  if (sf->BytesPerPixel != df->BytesPerPixel) {
+    return FALSE;
+  }
+  if (sf->BytesPerPixel == 1) {
+    return (sf->palette != NULL && df->palette != NULL &&
+        sf->palette->ncolors <= df->palette->ncolors &&
+        memcmp(sf->palette->colors, df->palette->colors,
+          sf->palette->ncolors * sizeof(SDL_Color)) == 0);
+  }
+  return (sf->Rmask == df->Rmask &&
+      sf->Gmask == df->Gmask &&
+      sf->Bmask == df->Bmask);
+}
+
+/* --------------------------------------------------------------- */
+
+/**
+ * Blit a whole classified texture. Transparent textures are only
+ * clipped, opaque ones are copied row by row and mixed ones span by
+ * span, so no pixel is compared to the colour key. The rectangle is
+ * clipped and updated like SDL_BlitSurface does it.
+ *
+ * @return FALSE if SDL has to do the blit.
+ */
+static gboolean
+fn_texture_blit_classified(
+    FnTexturePrivate * priv,
+    SDL_Surface * dst,
+    SDL_Rect * dstrect)
+{
+  SDL_Surface * src = priv->surface;
+  SDL_Rect * clip = &(dst->clip_rect);
+  guint scale = fn_graphic_options_get_scale(priv->graphic_options);
+
+  if (priv->opacity != FN_TEXTURE_OPACITY_TRANSPARENT &&
+      !fn_texture_same_format(src, dst))
+  {
+    return FALSE;
+  }
+
+  gint dx = (dstrect != NULL) ? dstrect->x : 0;
+  gint dy = (dstrect != NULL) ? dstrect->y : 0;
+  gint sx = 0;
+  gint sy = 0;
+  gint w = src->w;
+  gint h = src->h;
+
+  if (dx < clip->x) {
+    sx = clip->x - dx;
+    w -= sx;
+    dx = clip->x;
+  }
+  if (dy < clip->y) {
+    sy = clip->y - dy;
+    h -= sy;
+    dy = clip->y;
+  }
+  if (dx + w > clip->x + clip->w) {
+    w = clip->x + clip->w - dx;
+  }
+  if (dy + h > clip->y + clip->h) {
+    h = clip->y + clip->h - dy;
+  }
+
+  if (w <= 0 || h <= 0) {
+    if (dstrect != NULL) {
+      dstrect->w = 0;
+      dstrect->h = 0;
+    }
+    return TRUE;
+  }
+  if (dstrect != NULL) {
+    dstrect->x = dx;
+    dstrect->y = dy;
+    dstrect->w = w;
+    dstrect->h = h;
+  }
+  if (priv->opacity == FN_TEXTURE_OPACITY_TRANSPARENT) {
+    return TRUE;
+  }
+
+  if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) != 0) {
+    return FALSE;
+  }
+  if (SDL_MUSTLOCK(src) && SDL_LockSurface(src) != 0) {
+    if (SDL_MUSTLOCK(dst)) {
+      SDL_UnlockSurface(dst);
+    }
+    return FALSE;
+  }
+
+  Uint8 bpp = src->format->BytesPerPixel;
+  gint row = 0;
+  for (row = sy; row < sy + h; row++) {
+    Uint8 * s = (Uint8 *)src->pixels + row * src->pitch;
+    /* indexed by the x coordinate inside the texture */
+    Uint8 * d = (Uint8 *)dst->pixels + (dy + row - sy) * dst->pitch +
+      (dx - sx) * bpp;
+
+    if (priv->opacity == FN_TEXTURE_OPACITY_OPAQUE) {
+      memcpy(d + sx * bpp, s + sx * bpp, w * bpp);
+    } else {
+      guint i = 0;
+      guint unscaled = row / scale;
+      for (i = priv->rowspans[unscaled];
+          i < priv->rowspans[unscaled + 1];
+          i++)
+      {
+        gint a = priv->spans[i].x * scale;
+        gint b = (priv->spans[i].x + priv->spans[i].width) * scale;
+        if (a < sx) {
+          a = sx;
+        }
+        if (b > sx + w) {
+          b = sx + w;
+        }
+        if (a < b) {
+          memcpy(d + a * bpp, s + a * bpp, (b - a) * bpp);
+        }
+      }
+    }
+  }
+
+  if (SDL_MUSTLOCK(src)) {
+    SDL_UnlockSurface(src);
+  }
+  if (SDL_MUSTLOCK(dst)) {
+    SDL_UnlockSurface(dst);
+  }
+  return TRUE;
+}
+
+/* --------------------------------------------------------------- */
+
 void
 fn_texture_blit_to_sdl_surface(
     FnTexture * texture,
@@ -412,7 +1047,89 @@ fn_texture_blit_to_sdl_surface(
   FnTexturePrivate * priv = texture->priv;
   SDL_Surface * src = priv->surface;
 
-  SDL_BlitSurface(src, srcrect, destination, dstrect);
+  if (fn_texture_draw_list != NULL &&
+      destination == fn_drawlist_get_target(fn_texture_draw_list))
+  {
+    fn_drawlist_blit(fn_texture_draw_list, src, srcrect, dstrect);
+    return;
+  }
+
+  if (srcrect == NULL &&
+      fn_texture_fast_blits &&
+      priv->opacity != FN_TEXTURE_OPACITY_UNKNOWN &&
+      fn_texture_blit_classified(priv, destination, dstrect))
+  {
+    return;
+  }
+
+  if (!fn_blit_keyed(src, srcrect, destination, dstrect)) {
+    SDL_BlitSurface(src, srcrect, destination, dstrect);
+  }
+}
+
+/* =============================================================== */
+
+void
+fn_texture_apply_palette(SDL_Surface * surface)
+{
+  SDL_SetColors(surface, fn_texture_palette, 0, FN_TEXTURE_PALETTE_SIZE);
+}
+
+/* =============================================================== */
+
+Uint8
+fn_texture_palette_index(guchar red, guchar green, guchar blue)
+{
+  Uint8 best = 0;
+  guint bestdistance = G_MAXUINT;
+  Uint8 i = 0;
+
+  for (i = 0; i < FN_TEXTURE_PALETTE_SIZE; i++) {
+    gint dr = red - fn_texture_palette[i].r;
+    gint dg = green - fn_texture_palette[i].g;
+    gint db = blue - fn_texture_palette[i].b;
+    guint distance = dr * dr + dg * dg + db * db;
+    if (distance < bestdistance) {
+      best = i;
+      bestdistance = distance;
+    }
+  }
+  return best;
+}
+
+/* =============================================================== */
+
+void
+fn_texture_clone_rect(
+    FnTexture * source,
+    const FnRect * sourcerect,
+    FnTexture * target,
+    const FnRect * targetrect)
+{
+  g_return_if_fail(FN_IS_TEXTURE(source));
+  g_return_if_fail(FN_IS_TEXTURE(target));
+
+  SDL_Rect srcrect;
+  SDL_Rect dstrect;
+
+  if (sourcerect != NULL) {
+    srcrect.x = sourcerect->x;
+    srcrect.y = sourcerect->y;
+    srcrect.w = sourcerect->width;
+    srcrect.h = sourcerect->height;
+  }
+  if (targetrect != NULL) {
+    dstrect.x = targetrect->x;
+    dstrect.y = targetrect->y;
+    dstrect.w = targetrect->width;
+    dstrect.h = targetrect->height;
+  }
+
+  fn_texture_invalidate_opacity(target->priv);
+
+  fn_texture_blit_to_sdl_surface(
+      source, sourcerect != NULL ? &srcrect : NULL,
+      target->priv->surface, targetrect != NULL ? &dstrect : NULL);
 }
 
 /* =============================================================== */
@@ -433,39 +1150,19 @@ fn_texture_clone_to_texture(
     g_return_if_fail(FN_IS_GEOMETRY(targetgeometry));
   }
 
-  FnTexturePrivate * sourcepriv = source->priv;
-  FnTexturePrivate * targetpriv = target->priv;
+  FnRect sourcerect;
+  FnRect targetrect;
 
-  SDL_Rect * sourcerect = NULL;
   if (sourcegeometry != NULL) {
-    sourcerect = g_malloc0(sizeof(SDL_Rect));
-    fn_geometry_get_data(sourcegeometry,
-        (gint  *) &(sourcerect->x),
-        (gint  *) &(sourcerect->y),
-        (guint *) &(sourcerect->w),
-        (guint *) &(sourcerect->h));
+    fn_geometry_get_rect(sourcegeometry, &sourcerect);
   }
-
-  SDL_Rect * targetrect = NULL;
   if (targetgeometry != NULL) {
-    targetrect = g_malloc0(sizeof(SDL_Rect));
-    fn_geometry_get_data(targetgeometry,
-        (gint  *) &(targetrect->x),
-        (gint  *) &(targetrect->y),
-        (guint *) &(targetrect->w),
-        (guint *) &(targetrect->h));
+    fn_geometry_get_rect(targetgeometry, &targetrect);
   }
 
-  SDL_BlitSurface(
-      sourcepriv->surface, sourcerect,
-      targetpriv->surface, targetrect);
-
-  if (sourcerect != NULL) {
-    g_free(sourcerect);
-  }
-  if (targetrect != NULL) {
-    g_free(targetrect);
-  }
+  fn_texture_clone_rect(
+      source, sourcegeometry != NULL ? &sourcerect : NULL,
+      target, targetgeometry != NULL ? &targetrect : NULL);
 }
 
 /* =============================================================== */
@@ -518,8 +1215,199 @@ fn_texture_fill_area(
 
   Uint32 cursorcolor = SDL_MapRGB(
       texture->priv->surface->format, red, green, blue);
+  if (texture->priv->surface->format->BitsPerPixel == 8) {
+    /* only look at the colours of the EGA palette */
+    cursorcolor = fn_texture_palette_index(red, green, blue);
+  }
+  fn_texture_invalidate_opacity(texture->priv);
   SDL_FillRect(texture->priv->surface, &rect, cursorcolor);
 }
 
 /* =============================================================== */
 
+void
+fn_texture_set_category(
+    FnTexture * texture,
+    FnTextureCategory category)
+{
+  g_return_if_fail(FN_IS_TEXTURE(texture));
+  g_return_if_fail(category < FN_TEXTURE_NUM_CATEGORIES);
+  FnTexturePrivate * priv = texture->priv;
+
+  /* the total does not change, so the budget is not checked again */
+  G_LOCK(fn_texture_registry);
+  fn_texture_registry.bytes[priv->category] -= priv->bytes;
+  priv->category = category;
+  fn_texture_registry.bytes[priv->category] += priv->bytes;
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
+FnTextureCategory
+fn_texture_get_category(
+    FnTexture * texture)
+{
+  g_return_val_if_fail(FN_IS_TEXTURE(texture), FN_TEXTURE_CATEGORY_OTHER);
+  return texture->priv->category;
+}
+
+/* =============================================================== */
+
+gsize
+fn_texture_get_memory(
+    FnTexture * texture)
+{
+  g_return_val_if_fail(FN_IS_TEXTURE(texture), 0);
+  return texture->priv->bytes;
+}
+
+/* =============================================================== */
+
+void
+fn_texture_account(
+    FnTextureCategory category,
+    gssize bytes)
+{
+  g_return_if_fail(category < FN_TEXTURE_NUM_CATEGORIES);
+
+  G_LOCK(fn_texture_registry);
+  fn_texture_registry_change(category, bytes);
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
+guint
+fn_texture_get_live_count(void)
+{
+  guint live;
+  G_LOCK(fn_texture_registry);
+  live = fn_texture_registry.live;
+  G_UNLOCK(fn_texture_registry);
+  return live;
+}
+
+/* =============================================================== */
+
+gsize
+fn_texture_get_bytes(
+    FnTextureCategory category)
+{
+  gsize bytes;
+  g_return_val_if_fail(category < FN_TEXTURE_NUM_CATEGORIES, 0);
+  G_LOCK(fn_texture_registry);
+  bytes = fn_texture_registry.bytes[category];
+  G_UNLOCK(fn_texture_registry);
+  return bytes;
+}
+
+/* =============================================================== */
+
+gsize
+fn_texture_get_total_bytes(void)
+{
+  gsize bytes;
+  G_LOCK(fn_texture_registry);
+  bytes = fn_texture_registry.total;
+  G_UNLOCK(fn_texture_registry);
+  return bytes;
+}
+
+/* =============================================================== */
+
+gsize
+fn_texture_get_peak_bytes(void)
+{
+  gsize bytes;
+  G_LOCK(fn_texture_registry);
+  bytes = fn_texture_registry.peak;
+  G_UNLOCK(fn_texture_registry);
+  return bytes;
+}
+
+/* =============================================================== */
+
+void
+fn_texture_set_budget(
+    gsize bytes)
+{
+  G_LOCK(fn_texture_registry);
+  fn_texture_registry.budget = bytes;
+  fn_texture_registry.over_budget = FALSE;
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
+void
+fn_texture_clear_pool(void)
+{
+  G_LOCK(fn_texture_registry);
+  while (fn_texture_pool.num > 0) {
+    SDL_FreeSurface(fn_texture_pool_remove(fn_texture_pool.num - 1));
+  }
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
+void
+fn_texture_print_statistics(void)
+{
+  guint i = 0;
+
+  G_LOCK(fn_texture_registry);
+  g_print("Textures: %u alive, %lu bytes in use, %lu bytes at most",
+      fn_texture_registry.live,
+      (unsigned long)fn_texture_registry.total,
+      (unsigned long)fn_texture_registry.peak);
+  if (fn_texture_registry.budget != 0) {
+    g_print(", budget %lu bytes",
+        (unsigned long)fn_texture_registry.budget);
+  }
+  g_print("\n");
+  for (i = 0; i < FN_TEXTURE_NUM_CATEGORIES; i++) {
+    g_print("  %-10s %10lu bytes\n",
+        fn_texture_category_names[i],
+        (unsigned long)fn_texture_registry.bytes[i]);
+  }
+  G_UNLOCK(fn_texture_registry);
+}
+
+/* =============================================================== */
+
+FnTextureOpacity
+fn_texture_get_opacity(FnTexture * texture)
+{
+  g_return_val_if_fail(FN_IS_TEXTURE(texture), FN_TEXTURE_OPACITY_UNKNOWN);
+  return texture->priv->opacity;
+}
+
+/* =============================================================== */
+
+SDL_Surface *
+fn_texture_get_sdl_surface(FnTexture * texture)
+{
+  g_return_val_if_fail(FN_IS_TEXTURE(texture), NULL);
+  fn_texture_invalidate_opacity(texture->priv);
+  return texture->priv->surface;
+}
+
+/* =============================================================== */
+
+void
+fn_texture_set_fast_blits(gboolean enabled)
+{
+  fn_texture_fast_blits = enabled;
+}
+
+/* =============================================================== */
+
+void
+fn_texture_set_draw_list(fn_drawlist_t * dl)
+{
+  fn_texture_draw_list = dl;
+}
+
+/* =============================================================== */
@@ -38,6 +38,7 @@
 
 #include "fngeometry.h"
 #include "fngraphicoptions.h"
+#include "fn_drawlist.h"
 
 /* =============================================================== */
 
@@ -50,6 +51,50 @@ G_BEGIN_DECLS
 
 /* =============================================================== */
 
+/**
+ * The number of colours in the EGA palette.
+ */
+#define FN_TEXTURE_PALETTE_SIZE 16
+
+/**
+ * The colour key of indexed textures.
+ */
+#define FN_TEXTURE_INDEX_TRANSPARENT 0xFF
+
+/* =============================================================== */
+
+/**
+ * What the pixel memory of a texture is used for. The memory of
+ * all textures is accounted per category.
+ */
+typedef enum {
+  FN_TEXTURE_CATEGORY_OTHER,
+  FN_TEXTURE_CATEGORY_TILE,
+  FN_TEXTURE_CATEGORY_LEVEL,
+  FN_TEXTURE_CATEGORY_BACKDROP,
+  FN_TEXTURE_CATEGORY_UI,
+  FN_TEXTURE_CATEGORY_SNAPSHOT,
+  FN_TEXTURE_CATEGORY_POOL,
+  FN_TEXTURE_NUM_CATEGORIES
+} FnTextureCategory;
+
+/* =============================================================== */
+
+/**
+ * Which pixels of a texture are opaque. It is known for textures
+ * whose data was set with fn_texture_set_data and nothing was drawn
+ * to afterwards, and is used to avoid colour key tests when they
+ * are blitted.
+ */
+typedef enum {
+  FN_TEXTURE_OPACITY_UNKNOWN,
+  FN_TEXTURE_OPACITY_TRANSPARENT,
+  FN_TEXTURE_OPACITY_OPAQUE,
+  FN_TEXTURE_OPACITY_MIXED
+} FnTextureOpacity;
+
+/* =============================================================== */
+
 typedef struct _FnTexturePrivate FnTexturePrivate;
 
 /* =============================================================== */
@@ -100,6 +145,26 @@ fn_texture_set_data(
 
 /* =============================================================== */
 
+/**
+ * Set the pixels of a texture from colour indices. The pixels are
+ * written scaled straight into the surface. Colours which map to
+ * the colour key are not drawn, just like with the keyed blit.
+ *
+ * @param  texture    The texture.
+ * @param  indices    One colour index per unscaled pixel, row by
+ *                    row.
+ * @param  colors     The colours the indices refer to.
+ * @param  numcolors  The number of colours, at most 256.
+ */
+void
+fn_texture_set_indexed_data(
+    FnTexture * texture,
+    const guchar * indices,
+    const SDL_Color * colors,
+    guint numcolors);
+
+/* =============================================================== */
+
 void
 fn_texture_blit_to_sdl_surface(
     FnTexture * texture,
@@ -109,6 +174,99 @@ fn_texture_blit_to_sdl_surface(
 
 /* =============================================================== */
 
+/**
+ * Blit a texture onto another one. Only the position of the
+ * target rectangle is used.
+ *
+ * @param  source      The texture to copy from.
+ * @param  sourcerect  The area to copy, or NULL for the whole
+ *                     texture.
+ * @param  target      The texture to copy to.
+ * @param  targetrect  The position to copy to, or NULL for the
+ *                     upper left corner.
+ */
+void
+fn_texture_clone_rect(
+    FnTexture * source,
+    const FnRect * sourcerect,
+    FnTexture * target,
+    const FnRect * targetrect);
+
+/* =============================================================== */
+
+/**
+ * Get the opacity of a texture.
+ *
+ * @param  texture  The texture.
+ *
+ * @return The opacity.
+ */
+FnTextureOpacity
+fn_texture_get_opacity(FnTexture * texture);
+
+/* =============================================================== */
+
+/**
+ * Get the SDL surface of a texture to draw onto it directly, like
+ * the level does with its layers. The texture forgets its opacity,
+ * because the pixels may change.
+ *
+ * @param  texture  The texture.
+ *
+ * @return The surface, owned by the texture.
+ */
+SDL_Surface *
+fn_texture_get_sdl_surface(FnTexture * texture);
+
+/* =============================================================== */
+
+/**
+ * Enable or disable blitting classified textures without colour
+ * keys. It is enabled by default.
+ *
+ * @param  enabled  TRUE to use the fast blits.
+ */
+void
+fn_texture_set_fast_blits(gboolean enabled);
+
+/* =============================================================== */
+
+/**
+ * Record the blits of textures onto the target of a draw list
+ * instead of doing them. Only the thread drawing the game may
+ * record.
+ *
+ * @param  dl  The draw list, or NULL to stop recording.
+ */
+void
+fn_texture_set_draw_list(fn_drawlist_t * dl);
+
+/* =============================================================== */
+
+/**
+ * Give an 8 bit surface the EGA palette used by indexed textures.
+ *
+ * @param  surface  The surface.
+ */
+void
+fn_texture_apply_palette(SDL_Surface * surface);
+
+/* =============================================================== */
+
+/**
+ * Find the colour of the EGA palette closest to a colour.
+ *
+ * @param  red    The red component.
+ * @param  green  The green component.
+ * @param  blue   The blue component.
+ *
+ * @return The index of the colour in the palette.
+ */
+Uint8
+fn_texture_palette_index(guchar red, guchar green, guchar blue);
+
+/* =============================================================== */
+
 /* TODO write documentation that sourcegeometry as well
    as targetgeometry can be NULL.
    */
@@ -145,6 +303,109 @@ fn_texture_fill_area(
 
 /* =============================================================== */
 
+/**
+ * Set what a texture is used for. Newly created textures are in
+ * FN_TEXTURE_CATEGORY_OTHER.
+ */
+void
+fn_texture_set_category(
+    FnTexture * texture,
+    FnTextureCategory category);
+
+/* =============================================================== */
+
+FnTextureCategory
+fn_texture_get_category(
+    FnTexture * texture);
+
+/* =============================================================== */
+
+/**
+ * Get the pixel memory used by a texture.
+ *
+ * @param  texture  The texture.
+ *
+ * @return The size of the pixel memory in bytes.
+ */
+gsize
+fn_texture_get_memory(
+    FnTexture * texture);
+
+/* =============================================================== */
+
+/**
+ * Account pixel memory that is not held by a texture, such as
+ * plain SDL surfaces. Pass a negative size when it is freed.
+ */
+void
+fn_texture_account(
+    FnTextureCategory category,
+    gssize bytes);
+
+/* =============================================================== */
+
+/**
+ * Get the number of textures currently alive.
+ */
+guint
+fn_texture_get_live_count(void);
+
+/* =============================================================== */
+
+/**
+ * Get the pixel memory in bytes currently used by a category.
+ */
+gsize
+fn_texture_get_bytes(
+    FnTextureCategory category);
+
+/* =============================================================== */
+
+/**
+ * Get the pixel memory in bytes currently used by all categories.
+ */
+gsize
+fn_texture_get_total_bytes(void);
+
+/* =============================================================== */
+
+/**
+ * Get the highest total pixel memory in bytes used so far.
+ */
+gsize
+fn_texture_get_peak_bytes(void);
+
+/* =============================================================== */
+
+/**
+ * Set a budget for the total pixel memory. A warning is printed
+ * whenever the total grows above it. 0 disables the budget.
+ */
+void
+fn_texture_set_budget(
+    gsize bytes);
+
+/* =============================================================== */
+
+/**
+ * Free the pixel memory kept for reuse by textures created later.
+ * The memory of a finalized texture is kept in a small pool, and a
+ * new texture of the same size and format takes it from there
+ * instead of allocating.
+ */
+void
+fn_texture_clear_pool(void);
+
+/* =============================================================== */
+
+/**
+ * Print the live textures and the memory used per category.
+ */
+void
+fn_texture_print_statistics(void);
+
+/* =============================================================== */
+
 G_END_DECLS
 
 /* =============================================================== */
@@ -62,7 +62,11 @@
 #include "fn_game.h"
 #include "fn_data.h"
 #include "fn_environment.h"
+#include "fn_demo.h"
+#include "fn_simulation.h"
+#include "fn_profile.h"
 #include "fntexture.h"
+#include "fn_drawlist.h"
 
 /* --------------------------------------------------------------- */
 
@@ -82,6 +86,25 @@ int main(int argc, char ** argv)
 
   fn_error_set_handler(fn_error_print_commandline);
 
+  /* warn when the textures use more memory than allowed */
+  char * budget = getenv("FREENUKUM_TEXTURE_BUDGET");
+  if (budget != NULL) {
+    char * unit = NULL;
+    gsize bytes = strtoul(budget, &unit, 10);
+    if (*unit == 'k' || *unit == 'K') {
+      bytes *= 1024;
+    } else if (*unit == 'm' || *unit == 'M') {
+      bytes *= 1024 * 1024;
+    }
+    fn_texture_set_budget(bytes);
+  }
+
+  /* render the level in bands on several threads */
+  char * renderthreads = getenv("FREENUKUM_RENDER_THREADS");
+  if (renderthreads != NULL) {
+    fn_drawlist_set_threads(atoi(renderthreads));
+  }
+
   fn_environment_t * env = fn_environment_create();
 
 /* --------------------------------------------------------------- */
@@ -95,6 +118,15 @@ int main(int argc, char ** argv)
   /* load the tilecache */
   res = fn_environment_load_tilecache(env);
 
+  /* run headless simulations instead of the game if requested */
+  if (argc > 1 && (strcmp(argv[1], "--validate") == 0 ||
+        strcmp(argv[1], "--fuzz") == 0))
+  {
+    exit(fn_simulation_main(env, argc, argv));
+  }
+
+  fn_profile_init();
+
   /* show the splash screen */
   res = fn_picture_splash_show(
       env,
@@ -109,15 +141,40 @@ int main(int argc, char ** argv)
     choice = fn_mainmenu(env);
     switch(choice) {
       case FN_MENUCHOICE_START:
-        fn_game_start(
-            env);
+        {
+          /* record the game if a demo file is given */
+          char * demopath = getenv("FREENUKUM_RECORD_DEMO");
+          fn_demo_t * demo = NULL;
+          if (demopath != NULL) {
+            demo = fn_demo_open_record(demopath);
+            if (demo == NULL) {
+              fn_error_printf(1024, "Could not create demo file %s: %s",
+                  demopath, strerror(errno));
+            }
+          }
+          fn_environment_set_demo(env, demo);
+          fn_game_start(
+              env);
+          fn_environment_set_demo(env, NULL);
+          if (demo != NULL) {
+            fn_demo_free(demo);
+          }
+        }
         res = fn_picture_splash_show(
             env,
             backgroundfile);
         break;
       case FN_MENUCHOICE_RESTORE:
-        fn_infobox_show(env,
-            "Restore not implemented yet.\n");
+        if (!fn_game_restore(env,
+              fn_environment_get_savefilepath(env)))
+        {
+          fn_infobox_show(env,
+              "There is no saved game\n"
+              "for this episode.\n");
+        }
+        res = fn_picture_splash_show(
+            env,
+            backgroundfile);
         break;
       case FN_MENUCHOICE_INSTRUCTIONS:
         fn_infobox_show(env,
@@ -165,8 +222,28 @@ int main(int argc, char ** argv)
             "Previews not implemented yet.\n");
         break;
       case FN_MENUCHOICE_VIEWUSERDEMO:
-        fn_infobox_show(env,
-            "Userdemo not implemented yet.\n");
+        {
+          char * demopath = getenv("FREENUKUM_DEMO");
+          char * demomode = getenv("FREENUKUM_DEMO_MODE");
+          Uint8 mode = FN_DEMO_MODE_REALTIME;
+          if (demomode != NULL && strcmp(demomode, "fast") == 0) {
+            mode = FN_DEMO_MODE_FASTFORWARD;
+          } else if (demomode != NULL &&
+              strcmp(demomode, "headless") == 0) {
+            mode = FN_DEMO_MODE_HEADLESS;
+          }
+          if (demopath == NULL) {
+            fn_infobox_show(env,
+                "Set FREENUKUM_DEMO to the\n"
+                "demo file you want to view.\n");
+          } else if (!fn_game_replay_demo(env, demopath, mode)) {
+            fn_infobox_show(env,
+                "Could not load the demo, or\n"
+                "it did not play as recorded.\n");
+          }
+          res = fn_picture_splash_show(env,
+              backgroundfile);
+        }
         break;
       case FN_MENUCHOICE_TITLESCREEN:
         res = fn_picture_splash_show(env,
@@ -187,5 +264,7 @@ int main(int argc, char ** argv)
 
   fn_environment_delete(env);
 
+  fn_texture_print_statistics();
+
   return retval;
 }